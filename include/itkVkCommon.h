@@ -20,12 +20,24 @@
 
 #include "VkFFTBackendExport.h"
 #include "itkVkDefinitions.h"
+#include "itkConstantBoundaryCondition.h"
 #include "itkDataObject.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "vkFFT.h"
 
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
 namespace itk
 {
 
+class VkDeviceBuffer;
+class VkDeviceContext;
+
 class VkFFTBackend_EXPORT VkCommon
 {
 public:
@@ -62,6 +74,40 @@ public:
     NORMALIZED = 1
   };
 
+  enum class BoundaryConditionEnum
+  {
+    NONE = 0,              // No padding on the device
+    ZERO = 1,              // Pad with zeros
+    PERIODIC = 2,          // Wrap the input around
+    ZERO_FLUX_NEUMANN = 3, // Replicate the nearest input sample
+    MIRROR = 4             // Reflect the input about its boundary, repeating the edge sample
+  };
+
+  enum class DeconvolutionEnum
+  {
+    NONE = 0,            // No deconvolution
+    RICHARDSON_LUCY = 1, // Iterative maximum-likelihood estimate under Poisson noise
+    LANDWEBER = 2,       // Iterative gradient descent on the squared error of the blurred estimate
+    INVERSE = 3,         // Division by the transfer function where it is not near zero
+    TIKHONOV = 4,        // Division regularized by a constant
+    WIENER = 5           // Division regularized by a constant noise power spectral density
+  };
+
+  enum class InputPixelEnum
+  {
+    REAL = 0,  // Reals of the precision P
+    UINT8 = 1, // unsigned char, converted to reals on the device
+    INT16 = 2, // short, converted to reals on the device
+    UINT16 = 3 // unsigned short, converted to reals on the device
+  };
+
+#if (VKFFT_BACKEND == CUDA)
+  using DeviceMemoryType = void *;
+#elif (VKFFT_BACKEND == OPENCL)
+  using DeviceMemoryType = cl_mem;
+#endif
+  using DeviceBufferPointer = std::shared_ptr<VkDeviceBuffer>;
+
   struct VkParameters
   {
     uint64_t X{ 0 }; // size of fastest varying dimension
@@ -70,7 +116,15 @@ public:
     uint64_t omitDimension[3] = { 0,
                                   0,
                                   0 }; // disable FFT for this dimension (0 - FFT enabled, 1 - FFT disabled). Default 0.
-                                       // Doesn't work for R2C dimension 0 for now. Doesn't work with convolutions.
+                                       // Doesn't work for R2C dimension 0, except that an R2FullH transform
+                                       // along one other dimension runs as a batch of 1D lines. Doesn't work
+                                       // with convolutions.
+    uint64_t performZeropadding[3] = { 0, 0, 0 }; // skip reading, writing and transforming a block of zeros in this
+                                                  // dimension (0 - off, 1 - on). Default 0.
+    uint64_t zeropadLeft[3] = { 0, 0, 0 };        // first index of the block of zeros in this dimension
+    uint64_t zeropadRight[3] = { 0, 0, 0 };       // one past the last index of the block of zeros in this dimension
+    uint64_t frequencyZeropadding{ 0 }; // 0 - zeros are in the spatial domain (forward input or inverse output),
+                                        // 1 - zeros are in the frequency domain. Default 0.
     PrecisionEnum P = PrecisionEnum::FLOAT; // type for real numbers
     uint64_t      B{ 1 };                   // Number of batches -- always 1
     uint64_t      N{ 1 };                   // Number of redundant iterations, for benchmarking -- always 1.
@@ -86,15 +140,135 @@ public:
     uint64_t     inputBufferBytes{ 0 };      // number of bytes in inputCPUBuffer
     void *       outputCPUBuffer{ nullptr }; // output buffer in CPU memory
     uint64_t     outputBufferBytes{ 0 };     // number of bytes in outputCPUBuffer
+    BoundaryConditionEnum boundaryCondition{
+      BoundaryConditionEnum::NONE
+    }; // if not NONE, inputCPUBuffer holds an unpadded input that is padded on the device before a forward transform
+    uint64_t padInputSize[3] = { 1, 1, 1 };  // size of the unpadded input in inputCPUBuffer
+    uint64_t padLowerBound[3] = { 0, 0, 0 }; // position of the unpadded input within the X, Y, Z transform domain
+    const DataObject * inputDataObject{ nullptr }; // pipeline object that owns inputCPUBuffer, if any; enables
+                                                   // reuse of a device copy that is still resident
+    ModifiedTimeType inputTimeStamp{ 0 };          // modification time of inputDataObject when inputCPUBuffer was read
+    DeviceBufferPointer inputGPUBuffer{};           // if set, the input is already on the device and inputCPUBuffer
+                                                    // is not read
+    DeviceBufferPointer * outputGPUBuffer{ nullptr }; // if not nullptr, the output is left on the device instead of
+                                                      // copied to outputCPUBuffer: in the buffer set here, or else
+                                                      // in a buffer returned here
+    uint64_t performConvolution{ 0 }; // 1 - convolve the padded input with a kernel: forward R2HalfH transform,
+                                      // multiplication by the kernel spectrum and inverse transform in one pass.
+                                      // Requires boundaryCondition other than NONE. Default 0.
+    const void *        kernelCPUBuffer{ nullptr };        // convolution kernel in CPU memory
+    uint64_t            kernelBufferBytes{ 0 };            // number of bytes in kernelCPUBuffer
+    DeviceBufferPointer kernelGPUBuffer{};                 // if set, the kernel is already on the device and
+                                                           // kernelCPUBuffer is not read
+    const DataObject *  kernelDataObject{ nullptr };       // pipeline object of the kernel, if any; enables reuse
+                                                           // of its cached spectrum
+    ModifiedTimeType    kernelTimeStamp{ 0 };              // modification time of kernelDataObject
+    uint64_t            kernelSize[3] = { 1, 1, 1 };       // size of the kernel
+    uint64_t            kernelCenter[3] = { 0, 0, 0 };     // kernel sample that is moved to the origin of the domain
+    double              kernelScale{ 1.0 };                // factor applied to the kernel, e.g. to normalize it
+    uint64_t            cropSize[3] = { 1, 1, 1 };         // size of the convolution output
+    uint64_t            cropLowerBound[3] = { 0, 0, 0 };   // position of the convolution output in the domain
+    uint64_t            numberKernels{ 1 };                // number of kernels, one after another in the kernel
+                                                           // buffer. The output holds one result per kernel.
+    uint64_t            correlation{ 0 };                  // 1 - correlate with the kernels instead of convolving,
+                                                           // i.e. mirror them about their centers. Default 0.
+    uint64_t            normalizeCorrelation{ 0 };         // 1 - with correlation, kernels of zero mean and unit
+                                                           // norm, and a zero boundary condition, divide each
+                                                           // output by the norm of the zero-mean input under the
+                                                           // kernel window, which yields the normalized
+                                                           // cross-correlation. Default 0.
+    uint64_t *          peakIndices{ nullptr }; // if not nullptr, receives for each kernel the index of the largest
+                                                // sample of its output, or the index of the phase correlation peak.
+                                                // outputCPUBuffer may be nullptr then.
+    double *            peakValues{ nullptr };  // if not nullptr, receives for each kernel the largest sample of its
+                                                // output, or the phase correlation peak
+    uint64_t performNormalizedCorrelation{ 0 }; // 1 - masked normalized cross-correlation of the input, the fixed
+                                                // image of padInputSize, with a moving image, as computed by
+                                                // MaskedFFTNormalizedCorrelationImageFilter. The output of cropSize,
+                                                // the sum of both sizes minus one, starts at the origin of the
+                                                // domain. Requires an R2HalfH transformation. Default 0.
+    const void *        movingCPUBuffer{ nullptr };     // moving image in CPU memory
+    uint64_t            movingBufferBytes{ 0 };         // number of bytes in movingCPUBuffer
+    DeviceBufferPointer movingGPUBuffer{};              // if set, the moving image is already on the device and
+                                                        // movingCPUBuffer is not read
+    uint64_t            movingSize[3] = { 1, 1, 1 };    // size of the moving image
+    const void *        inputMaskCPUBuffer{ nullptr };  // mask of the input in CPU memory, of the same size and
+                                                        // precision, or nullptr for a mask of ones
+    const void *        movingMaskCPUBuffer{ nullptr }; // mask of the moving image, or nullptr for a mask of ones
+    double              requiredOverlapFraction{ 0.0 }; // the output is zero where fewer pixels than this fraction
+                                                        // of the largest overlap overlap
+    uint64_t            requiredOverlap{ 0 };           // the output is zero where fewer pixels than this overlap
+    uint64_t performPhaseCorrelation{ 0 }; // 1 - phase correlation of the input with a moving image of the same
+                                           // size, both padded according to boundaryCondition: the peak of the
+                                           // inverse transform of their normalized cross-power spectrum is found
+                                           // and refined on the device. Only peakIndices, peakValues and
+                                           // phaseShift receive results. Requires an R2HalfH transformation.
+    double * phaseShift{ nullptr }; // if not nullptr, receives the shift along X, Y and Z by which the content of
+                                    // the moving image lies beyond that of the input, refined to a subpixel
+                                    // position and wrapped into [-size/2, size/2)
+    DeconvolutionEnum deconvolution{
+      DeconvolutionEnum::NONE
+    }; // if not NONE, deconvolve the padded input by the kernel, which is read and placed as for a convolution,
+       // and crop the estimate into the output as a convolution does. Requires an R2HalfH transformation.
+    uint64_t                      numberIterations{ 1 };        // iterations of an iterative deconvolution
+    double                        relaxation{ 0.1 };            // relaxation factor, alpha, of the Landweber iteration
+    void *                        estimateCPUBuffer{ nullptr }; // if not nullptr, receives the estimate over the padded
+                                                                // domain before every estimateInterval-th iteration
+    uint64_t                      estimateInterval{ 0 };        // 0 - the estimate is not downloaded in between
+    std::function<bool(uint64_t)> iterationCallback{};          // if set, called before each iteration with the number
+                                                                // of completed iterations; returning true stops
+    double regularization{ 0.0 }; // regularization constant of a Tikhonov deconvolution, or power spectral density
+                                  // of the noise of a Wiener deconvolution, for the unnormalized spectra
+    double zeroMagnitudeThreshold{ 1.0e-4 }; // a direct deconvolution yields zero where the magnitude of the
+                                             // transfer function, or of its regularized square, is below this
+    uint64_t performGaussianSmoothing{ 0 }; // 1 - smooth the padded input with the discrete Gaussian of
+                                            // gaussianVariance, whose transfer function is evaluated on the device
+                                            // between the forward R2HalfH and the inverse transform, and crop the
+                                            // output as a convolution does. No kernel is read. Default 0.
+    double gaussianVariance[3] = { 0.0, 0.0, 0.0 }; // variance of the Gaussian along X, Y and Z, in samples
+    uint64_t gaussianShrinkFactor[3] = { 1, 1, 1 }; // the output of a Gaussian smoothing samples the smoothed domain
+                                                    // at cropLowerBound + j * factor, j < cropSize, along X, Y and Z.
+                                                    // Factors other than 1 must divide X, Y and Z, and the samples
+                                                    // are computed by an inverse transform of the decimated domain.
+    uint64_t keepInputSpectrum{ 0 }; // 1 - keep the half spectrum of the padded input of a Gaussian smoothing on the
+                                     // device, and reuse the kept spectrum instead of padding and transforming the
+                                     // input again while inputDataObject, its time stamp and the padded domain are
+                                     // unchanged. 0 - release any kept spectrum. Default 0.
+    InputPixelEnum inputPixelType{
+      InputPixelEnum::REAL
+    }; // pixel type of the unpadded input of a Gaussian smoothing, whose inputBufferBytes count pixels of this type.
+       // Other types than REAL are converted to reals on the device before the input is padded.
 
     bool
     operator!=(const VkParameters & rhs) const
     {
+      for (size_t dim{ 0 }; dim < 3; ++dim)
+      {
+        if (this->omitDimension[dim] != rhs.omitDimension[dim] ||
+            this->performZeropadding[dim] != rhs.performZeropadding[dim] ||
+            this->zeropadLeft[dim] != rhs.zeropadLeft[dim] || this->zeropadRight[dim] != rhs.zeropadRight[dim] ||
+            this->padInputSize[dim] != rhs.padInputSize[dim] || this->padLowerBound[dim] != rhs.padLowerBound[dim] ||
+            this->kernelSize[dim] != rhs.kernelSize[dim] || this->kernelCenter[dim] != rhs.kernelCenter[dim] ||
+            this->cropSize[dim] != rhs.cropSize[dim] || this->cropLowerBound[dim] != rhs.cropLowerBound[dim] ||
+            this->movingSize[dim] != rhs.movingSize[dim] ||
+            this->gaussianShrinkFactor[dim] != rhs.gaussianShrinkFactor[dim])
+        {
+          return true;
+        }
+      }
       return this->X != rhs.X || this->Y != rhs.Y || this->Z != rhs.Z || this->P != rhs.P || this->B != rhs.B ||
              this->N != rhs.N || this->fft != rhs.fft || this->PSize != rhs.PSize || this->I != rhs.I ||
-             this->normalized != rhs.normalized || this->inputCPUBuffer != rhs.inputCPUBuffer ||
-             this->inputBufferBytes != rhs.inputBufferBytes || this->outputCPUBuffer != rhs.outputCPUBuffer ||
-             this->outputBufferBytes != rhs.outputBufferBytes;
+             this->normalized != rhs.normalized || this->frequencyZeropadding != rhs.frequencyZeropadding ||
+             this->inputCPUBuffer != rhs.inputCPUBuffer || this->inputBufferBytes != rhs.inputBufferBytes ||
+             this->outputCPUBuffer != rhs.outputCPUBuffer || this->outputBufferBytes != rhs.outputBufferBytes ||
+             this->boundaryCondition != rhs.boundaryCondition || this->performConvolution != rhs.performConvolution ||
+             this->kernelBufferBytes != rhs.kernelBufferBytes || this->numberKernels != rhs.numberKernels ||
+             this->correlation != rhs.correlation ||
+             this->performNormalizedCorrelation != rhs.performNormalizedCorrelation ||
+             this->performPhaseCorrelation != rhs.performPhaseCorrelation ||
+             this->deconvolution != rhs.deconvolution ||
+             this->performGaussianSmoothing != rhs.performGaussianSmoothing ||
+             this->movingBufferBytes != rhs.movingBufferBytes || this->inputPixelType != rhs.inputPixelType;
     }
   };
 
@@ -123,18 +297,89 @@ public:
     }
   };
 
+  /** Argument passed by value to a device kernel */
+  struct KernelArgument
+  {
+    const void * value;
+    size_t       size;
+  };
+
   VkFFTResult
   Run(const VkGPU & vkGPU, const VkParameters & vkParameters);
 
   VkFFTResult
   ReleaseBackend();
 
+  /** Release the spectrum of the padded input that a Gaussian smoothing kept on the device. */
+  void
+  ReleaseInputSpectrum()
+  {
+    m_InputSpectrum.reset();
+  }
+
   uint64_t
   GetGreatestPrimeFactor() const
   {
     return 13UL;
   }
 
+  /** Describe the spatial-domain support [supportBegin, supportEnd) of the transform along
+   *  dimension `dim` of extent `size`. Samples outside of the support are declared to be
+   *  zero (forward input) or unneeded (inverse output). VkFFT skips one contiguous block
+   *  per dimension, so the larger of the two blocks around the support is skipped. */
+  static void
+  SetSpatialSupport(VkParameters & vkParameters,
+                    unsigned int   dim,
+                    uint64_t       size,
+                    uint64_t       supportBegin,
+                    uint64_t       supportEnd);
+
+  /** Pixel type of an input that the device converts to reals, or REAL for the other pixel types. */
+  template <typename TPixel>
+  static constexpr InputPixelEnum
+  GetInputPixelType()
+  {
+    return std::is_same<TPixel, unsigned char>::value    ? InputPixelEnum::UINT8
+           : std::is_same<TPixel, short>::value          ? InputPixelEnum::INT16
+           : std::is_same<TPixel, unsigned short>::value ? InputPixelEnum::UINT16
+                                                         : InputPixelEnum::REAL;
+  }
+
+  /** Boundary condition that the device generates for a boundary condition of ITK, or NONE
+   *  if it cannot generate it. The device pads with ZeroFluxNeumannBoundaryCondition,
+   *  PeriodicBoundaryCondition and a ConstantBoundaryCondition of zero; the Vk filters hand
+   *  other boundary conditions over to the ITK filters that they override. */
+  template <typename TImage>
+  static BoundaryConditionEnum
+  GetBoundaryCondition(const ImageBoundaryCondition<TImage> * boundaryCondition)
+  {
+    if (dynamic_cast<const ZeroFluxNeumannBoundaryCondition<TImage> *>(boundaryCondition))
+    {
+      return BoundaryConditionEnum::ZERO_FLUX_NEUMANN;
+    }
+    if (dynamic_cast<const PeriodicBoundaryCondition<TImage> *>(boundaryCondition))
+    {
+      return BoundaryConditionEnum::PERIODIC;
+    }
+    const auto * const constantCondition{ dynamic_cast<const ConstantBoundaryCondition<TImage> *>(
+      boundaryCondition) };
+    if (constantCondition && constantCondition->GetConstant() == typename TImage::PixelType{})
+    {
+      return BoundaryConditionEnum::ZERO;
+    }
+    return BoundaryConditionEnum::NONE;
+  }
+
+  /** Identify the pipeline object that owns the CPU input buffer, so that a copy of it
+   *  that is still resident on the device can be reused instead of uploaded again. */
+  static void
+  IdentifyInput(VkParameters & vkParameters, const DataObject * input);
+
+  /** Identify the pipeline object of the convolution kernel, so that its spectrum can be
+   *  cached on the device and reused by later convolutions. */
+  static void
+  IdentifyKernel(VkParameters & vkParameters, const DataObject * kernel);
+
   VkCommon() = default;
   ~VkCommon() { this->ReleaseBackend(); }
 
@@ -142,20 +387,221 @@ protected:
   VkFFTResult
   ConfigureBackend();
 
+  /** Lay out `numberBatches` contiguous real images in the input and output buffers and their
+   *  half spectra in the in-place-computation buffer, planned for both directions, as the
+   *  correlations and deconvolutions transform them. */
+  void
+  ConfigureCorrelationLayout(uint64_t numberBatches);
+
   VkFFTResult
   PerformFFT();
 
+  /** Perform an R2FullH transform along a single dimension other than the fastest as a batch
+   *  of contiguous real lines, gathered and expanded to the full spectrum on the device. */
+  VkFFTResult
+  PerformLineFFT();
+
+  /** Device memory management on the configured backend */
+  VkFFTResult
+  AllocateDeviceBuffer(uint64_t bytes, DeviceBufferPointer & buffer);
+  VkFFTResult
+  CopyHostToDevice(DeviceMemoryType buffer, const void * hostBuffer, uint64_t bytes);
+  VkFFTResult
+  CopyDeviceToHost(void * hostBuffer, DeviceMemoryType buffer, uint64_t bytes);
+  VkFFTResult
+  CopyDeviceToDevice(DeviceMemoryType destination, DeviceMemoryType source, uint64_t bytes);
+  VkFFTResult
+  SynchronizeDevice();
+
+  /** Fill the redundant upper half of dimension 0 of a forward R2FullH result from the
+   *  Hermitian symmetry of the lower half, in place on the device. */
+  VkFFTResult
+  CompleteHermitianOnDevice(DeviceMemoryType buffer);
+
+  /** Launch a device kernel from the module's kernel library over `globalSize` work items.
+   *  The library is compiled for the current precision on first use. */
+  VkFFTResult
+  LaunchKernel(const char * kernelName, uint64_t globalSize, const std::vector<KernelArgument> & arguments);
+
+  /** Return a device copy of the CPU input. A copy that is resident from an earlier run on
+   *  the same, unmodified input is reused; otherwise the input is uploaded and, within the
+   *  residency budget of VkGlobalConfiguration, kept resident for later runs. */
+  VkFFTResult
+  AcquireInputBuffer(DeviceBufferPointer & buffer);
+
+  /** Fill `buffer` with the CPU input, from a resident copy if residency is enabled. */
+  VkFFTResult
+  UploadInput(const DeviceBufferPointer & buffer);
+
+  /** Return a device copy of the moving image of a correlation, uploaded unless
+   *  m_VkParameters.movingGPUBuffer is set. */
+  VkFFTResult
+  AcquireMovingBuffer(DeviceBufferPointer & buffer);
+
+  /** Device buffer for a formatted output: the one requested through
+   *  m_VkParameters.outputGPUBuffer, or else a newly allocated one. */
+  VkFFTResult
+  AcquireOutputBuffer(DeviceBufferPointer & buffer);
+
+  /** Hand the output over to the caller, in device memory if m_VkParameters.outputGPUBuffer
+   *  is set and otherwise in outputCPUBuffer. */
+  VkFFTResult
+  ReturnOutput(const DeviceBufferPointer & buffer);
+
+  /** Pad the unpadded input into `paddedBuffer` according to m_VkParameters.boundaryCondition.
+   *  An input of another pixel type than REAL is converted to reals first. */
+  VkFFTResult
+  PadOnDevice(const DeviceBufferPointer & paddedBuffer);
+
+  /** Pad `unpaddedBuffer`, of the size of the input, into `paddedBuffer` in the same way. */
+  VkFFTResult
+  PadOnDevice(const DeviceBufferPointer & unpaddedBuffer, const DeviceBufferPointer & paddedBuffer);
+
+  /** Convolve the input with the kernel: pad the input, compute the kernel spectrum, run the
+   *  fused forward transform, kernel multiplication and inverse transform of VkFFT, and crop
+   *  the output, all on the device. */
+  VkFFTResult
+  PerformConvolution();
+
+  /** Divide the correlation maps in `mapBuffer`, with kernels of zero mean and unit norm, by the
+   *  norm of the zero-mean padded input under the kernel window at each of their samples. The
+   *  sums of the input and of its squares over the windows are computed once for all kernels. */
+  VkFFTResult
+  NormalizeCorrelation(const DeviceBufferPointer & paddedBuffer, const DeviceBufferPointer & mapBuffer);
+
+  /** Bring the kernels to the device and move their centers to the origin of the zero-padded
+   *  domain in `placedBuffer`, scaled and, for a correlation, mirrored. */
+  VkFFTResult
+  PlaceKernel(const DeviceBufferPointer & placedBuffer);
+
+  /** Compute the spectrum of the kernel, moved to the origin of the padded domain and scaled,
+   *  into `kernelBuffer`. */
+  VkFFTResult
+  TransformKernel(const DeviceBufferPointer & kernelBuffer);
+
+  /** Return the kernel spectrum of the convolution. A spectrum that is cached from an earlier
+   *  convolution with the same, unmodified kernel in the same domain is reused; otherwise it is
+   *  computed and, within the kernel spectrum cache budget of VkGlobalConfiguration, cached. */
+  VkFFTResult
+  AcquireKernelSpectrum(DeviceBufferPointer & kernelBuffer);
+
+  /** Find the largest sample of each of `count` arrays of `samples` samples that follow one
+   *  another in `buffer` into `indices` and `values`, where not nullptr. Each work item searches
+   *  a chunk of an array on the device, and the maxima of the chunks are compared on the host. */
+  VkFFTResult
+  FindMaxima(const DeviceBufferPointer & buffer, uint64_t samples, uint64_t count, uint64_t * indices, double * values);
+
+  /** Compute the masked normalized cross-correlation of the input with the moving image: the
+   *  masked images, their squares and the masks are zero-padded, the moving ones rotated, and
+   *  transformed as one batch; their products are inverse transformed with the same plan and
+   *  combined into the output, all on the device. */
+  VkFFTResult
+  PerformNormalizedCorrelation();
+
+  /** Estimate the translation between the input and the moving image by phase correlation: both
+   *  are padded and transformed with one plan, and the normalization of their cross-power
+   *  spectrum, its inverse transform, the peak search and a parabolic subpixel refinement of
+   *  the peak run on the device. */
+  VkFFTResult
+  PerformPhaseCorrelation();
+
+  /** Deconvolve the padded input by the kernel. The padded input, the transfer function, the
+   *  estimate and the intermediate images and spectra of the iterations stay on the device, are
+   *  transformed with one plan in both directions, and are combined by device kernels. A direct
+   *  deconvolution divides the half spectrum of the input by the transfer function on the device.
+   *  Only the cropped estimate, and the whole estimate at the requested intervals, are downloaded. */
+  VkFFTResult
+  PerformDeconvolution();
+
+  /** Smooth the padded input with a discrete Gaussian. Its transfer function is evaluated
+   *  analytically on the device and multiplied into the half spectrum of the input, so that no
+   *  kernel image is generated, uploaded or transformed. A spectrum of the same input that was
+   *  kept by a previous smoothing is reused, so that only the inverse transform remains. With
+   *  shrink factors, the aliases of the smoothed spectrum are summed into the spectrum of the
+   *  decimated domain, and only that is transformed back. */
+  VkFFTResult
+  PerformGaussianSmoothing();
+
+  /** Sum the aliases of the Gaussian smoothing of the half spectrum of the smoothed domain into
+   *  the spectrum of the domain decimated by the shrink factors, transform it back and crop the
+   *  output out of it. */
+  VkFFTResult
+  PerformGaussianDecimation(DeviceMemoryType                    spectrumGPUBuffer,
+                            const std::vector<KernelArgument> & variances,
+                            const DeviceBufferPointer &         outputBuffer);
+
 private:
+  /** Bytes per pixel of the unpadded input */
+  uint64_t
+  GetInputPixelBytes() const;
+
   // Backend parameters
   VkGPU              m_VkGPU{};
   VkParameters       m_VkParameters{};
   VkFFTConfiguration m_VkFFTConfiguration{};
 
+  // Layout of a line transform, see PerformLineFFT. A count of 0 selects the regular transform.
+  struct LineLayout
+  {
+    uint64_t length{ 0 };            // samples per line
+    uint64_t stride{ 1 };            // distance in the image between consecutive samples of a line
+    uint64_t count{ 0 };             // number of lines
+    uint64_t realBufferSize{ 0 };    // real samples of all lines
+    uint64_t complexBufferSize{ 0 }; // half-spectrum samples of all lines
+  };
+  LineLayout m_LineLayout{};
+
+  // Samples of the batched kernel spectra and of the batched convolution outputs
+  uint64_t m_ConvolutionKernelSize{ 0 };
+  uint64_t m_ConvolutionOutputSize{ 0 };
+
+  // Samples of the batched correlation images and terms and of their half spectra
+  uint64_t m_CorrelationDomainSize{ 0 };
+  uint64_t m_CorrelationSpectrumSize{ 0 };
+
+  // Device handles, kernels and resident buffers shared with other filters on the same device
+  std::shared_ptr<VkDeviceContext> m_DeviceContext{};
+
+  // Half spectrum of the padded input kept by a Gaussian smoothing, and what it was computed from
+  struct InputSpectrumKey
+  {
+    const DataObject *    dataObject{ nullptr };
+    ModifiedTimeType      timeStamp{ 0 };
+    const void *          hostBuffer{ nullptr };
+    PrecisionEnum         precision{ PrecisionEnum::FLOAT };
+    BoundaryConditionEnum boundaryCondition{ BoundaryConditionEnum::NONE };
+    uint64_t              size[3] = { 1, 1, 1 };
+    uint64_t              padInputSize[3] = { 1, 1, 1 };
+    uint64_t              padLowerBound[3] = { 0, 0, 0 };
+
+    bool
+    operator==(const InputSpectrumKey & rhs) const
+    {
+      for (size_t dim{ 0 }; dim < 3; ++dim)
+      {
+        if (this->size[dim] != rhs.size[dim] || this->padInputSize[dim] != rhs.padInputSize[dim] ||
+            this->padLowerBound[dim] != rhs.padLowerBound[dim])
+        {
+          return false;
+        }
+      }
+      return this->dataObject == rhs.dataObject && this->timeStamp == rhs.timeStamp &&
+             this->hostBuffer == rhs.hostBuffer && this->precision == rhs.precision &&
+             this->boundaryCondition == rhs.boundaryCondition;
+    }
+  };
+  DeviceBufferPointer m_InputSpectrum{};
+  InputSpectrumKey    m_InputSpectrumKey{};
+
   // Re-create GPU kernel if these members indicate to
   bool         m_MustConfigure{ true };
   VkGPU        m_VkGPUPrevious{};
   VkParameters m_VkParametersPrevious{};
 };
 
+/** Define how the boundary condition enumeration is sent to an output stream */
+extern VkFFTBackend_EXPORT std::ostream &
+                           operator<<(std::ostream & out, const VkCommon::BoundaryConditionEnum value);
+
 } // namespace itk
 #endif
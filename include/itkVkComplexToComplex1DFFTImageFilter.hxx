@@ -23,6 +23,7 @@
 #include "itkVkGlobalConfiguration.h"
 #include "vkFFT.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageAlgorithm.h"
 #include "itkIndent.h"
 #include "itkMetaDataObject.h"
 #include "itkProgressReporter.h"
@@ -42,6 +43,24 @@ VkComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     return;
   }
 
+  // Transform small images in host memory with the next registered backend
+  const auto configureBackend = [this](Superclass * backend) {
+    backend->SetDirection(this->GetDirection());
+    backend->SetTransformDirection(this->GetTransformDirection());
+  };
+  m_GeneratedDataOnHost = VkFFTBackendDispatch<Self>::GenerateDataOnHost(this, m_HostBackend, configureBackend);
+  if (m_GeneratedDataOnHost)
+  {
+    return;
+  }
+
+  // Split a batch of lines between the device and the next registered backend
+  if (VkFFTBackendDispatch<Self>::GenerateDataSplit(
+        this, m_HostBackend, m_DeviceFilter, m_BatchThroughput, configureBackend))
+  {
+    return;
+  }
+
   // we don't have a nice progress to report, but at least this simple line
   // reports the beginning and the end of the process
   const ProgressReporter progress(this, 0, 1);
@@ -50,14 +69,42 @@ VkComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   output->SetBufferedRegion(output->GetRequestedRegion());
   output->Allocate();
 
-  const SizeType & inputSize{ input->GetLargestPossibleRegion().GetSize() };
+  // Transform the requested region. It spans the largest possible region along the
+  // direction of the transform, so that the image can be streamed through in slabs.
+  const OutputImageRegionType & outputRegion{ output->GetRequestedRegion() };
+  const InputImageRegionType   inputRegion{ outputRegion.GetIndex(), outputRegion.GetSize() };
+  const SizeType &             inputSize{ inputRegion.GetSize() };
+
+  // Read an input that is held on the device from there when it is buffered on its own, and
+  // leave the output on the device when it can hold it there
+  const VkCommon::DeviceBufferPointer inputGPUBuffer{
+    input->GetBufferedRegion() == inputRegion
+      ? VkImageDeviceBuffer<InputImageType>::GetInputBuffer(input, this->GetDeviceID())
+      : nullptr
+  };
+  VkCommon::DeviceBufferPointer outputGPUBuffer;
+  const bool                    deviceOutput{ VkImageDeviceBuffer<OutputImageType>::GetOutputBuffer(
+    output, this->GetDeviceID(), outputGPUBuffer) };
+
+  // Pack the input block unless it is already buffered on its own
+  const InputPixelType *           inputCPUBuffer{ inputGPUBuffer ? nullptr : input->GetBufferPointer() };
+  typename InputImageType::Pointer packedInput;
+  if (!inputGPUBuffer && input->GetBufferedRegion() != inputRegion)
+  {
+    itkAssertOrThrowMacro(input->GetBufferedRegion().IsInside(inputRegion), "Input region is not buffered");
+    packedInput = InputImageType::New();
+    packedInput->CopyInformation(input);
+    packedInput->SetRegions(inputRegion);
+    packedInput->Allocate();
+    ImageAlgorithm::Copy(input, packedInput.GetPointer(), inputRegion, inputRegion);
+    inputCPUBuffer = packedInput->GetBufferPointer();
+  }
 
-  const InputPixelType * const inputCPUBuffer{ input->GetBufferPointer() };
-  OutputPixelType * const      outputCPUBuffer{ output->GetBufferPointer() };
-  itkAssertOrThrowMacro(inputCPUBuffer != nullptr, "No CPU input buffer");
+  OutputPixelType * const outputCPUBuffer{ output->GetBufferPointer() };
+  itkAssertOrThrowMacro(inputCPUBuffer != nullptr || inputGPUBuffer, "No input buffer");
   itkAssertOrThrowMacro(outputCPUBuffer != nullptr, "No CPU output buffer");
-  const SizeValueType inBytes{ input->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(InputPixelType) };
-  const SizeValueType outBytes{ output->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(OutputPixelType) };
+  const SizeValueType inBytes{ inputRegion.GetNumberOfPixels() * sizeof(InputPixelType) };
+  const SizeValueType outBytes{ outputRegion.GetNumberOfPixels() * sizeof(OutputPixelType) };
   itkAssertOrThrowMacro(inBytes == outBytes, "CPU input and output buffers are of different sizes.");
 
   // Mostly use defaults for VkCommon::VkGPU
@@ -96,8 +143,17 @@ VkComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   vkParameters.inputCPUBuffer = inputCPUBuffer;
   vkParameters.inputBufferBytes = inBytes;
+  if (!packedInput && !inputGPUBuffer)
+  {
+    VkCommon::IdentifyInput(vkParameters, input);
+  }
+  vkParameters.inputGPUBuffer = inputGPUBuffer;
   vkParameters.outputCPUBuffer = outputCPUBuffer;
   vkParameters.outputBufferBytes = outBytes;
+  if (deviceOutput)
+  {
+    vkParameters.outputGPUBuffer = &outputGPUBuffer;
+  }
 
   const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
   if (resFFT != VKFFT_SUCCESS)
@@ -106,6 +162,10 @@ VkComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
     itkAssertOrThrowMacro(false, mesg.str());
   }
+  if (deviceOutput)
+  {
+    VkImageDeviceBuffer<OutputImageType>::SetOutputBuffer(output, outputGPUBuffer);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -117,6 +177,8 @@ VkComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::PrintSelf(std::os
   os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
   os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
   os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "UseHostBatchSplit: " << m_UseHostBatchSplit << std::endl;
+  os << indent << "HostBatchShare: " << m_BatchThroughput.GetHostShare() << std::endl;
 }
 
 template <typename TInputImage, typename TOutputImage>
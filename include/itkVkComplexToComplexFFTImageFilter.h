@@ -22,7 +22,9 @@
 #include "itkComplexToComplexFFTImageFilter.h"
 #include "itkFFTImageFilterFactory.h"
 #include "itkVkCommon.h"
+#include "itkVkFFTBackendDispatch.h"
 #include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
 
 namespace itk
 {
@@ -69,6 +71,7 @@ public:
   using RealType = typename ComplexType::value_type;
   using SizeType = typename InputImageType::SizeType;
   using SizeValueType = typename InputImageType::SizeValueType;
+  using InputImageRegionType = typename InputImageType::RegionType;
   using OutputImageRegionType = typename OutputImageType::RegionType;
 
   /** Method for creation through the object factory. */
@@ -98,9 +101,28 @@ public:
     return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
   }
 
+  /** Whether the last update was computed by the next registered backend because the
+   *  transform was smaller than the crossover of the device. */
+  itkGetConstMacro(GeneratedDataOnHost, bool);
+
   SizeValueType
   GetSizeGreatestPrimeFactor() const;
 
+  /** Region of the input image outside of which all pixels are known to be zero,
+   *  as for an image that has been zero padded ahead of a convolution. VkFFT then
+   *  skips reading and transforming the block of zeros along each dimension.
+   *  An empty region (the default) declares no zeros. */
+  itkSetMacro(NonZeroInputRegion, InputImageRegionType);
+  itkGetConstReferenceMacro(NonZeroInputRegion, InputImageRegionType);
+
+  /** Region of the output image that is actually needed, as for a convolution
+   *  that is cropped after the inverse transform. VkFFT then skips computing and
+   *  writing the block outside of this region along each dimension, and output
+   *  pixels in the skipped block are left undefined.
+   *  An empty region (the default) keeps the full output. */
+  itkSetMacro(KeptOutputRegion, OutputImageRegionType);
+  itkGetConstReferenceMacro(KeptOutputRegion, OutputImageRegionType);
+
 protected:
   VkComplexToComplexFFTImageFilter();
   ~VkComplexToComplexFFTImageFilter() override = default;
@@ -115,7 +137,14 @@ private:
   bool     m_UseVkGlobalConfiguration{ true };
   uint64_t m_DeviceID{ 0UL };
 
+  InputImageRegionType  m_NonZeroInputRegion{};
+  OutputImageRegionType m_KeptOutputRegion{};
+
   VkCommon m_VkCommon{};
+
+  /** Next registered backend for transforms that are too small for the device. */
+  typename Superclass::Pointer m_HostBackend{};
+  bool                         m_GeneratedDataOnHost{ false };
 };
 
 // Describe whether input/output are real- or complex-valued
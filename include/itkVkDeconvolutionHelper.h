@@ -0,0 +1,263 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkDeconvolutionHelper_h
+#define itkVkDeconvolutionHelper_h
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkVkCommon.h"
+#include "itkVkImageDeviceBuffer.h"
+
+namespace itk
+{
+/**
+ *\class VkDeconvolutionHelper
+ *
+ * \brief Deconvolution of the input of a deconvolution filter by its kernel on the device.
+ *
+ * The Vk deconvolution filters derive from different deconvolution filters
+ * of ITK, all of which are FFTConvolutionImageFilters. This helper hands
+ * their input, kernel and output to VkCommon in the way that
+ * VkFFTConvolutionImageFilter does, so that each filter only selects the
+ * method and its settings.
+ *
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkCommon
+ * \sa VkFFTConvolutionImageFilter
+ */
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+class VkDeconvolutionHelper
+{
+public:
+  using InputImageType = TInputImage;
+  using KernelImageType = TKernelImage;
+  using OutputImageType = TOutputImage;
+  using RealType = TInternalPrecision;
+  using FilterType = FFTConvolutionImageFilter<InputImageType, KernelImageType, OutputImageType, RealType>;
+  using InputPixelType = typename InputImageType::PixelType;
+  using KernelPixelType = typename KernelImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using SizeType = typename InputImageType::SizeType;
+  using BoundaryConditionEnum = VkCommon::BoundaryConditionEnum;
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  using InternalImageType = Image<RealType, ImageDimension>;
+
+  /** Region of the input padded by `padLowerBound` to `padSize`, over which the
+   *  deconvolution filters of ITK hold their estimates. */
+  static typename InternalImageType::RegionType
+  GetPaddedRegion(const FilterType * filter, const SizeType & padSize, const SizeType & padLowerBound)
+  {
+    typename InternalImageType::IndexType paddedIndex{ filter->GetInput()->GetLargestPossibleRegion().GetIndex() };
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      paddedIndex[dim] -= static_cast<IndexValueType>(padLowerBound[dim]);
+    }
+    return typename InternalImageType::RegionType{ paddedIndex, padSize };
+  }
+
+  /** Deconvolve the input of the filter, padded by `padLowerBound` to `padSize`, by its
+   *  kernel into the requested region of its output with the method and settings that
+   *  are set in `vkParameters`. */
+  static void
+  Deconvolve(FilterType *             filter,
+             const SizeType &         padSize,
+             const SizeType &         padLowerBound,
+             uint64_t                 deviceID,
+             VkCommon &               vkCommon,
+             VkCommon::VkParameters & vkParameters)
+  {
+    const InputImageType * const  input{ filter->GetInput() };
+    const KernelImageType * const kernel{ filter->GetKernelImage() };
+    OutputImageType * const       output{ filter->GetOutput() };
+    if (!input || !kernel || !output)
+    {
+      return;
+    }
+
+    // allocate output buffer memory
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->Allocate();
+
+    // Pad the input as FFTConvolutionImageFilter does, and crop the requested output region
+    // out of the padded domain
+    using KernelImageRegionType = typename KernelImageType::RegionType;
+    using InputImageRegionType = typename InputImageType::RegionType;
+    using OutputImageRegionType = typename OutputImageType::RegionType;
+    const InputImageRegionType &  inputRegion{ input->GetLargestPossibleRegion() };
+    const KernelImageRegionType & kernelRegion{ kernel->GetLargestPossibleRegion() };
+    const OutputImageRegionType & outputRegion{ output->GetRequestedRegion() };
+    itkAssertOrThrowMacro(input->GetBufferedRegion() == inputRegion, "Input region is not buffered");
+    itkAssertOrThrowMacro(kernel->GetBufferedRegion() == kernelRegion, "Kernel region is not buffered");
+
+    // Scale the kernel to a sum of one if requested
+    double kernelScale{ 1.0 };
+    if (filter->GetNormalize())
+    {
+      double kernelSum{ 0.0 };
+      for (ImageRegionConstIterator<KernelImageType> it(kernel, kernelRegion); !it.IsAtEnd(); ++it)
+      {
+        kernelSum += static_cast<double>(it.Get());
+      }
+      kernelScale = 1.0 / kernelSum;
+    }
+
+    // VkFFT computes in the internal precision, to which other pixel types are converted on the
+    // host. Images of the internal precision are read from and left on the device where they can be.
+    constexpr bool convertInput{ !std::is_same<InputPixelType, RealType>::value };
+    constexpr bool convertKernel{ !std::is_same<KernelPixelType, RealType>::value };
+    constexpr bool convertOutput{ !std::is_same<OutputPixelType, RealType>::value };
+
+    const VkCommon::DeviceBufferPointer inputGPUBuffer{
+      convertInput ? nullptr : VkImageDeviceBuffer<InputImageType>::GetInputBuffer(input, deviceID)
+    };
+    typename InternalImageType::Pointer internalInput;
+    const void *                        inputCPUBuffer{ nullptr };
+    if (!inputGPUBuffer)
+    {
+      if (convertInput)
+      {
+        internalInput = InternalImageType::New();
+        internalInput->SetRegions(inputRegion);
+        internalInput->Allocate();
+        ImageAlgorithm::Copy(input, internalInput.GetPointer(), inputRegion, inputRegion);
+        inputCPUBuffer = internalInput->GetBufferPointer();
+      }
+      else
+      {
+        inputCPUBuffer = input->GetBufferPointer();
+      }
+    }
+
+    const VkCommon::DeviceBufferPointer kernelGPUBuffer{
+      convertKernel ? nullptr : VkImageDeviceBuffer<KernelImageType>::GetInputBuffer(kernel, deviceID)
+    };
+    typename InternalImageType::Pointer internalKernel;
+    const void *                        kernelCPUBuffer{ nullptr };
+    if (!kernelGPUBuffer)
+    {
+      if (convertKernel)
+      {
+        internalKernel = InternalImageType::New();
+        internalKernel->SetRegions(kernelRegion);
+        internalKernel->Allocate();
+        ImageAlgorithm::Copy(kernel, internalKernel.GetPointer(), kernelRegion, kernelRegion);
+        kernelCPUBuffer = internalKernel->GetBufferPointer();
+      }
+      else
+      {
+        kernelCPUBuffer = kernel->GetBufferPointer();
+      }
+    }
+
+    VkCommon::DeviceBufferPointer outputGPUBuffer;
+    const bool                    deviceOutput{ !convertOutput && VkImageDeviceBuffer<OutputImageType>::GetOutputBuffer(
+                                                   output, deviceID, outputGPUBuffer) };
+    typename InternalImageType::Pointer internalOutput;
+    void *                              outputCPUBuffer{ nullptr };
+    if (convertOutput)
+    {
+      internalOutput = InternalImageType::New();
+      internalOutput->SetRegions(outputRegion);
+      internalOutput->Allocate();
+      outputCPUBuffer = internalOutput->GetBufferPointer();
+    }
+    else
+    {
+      outputCPUBuffer = output->GetBufferPointer();
+    }
+    itkAssertOrThrowMacro(inputCPUBuffer != nullptr || inputGPUBuffer, "No input buffer");
+    itkAssertOrThrowMacro(kernelCPUBuffer != nullptr || kernelGPUBuffer, "No kernel buffer");
+    itkAssertOrThrowMacro(outputCPUBuffer != nullptr, "No CPU output buffer");
+
+    // Mostly use defaults for VkCommon::VkGPU
+    typename VkCommon::VkGPU vkGPU;
+    vkGPU.device_id = deviceID;
+
+    // Describe the deconvolution in VkCommon::VkParameters, next to its method and settings
+    if (ImageDimension > 0)
+      vkParameters.X = padSize[0];
+    if (ImageDimension > 1)
+      vkParameters.Y = padSize[1];
+    if (ImageDimension > 2)
+      vkParameters.Z = padSize[2];
+    if (std::is_same<RealType, float>::value)
+      vkParameters.P = VkCommon::PrecisionEnum::FLOAT;
+    else if (std::is_same<RealType, double>::value)
+      vkParameters.P = VkCommon::PrecisionEnum::DOUBLE;
+    else
+      itkAssertOrThrowMacro(false, "Unsupported type for real numbers.");
+    vkParameters.fft = VkCommon::FFTEnum::R2HalfH;
+    vkParameters.PSize = sizeof(RealType);
+    vkParameters.I = VkCommon::DirectionEnum::FORWARD;
+    vkParameters.normalized = VkCommon::NormalizationEnum::NORMALIZED;
+    vkParameters.boundaryCondition = VkCommon::GetBoundaryCondition(filter->GetBoundaryCondition());
+    const typename KernelImageType::SizeType & kernelSize{ kernelRegion.GetSize() };
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      vkParameters.padInputSize[dim] = inputRegion.GetSize(dim);
+      vkParameters.padLowerBound[dim] = padLowerBound[dim];
+      vkParameters.kernelSize[dim] = kernelSize[dim];
+      vkParameters.kernelCenter[dim] = kernelSize[dim] / 2;
+      vkParameters.cropSize[dim] = outputRegion.GetSize(dim);
+      vkParameters.cropLowerBound[dim] = static_cast<uint64_t>(static_cast<IndexValueType>(padLowerBound[dim]) +
+                                                               outputRegion.GetIndex(dim) - inputRegion.GetIndex(dim));
+    }
+
+    vkParameters.inputCPUBuffer = inputCPUBuffer;
+    vkParameters.inputBufferBytes = inputRegion.GetNumberOfPixels() * sizeof(RealType);
+    if (!inputGPUBuffer && !internalInput)
+    {
+      VkCommon::IdentifyInput(vkParameters, input);
+    }
+    vkParameters.inputGPUBuffer = inputGPUBuffer;
+    vkParameters.kernelCPUBuffer = kernelCPUBuffer;
+    vkParameters.kernelBufferBytes = kernelRegion.GetNumberOfPixels() * sizeof(RealType);
+    vkParameters.kernelGPUBuffer = kernelGPUBuffer;
+    vkParameters.kernelScale = kernelScale;
+    vkParameters.outputCPUBuffer = outputCPUBuffer;
+    vkParameters.outputBufferBytes = outputRegion.GetNumberOfPixels() * sizeof(RealType);
+    if (deviceOutput)
+    {
+      vkParameters.outputGPUBuffer = &outputGPUBuffer;
+    }
+
+    const VkFFTResult resFFT{ vkCommon.Run(vkGPU, vkParameters) };
+    if (resFFT != VKFFT_SUCCESS)
+    {
+      std::ostringstream mesg;
+      mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
+      itkAssertOrThrowMacro(false, mesg.str());
+    }
+    if (deviceOutput)
+    {
+      VkImageDeviceBuffer<OutputImageType>::SetOutputBuffer(output, outputGPUBuffer);
+    }
+    if (internalOutput)
+    {
+      ImageAlgorithm::Copy(internalOutput.GetPointer(), output, outputRegion, outputRegion);
+    }
+  }
+};
+
+} // namespace itk
+
+#endif // itkVkDeconvolutionHelper_h
@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkDeconvolutionImageFilterFactory_h
+#define itkVkDeconvolutionImageFilterFactory_h
+#include "VkFFTBackendExport.h"
+
+#include "itkVkInverseDeconvolutionImageFilter.h"
+#include "itkVkLandweberDeconvolutionImageFilter.h"
+#include "itkVkRichardsonLucyDeconvolutionImageFilter.h"
+#include "itkVkTikhonovDeconvolutionImageFilter.h"
+#include "itkVkWienerDeconvolutionImageFilter.h"
+#include "itkImage.h"
+#include "itkObjectFactoryBase.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+/** \class VkDeconvolutionImageFilterFactory
+ *
+ * \brief Object Factory implementation for overriding the deconvolution filters
+ *  RichardsonLucyDeconvolutionImageFilter, LandweberDeconvolutionImageFilter,
+ *  InverseDeconvolutionImageFilter, TikhonovDeconvolutionImageFilter and
+ *  WienerDeconvolutionImageFilter with their Vk counterparts
+ *
+ * \sa ObjectFactoryBase
+ * \sa RichardsonLucyDeconvolutionImageFilter
+ * \sa LandweberDeconvolutionImageFilter
+ * \sa InverseDeconvolutionImageFilter
+ * \sa TikhonovDeconvolutionImageFilter
+ * \sa WienerDeconvolutionImageFilter
+ * \sa VkRichardsonLucyDeconvolutionImageFilter
+ * \sa VkLandweberDeconvolutionImageFilter
+ * \sa VkInverseDeconvolutionImageFilter
+ * \sa VkTikhonovDeconvolutionImageFilter
+ * \sa VkWienerDeconvolutionImageFilter
+ *
+ * \ingroup VkFFTBackend
+ * \ingroup ITKDeconvolution
+ * \ingroup FourierTransform
+ */
+class VkDeconvolutionImageFilterFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkDeconvolutionImageFilterFactory);
+
+  using Self = VkDeconvolutionImageFilterFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "A VkDeconvolutionImageFilterFactory factory";
+  }
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkDeconvolutionImageFilterFactory, itk::ObjectFactoryBase);
+
+  /** Register one factory of this type  */
+  static void
+  RegisterOneFactory()
+  {
+    VkDeconvolutionImageFilterFactory::Pointer factory = VkDeconvolutionImageFilterFactory::New();
+
+    ObjectFactoryBase::RegisterFactoryInternal(factory);
+  }
+
+protected:
+  /** Override base deconvolution filter constructors at runtime to return
+   *  upcast Vk instances through the object factory
+   */
+  template <typename PixelType, unsigned int D, unsigned int... ImageDimensions>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int, D, ImageDimensions...> &)
+  {
+    using ImageType = Image<PixelType, D>;
+    using VkRichardsonLucyFilterType = VkRichardsonLucyDeconvolutionImageFilter<ImageType>;
+    this->RegisterOverride(typeid(typename VkRichardsonLucyFilterType::Superclass).name(),
+                           typeid(VkRichardsonLucyFilterType).name(),
+                           "VkRichardsonLucyDeconvolutionImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkRichardsonLucyFilterType>::New());
+    using VkLandweberFilterType = VkLandweberDeconvolutionImageFilter<ImageType>;
+    this->RegisterOverride(typeid(typename VkLandweberFilterType::Superclass).name(),
+                           typeid(VkLandweberFilterType).name(),
+                           "VkLandweberDeconvolutionImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkLandweberFilterType>::New());
+    using VkInverseFilterType = VkInverseDeconvolutionImageFilter<ImageType>;
+    this->RegisterOverride(typeid(typename VkInverseFilterType::Superclass).name(),
+                           typeid(VkInverseFilterType).name(),
+                           "VkInverseDeconvolutionImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkInverseFilterType>::New());
+    using VkTikhonovFilterType = VkTikhonovDeconvolutionImageFilter<ImageType>;
+    this->RegisterOverride(typeid(typename VkTikhonovFilterType::Superclass).name(),
+                           typeid(VkTikhonovFilterType).name(),
+                           "VkTikhonovDeconvolutionImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkTikhonovFilterType>::New());
+    using VkWienerFilterType = VkWienerDeconvolutionImageFilter<ImageType>;
+    this->RegisterOverride(typeid(typename VkWienerFilterType::Superclass).name(),
+                           typeid(VkWienerFilterType).name(),
+                           "VkWienerDeconvolutionImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkWienerFilterType>::New());
+    OverrideSuperclassType<PixelType>(std::integer_sequence<unsigned int, ImageDimensions...>{});
+  }
+  template <typename PixelType>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int> &)
+  {}
+
+  VkDeconvolutionImageFilterFactory()
+  {
+    OverrideSuperclassType<float>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+    OverrideSuperclassType<double>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+  }
+};
+
+} // namespace itk
+
+#endif // itkVkDeconvolutionImageFilterFactory_h
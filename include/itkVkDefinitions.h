@@ -18,10 +18,17 @@
 #ifndef itkVkDefinitions_h
 #define itkVkDefinitions_h
 
+#include "itkConfigure.h"
+
 // Backend selection
 #define VULKAN 0
 #define CUDA 1
 #define HIP 2
 #define OPENCL 3
 
+// Interoperation with the OpenCL buffers of the images of ITK's GPU module
+#if (VKFFT_BACKEND == OPENCL) && defined(ITK_USE_GPU)
+#  define VKFFT_USE_ITK_GPU 1
+#endif
+
 #endif // itkVkDefinitions_h
@@ -0,0 +1,295 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkDeviceContext_h
+#define itkVkDeviceContext_h
+
+#include "VkFFTBackendExport.h"
+#include "itkVkCommon.h"
+#include "itkIntTypes.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ *\class VkDeviceBuffer
+ *
+ *  \brief Device memory that is released along with its last reference.
+ *
+ * \ingroup VkFFTBackend
+ */
+class VkFFTBackend_EXPORT VkDeviceBuffer
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkDeviceBuffer);
+
+  using DeviceMemoryType = VkCommon::DeviceMemoryType;
+  using Pointer = std::shared_ptr<VkDeviceBuffer>;
+
+  VkDeviceBuffer(DeviceMemoryType memory, uint64_t bytes, uint64_t deviceID)
+    : m_Memory{ memory }
+    , m_Bytes{ bytes }
+    , m_DeviceID{ deviceID }
+  {}
+  ~VkDeviceBuffer();
+
+  DeviceMemoryType
+  GetMemory() const
+  {
+    return m_Memory;
+  }
+
+  uint64_t
+  GetBytes() const
+  {
+    return m_Bytes;
+  }
+
+  uint64_t
+  GetDeviceID() const
+  {
+    return m_DeviceID;
+  }
+
+private:
+  DeviceMemoryType m_Memory;
+  uint64_t         m_Bytes;
+  uint64_t         m_DeviceID;
+};
+
+/**
+ *\class VkDeviceContext
+ *
+ *  \brief Backend context shared by all Vk filters that run on one device.
+ *
+ * The context holds the device handles, the compiled kernel library, a cache
+ * of input images that are resident in device memory and a cache of the spectra
+ * of convolution kernels. It is created when a Vk
+ * filter first runs on the device and is kept for the lifetime of the process,
+ * so that device buffers can be handed from one Vk filter to the next.
+ *
+ * When ITK is built with ITK_USE_GPU and the OpenCL backend is used, the context
+ * of a device that ITK's GPUContextManager runs on is shared with it, so that
+ * the Vk filters can read and write the OpenCL buffers of GPUImages.
+ *
+ * \ingroup VkFFTBackend
+ */
+class VkFFTBackend_EXPORT VkDeviceContext
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkDeviceContext);
+
+  using Pointer = std::shared_ptr<VkDeviceContext>;
+  using DeviceMemoryType = VkCommon::DeviceMemoryType;
+  using VkGPU = VkCommon::VkGPU;
+  using PrecisionEnum = VkCommon::PrecisionEnum;
+  using KernelArgument = VkCommon::KernelArgument;
+
+  /** Identify a host buffer of a pipeline data object at one point of its modification history */
+  struct ResidencyKey
+  {
+    const DataObject * dataObject{ nullptr };
+    ModifiedTimeType   timeStamp{ 0 };
+    const void *       hostBuffer{ nullptr };
+    uint64_t           bytes{ 0 };
+  };
+
+  /** Identify the spectra of convolution kernels: the kernel data object at one point of
+   *  its modification history, and how it was moved, scaled and padded before the transform */
+  struct KernelSpectrumKey
+  {
+    const DataObject * dataObject{ nullptr };
+    ModifiedTimeType   timeStamp{ 0 };
+    PrecisionEnum      precision{ PrecisionEnum::FLOAT };
+    uint64_t           size[3] = { 1, 1, 1 };   // padded size of the convolution domain
+    uint64_t           center[3] = { 0, 0, 0 }; // kernel sample at the origin of the domain
+    double             scale{ 1.0 };
+    uint64_t           numberKernels{ 1 }; // kernels that follow one another in the data object
+    uint64_t           correlation{ 0 };   // whether the kernels were mirrored
+  };
+
+  /** Usage of the kernel spectrum cache since the last reset */
+  struct KernelSpectrumStatistics
+  {
+    uint64_t hits{ 0 };      // kernel transforms skipped
+    uint64_t misses{ 0 };    // kernel transforms computed for the cache
+    uint64_t evictions{ 0 }; // spectra released to stay within the budget or after their kernel changed
+    uint64_t entries{ 0 };   // spectra held
+    uint64_t bytes{ 0 };     // bytes held by spectra
+  };
+
+  /** Return the context of the enumerated device, creating it on first use */
+  static VkFFTResult
+  GetInstance(uint64_t deviceID, Pointer & context);
+
+  /** Release the contexts of all devices, with their resident inputs, cached kernel spectra and
+   *  compiled kernels, while the drivers are still loaded. Contexts that are still registered at
+   *  exit are not destroyed, since the drivers may be torn down before static objects are.
+   *  Later calls to GetInstance create new contexts. */
+  static void
+  ReleaseInstances();
+
+  ~VkDeviceContext();
+
+  const VkGPU &
+  GetVkGPU() const
+  {
+    return m_VkGPU;
+  }
+
+  /** Make the context current on the calling thread */
+  VkFFTResult
+  MakeCurrent();
+
+  /** Allocate device memory on this device */
+  VkFFTResult
+  Allocate(uint64_t bytes, VkDeviceBuffer::Pointer & buffer);
+
+#if (VKFFT_BACKEND == OPENCL)
+  /** Reference device memory of this context that is owned elsewhere, such as the buffer
+   *  of an image of ITK's GPU module. The memory is retained until the last reference to
+   *  `buffer` is released. */
+  VkFFTResult
+  Share(DeviceMemoryType memory, uint64_t bytes, VkDeviceBuffer::Pointer & buffer);
+#endif
+
+  /** Whether this context is the context of ITK's GPU module, so that the buffers of
+   *  its GPU images can be used directly */
+  bool
+  IsSharingGPUContext() const
+  {
+    return m_SharingGPUContext;
+  }
+
+  /** Copy between host and device memory, or within device memory, on this device */
+  VkFFTResult
+  CopyHostToDevice(DeviceMemoryType buffer, const void * hostBuffer, uint64_t bytes);
+  VkFFTResult
+  CopyDeviceToHost(void * hostBuffer, DeviceMemoryType buffer, uint64_t bytes);
+  VkFFTResult
+  CopyDeviceToDevice(DeviceMemoryType destination, DeviceMemoryType source, uint64_t bytes);
+
+  /** Wait for the work submitted to this device to complete */
+  VkFFTResult
+  Synchronize();
+
+  /** Launch a kernel of the module's kernel library over `globalSize` work items.
+   *  The library is compiled for each precision on first use. */
+  VkFFTResult
+  LaunchKernel(PrecisionEnum                       precision,
+               const char *                        kernelName,
+               uint64_t                            globalSize,
+               const std::vector<KernelArgument> & arguments);
+
+  /** Return the resident copy of a host buffer, or nullptr if there is none */
+  VkDeviceBuffer::Pointer
+  FindResident(const ResidencyKey & key);
+
+  /** Keep a device copy of a host buffer resident, evicting the least recently used
+   *  copies to stay within `budget` bytes. Older copies of the same data object are
+   *  evicted too. The copy is not kept if it alone exceeds the budget. */
+  void
+  MakeResident(const ResidencyKey & key, const VkDeviceBuffer::Pointer & buffer, uint64_t budget);
+
+  /** Release all resident copies */
+  void
+  ClearResident();
+
+  /** Number of bytes held by resident copies */
+  uint64_t
+  GetResidentBytes() const;
+
+  /** Return the cached spectrum of a convolution kernel, or nullptr if there is none */
+  VkDeviceBuffer::Pointer
+  FindKernelSpectrum(const KernelSpectrumKey & key);
+
+  /** Cache the spectrum of a convolution kernel, evicting the least recently used spectra
+   *  to stay within `budget` bytes. Spectra of an older state of the same kernel are evicted
+   *  too. The spectrum is not kept if it alone exceeds the budget. */
+  void
+  KeepKernelSpectrum(const KernelSpectrumKey & key, const VkDeviceBuffer::Pointer & buffer, uint64_t budget);
+
+  /** Release all cached kernel spectra */
+  void
+  ClearKernelSpectra();
+
+  /** Usage of the kernel spectrum cache */
+  KernelSpectrumStatistics
+  GetKernelSpectrumStatistics() const;
+
+  /** Restart counting hits, misses and evictions of the kernel spectrum cache */
+  void
+  ResetKernelSpectrumStatistics();
+
+private:
+  explicit VkDeviceContext(uint64_t deviceID);
+
+  VkFFTResult
+  Initialize();
+
+#ifdef VKFFT_USE_ITK_GPU
+  /** Adopt the context and command queue of ITK's GPU module if it runs on this device */
+  bool
+  ShareGPUContext();
+#endif
+
+  struct ResidentEntry
+  {
+    ResidencyKey            key{};
+    VkDeviceBuffer::Pointer buffer{};
+    uint64_t                lastUse{ 0 };
+  };
+
+  struct KernelSpectrumEntry
+  {
+    KernelSpectrumKey       key{};
+    VkDeviceBuffer::Pointer buffer{};
+    uint64_t                lastUse{ 0 };
+  };
+
+  VkGPU m_VkGPU{};
+  bool  m_SharingGPUContext{ false };
+
+  // Device kernels compiled from the module's kernel library, per precision
+#if (VKFFT_BACKEND == CUDA)
+  CUmodule                                                    m_KernelModules[2]{ nullptr, nullptr };
+  std::map<std::pair<PrecisionEnum, std::string>, CUfunction> m_Kernels{};
+#elif (VKFFT_BACKEND == OPENCL)
+  cl_program                                                  m_KernelPrograms[2]{ nullptr, nullptr };
+  std::map<std::pair<PrecisionEnum, std::string>, cl_kernel>  m_Kernels{};
+#endif
+  std::mutex m_KernelMutex{};
+
+  std::vector<ResidentEntry> m_Resident{};
+  uint64_t                   m_ResidentUses{ 0 };
+  mutable std::mutex         m_ResidentMutex{};
+
+  std::vector<KernelSpectrumEntry> m_KernelSpectra{};
+  uint64_t                         m_KernelSpectrumUses{ 0 };
+  KernelSpectrumStatistics         m_KernelSpectrumStatistics{};
+  mutable std::mutex               m_KernelSpectrumMutex{};
+};
+
+} // namespace itk
+
+#endif // itkVkDeviceContext_h
@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkDiscreteGaussianImageFilter_h
+#define itkVkDiscreteGaussianImageFilter_h
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkFFTDiscreteGaussianImageFilter.h"
+#include "itkVkFFTDiscreteGaussianImageFilter.h"
+#include "itkVkGlobalConfiguration.h"
+
+#include <type_traits>
+
+namespace itk
+{
+/**
+ *\class VkDiscreteGaussianImageFilter
+ *
+ * \brief Gaussian smoothing that chooses separable or Vk FFT smoothing per update.
+ *
+ * VkDiscreteGaussianImageFilter smooths as DiscreteGaussianImageFilter does,
+ * and is registered in its place by VkDiscreteGaussianImageFilterFactory so
+ * that every call site gets the faster of the two smoothings. On each update
+ * the requested output size and the kernel radius are weighed as in
+ * VkMultiResolutionPyramidImageFilter: if UseSmoothingCostModel is on and
+ * VkGlobalConfiguration holds a cost model of the device benchmarked with the
+ * current global default number of threads, the smoothing with the lower
+ * predicted time is chosen. Otherwise the metric
+ *
+ *  f(i,j,k,x,y,z) = log((i + j + k) * x * y * z)
+ *
+ * of the kernel sizes i,j,k and the requested output size x,y,z is compared
+ * to MetricThreshold. The smoothing is computed by the base class on the CPU
+ * or by VkFFTDiscreteGaussianImageFilter on the device, which requests the
+ * largest possible region of the input.
+ *
+ * Only boundary conditions whose padding the device generates are smoothed
+ * on the device, and four-dimensional images are always smoothed on the CPU.
+ * Smoothing fixes the choice instead.
+ *
+ * \ingroup ITKSmoothing
+ * \ingroup VkFFTBackend
+ *
+ * \sa DiscreteGaussianImageFilter
+ * \sa VkFFTDiscreteGaussianImageFilter
+ * \sa VkMultiResolutionPyramidImageFilter
+ * \sa VkGlobalConfiguration
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT VkDiscreteGaussianImageFilter : public DiscreteGaussianImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkDiscreteGaussianImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = VkDiscreteGaussianImageFilter;
+  using Superclass = DiscreteGaussianImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkDiscreteGaussianImageFilter, DiscreteGaussianImageFilter);
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using SizeType = typename InputImageType::SizeType;
+  using KernelSizeType = SizeType;
+
+  /** Smoother on the device up to three dimensions. */
+  using FFTSmootherType =
+    typename std::conditional<ImageDimension <= 3,
+                              VkFFTDiscreteGaussianImageFilter<InputImageType, OutputImageType>,
+                              FFTDiscreteGaussianImageFilter<InputImageType, OutputImageType>>::type;
+
+  /** Choose the smoothing per update, or fix it. */
+  enum class SmoothingEnum : uint8_t
+  {
+    AUTOMATIC = 0,
+    SPATIAL = 1,
+    FFT = 2
+  };
+
+  /** The smoothing, AUTOMATIC by default. */
+  itkSetEnumMacro(Smoothing, SmoothingEnum);
+  itkGetEnumMacro(Smoothing, SmoothingEnum);
+
+  /** Metric threshold above which the FFT smoothing is chosen when no cost model is
+   *  consulted. Defaults to 8.0 as in VkMultiResolutionPyramidImageFilter. */
+  itkSetMacro(MetricThreshold, float);
+  itkGetConstMacro(MetricThreshold, float);
+
+  /** Consult the smoothing cost model of the device when it is available.
+   *  On by default. */
+  itkSetMacro(UseSmoothingCostModel, bool);
+  itkGetConstMacro(UseSmoothingCostModel, bool);
+  itkBooleanMacro(UseSmoothingCostModel);
+
+  /** Get whether the next update smooths through the FFT, for the requested output
+   *  region and the current parameters. */
+  bool
+  GetUseFFT() const;
+
+  /** Radius of the kernel of GaussianOperator for the variance in pixels along each
+   *  smoothed dimension, or zero. */
+  KernelSizeType
+  ComputeKernelRadius() const;
+
+  /** The metric log10 of the product of the image size and the summed kernel sizes. */
+  static float
+  ComputeMetricValue(const SizeType & size, const KernelSizeType & kernelRadius);
+
+  /** Terms of the smoothing cost model for an image size and kernel radius: the pixels,
+   *  the kernel taps summed over the dimensions and the padded samples of FFT smoothing */
+  static void
+  ComputeSmoothingTerms(const SizeType &       size,
+                        const KernelSizeType & kernelRadius,
+                        double &               pixels,
+                        double &               taps,
+                        double &               paddedSamples);
+
+protected:
+  VkDiscreteGaussianImageFilter() = default;
+  ~VkDiscreteGaussianImageFilter() override = default;
+
+  /** The FFT smoothing requests the largest possible region of the input. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using VkSmootherType = std::integral_constant<bool, (ImageDimension <= 3)>;
+
+  /** Whether the device generates the padding of the input boundary condition. Only
+   *  the Vk smoother does. */
+  bool
+  IsDeviceBoundaryCondition(std::true_type) const;
+  bool
+  IsDeviceBoundaryCondition(std::false_type) const
+  {
+    return false;
+  }
+
+  SmoothingEnum                     m_Smoothing{ SmoothingEnum::AUTOMATIC };
+  float                             m_MetricThreshold{ 8.0f };
+  bool                              m_UseSmoothingCostModel{ true };
+  typename FFTSmootherType::Pointer m_FFTSmoother{ FFTSmootherType::New() };
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkDiscreteGaussianImageFilter.hxx"
+#endif
+
+#endif // itkVkDiscreteGaussianImageFilter_h
@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkDiscreteGaussianImageFilter_hxx
+#define itkVkDiscreteGaussianImageFilter_hxx
+
+#include "itkVkDiscreteGaussianImageFilter.h"
+#include "itkGaussianOperator.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+
+#include <cmath>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+bool
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GetUseFFT() const
+{
+  if (m_Smoothing != SmoothingEnum::AUTOMATIC)
+  {
+    return m_Smoothing == SmoothingEnum::FFT;
+  }
+  if (!this->IsDeviceBoundaryCondition(VkSmootherType{}))
+  {
+    return false;
+  }
+
+  const SizeType       requestedSize{ this->GetOutput()->GetRequestedRegion().GetSize() };
+  const KernelSizeType kernelRadius{ this->ComputeKernelRadius() };
+
+  // Prefer the predictions of the cost model of the device, if it was calibrated with as many threads
+  VkGlobalConfiguration::SmoothingCostModel model;
+  if (m_UseSmoothingCostModel &&
+      VkGlobalConfiguration::GetSmoothingCostModel(VkGlobalConfiguration::GetDeviceID(), model) &&
+      model.numberOfWorkUnits == MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+  {
+    double pixels, taps, paddedSamples;
+    ComputeSmoothingTerms(requestedSize, kernelRadius, pixels, taps, paddedSamples);
+    return model.PredictFFT(pixels, paddedSamples) < model.PredictSpatial(pixels, taps);
+  }
+
+  return ComputeMetricValue(requestedSize, kernelRadius) > m_MetricThreshold;
+}
+
+template <typename TInputImage, typename TOutputImage>
+bool
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::IsDeviceBoundaryCondition(std::true_type) const
+{
+  return FFTSmootherType::GetVkBoundaryCondition(this->GetInputBoundaryCondition()) !=
+         VkCommon::BoundaryConditionEnum::NONE;
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::ComputeKernelRadius() const -> KernelSizeType
+{
+  const InputImageType * const input{ this->GetInput() };
+
+  KernelSizeType radius;
+  radius.Fill(0);
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    if (dim < this->GetFilterDimensionality() && this->GetVariance()[dim] > 0.0)
+    {
+      double variance{ this->GetVariance()[dim] };
+      if (this->GetUseImageSpacing() && input)
+      {
+        variance /= Math::sqr(input->GetSpacing()[dim]);
+      }
+      GaussianOperator<double, ImageDimension> oper;
+      oper.SetDirection(dim);
+      oper.SetVariance(variance);
+      oper.SetMaximumError(this->GetMaximumError()[dim]);
+      oper.SetMaximumKernelWidth(this->GetMaximumKernelWidth());
+      oper.CreateDirectional();
+      radius[dim] = oper.GetRadius(dim);
+    }
+  }
+  return radius;
+}
+
+template <typename TInputImage, typename TOutputImage>
+float
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::ComputeMetricValue(const SizeType &       size,
+                                                                            const KernelSizeType & kernelRadius)
+{
+  unsigned int totalKernelSize{ 0 };
+  float        metricValue{ 1.0f };
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    totalKernelSize += kernelRadius[dim] * 2 + 1;
+    metricValue *= size[dim];
+  }
+  metricValue *= totalKernelSize;
+  return std::log10(metricValue);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::ComputeSmoothingTerms(const SizeType &       size,
+                                                                               const KernelSizeType & kernelRadius,
+                                                                               double &               pixels,
+                                                                               double &               taps,
+                                                                               double &               paddedSamples)
+{
+  // The FFT smoother pads by the kernel radius to a size with prime factors of at most 13
+  pixels = 1.0;
+  taps = 0.0;
+  paddedSamples = 1.0;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    SizeValueType paddedSize{ size[dim] + 2 * kernelRadius[dim] };
+    while (Math::GreatestPrimeFactor(paddedSize) > 13)
+    {
+      ++paddedSize;
+    }
+    pixels *= size[dim];
+    taps += 2 * kernelRadius[dim] + 1;
+    paddedSamples *= paddedSize;
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  if (!this->GetUseFFT())
+  {
+    Superclass::GenerateInputRequestedRegion();
+    return;
+  }
+
+  // The FFT is computed over the whole input
+  auto * const input{ const_cast<InputImageType *>(this->GetInput()) };
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  if (!this->GetUseFFT())
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  // Smooth the requested region of the output in a mini-pipeline
+  m_FFTSmoother->SetInput(this->GetInput());
+  m_FFTSmoother->SetVariance(this->GetVariance());
+  m_FFTSmoother->SetMaximumError(this->GetMaximumError());
+  m_FFTSmoother->SetMaximumKernelWidth(this->GetMaximumKernelWidth());
+  m_FFTSmoother->SetFilterDimensionality(this->GetFilterDimensionality());
+  m_FFTSmoother->SetUseImageSpacing(this->GetUseImageSpacing());
+  m_FFTSmoother->SetInputBoundaryCondition(this->GetInputBoundaryCondition());
+  m_FFTSmoother->GraftOutput(this->GetOutput());
+  m_FFTSmoother->Update();
+  this->GraftOutput(m_FFTSmoother->GetOutput());
+  m_FFTSmoother->SetInput(nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkDiscreteGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Smoothing: " << static_cast<int>(m_Smoothing) << std::endl;
+  os << indent << "MetricThreshold: " << m_MetricThreshold << std::endl;
+  os << indent << "UseSmoothingCostModel: " << m_UseSmoothingCostModel << std::endl;
+  itkPrintSelfObjectMacro(FFTSmoother);
+}
+} // namespace itk
+
+#endif // itkVkDiscreteGaussianImageFilter_hxx
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkDiscreteGaussianImageFilterFactory_h
+#define itkVkDiscreteGaussianImageFilterFactory_h
+#include "VkFFTBackendExport.h"
+
+#include "itkVkDiscreteGaussianImageFilter.h"
+#include "itkImage.h"
+#include "itkObjectFactoryBase.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+/** \class VkDiscreteGaussianImageFilterFactory
+ *
+ * \brief Object Factory implementation for overriding
+ *  DiscreteGaussianImageFilter with VkDiscreteGaussianImageFilter
+ *
+ * The override chooses separable or Vk FFT smoothing on each update. It is
+ * not registered by VkFFTImageFilterInitFactory.
+ *
+ * \sa ObjectFactoryBase
+ * \sa DiscreteGaussianImageFilter
+ * \sa VkDiscreteGaussianImageFilter
+ *
+ * \ingroup VkFFTBackend
+ * \ingroup ITKSmoothing
+ * \ingroup FourierTransform
+ */
+class VkDiscreteGaussianImageFilterFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkDiscreteGaussianImageFilterFactory);
+
+  using Self = VkDiscreteGaussianImageFilterFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "A VkDiscreteGaussianImageFilterFactory factory";
+  }
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkDiscreteGaussianImageFilterFactory, itk::ObjectFactoryBase);
+
+  /** Register one factory of this type  */
+  static void
+  RegisterOneFactory()
+  {
+    VkDiscreteGaussianImageFilterFactory::Pointer factory = VkDiscreteGaussianImageFilterFactory::New();
+
+    ObjectFactoryBase::RegisterFactoryInternal(factory);
+  }
+
+protected:
+  /** Override base DiscreteGaussianImageFilter constructor at runtime to return
+   *  an upcast VkDiscreteGaussianImageFilter instance through the object factory
+   */
+  template <typename PixelType, unsigned int D, unsigned int... ImageDimensions>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int, D, ImageDimensions...> &)
+  {
+    using ImageType = Image<PixelType, D>;
+    using VkFilterType = VkDiscreteGaussianImageFilter<ImageType, ImageType>;
+    this->RegisterOverride(typeid(typename VkFilterType::Superclass).name(),
+                           typeid(VkFilterType).name(),
+                           "VkDiscreteGaussianImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkFilterType>::New());
+    OverrideSuperclassType<PixelType>(std::integer_sequence<unsigned int, ImageDimensions...>{});
+  }
+  template <typename PixelType>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int> &)
+  {}
+
+  VkDiscreteGaussianImageFilterFactory()
+  {
+    OverrideSuperclassType<float>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+    OverrideSuperclassType<double>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+  }
+};
+
+} // namespace itk
+
+#endif // itkVkDiscreteGaussianImageFilterFactory_h
@@ -0,0 +1,403 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTBackendDispatch_h
+#define itkVkFFTBackendDispatch_h
+
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIterator.h"
+#include "itkMath.h"
+#include "itkObjectFactoryBase.h"
+#include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <typeinfo>
+#include <vector>
+
+namespace itk
+{
+/** Throughput in samples per second of the device and of the host backend on the parts of
+ *  the batches of a Vk FFT filter, as moving averages over its updates. Zero until measured. */
+struct VkFFTBatchThroughput
+{
+  double device{ 0.0 };
+  double host{ 0.0 };
+
+  /** Share of a batch for the host backend such that both parts finish together, or a
+   *  quarter until both throughputs were measured. */
+  double
+  GetHostShare() const
+  {
+    return device > 0.0 && host > 0.0 ? host / (device + host) : 0.25;
+  }
+
+  void
+  Update(const double deviceSamples, const double deviceSeconds, const double hostSamples, const double hostSeconds)
+  {
+    const auto average = [](double & throughput, const double samples, const double seconds) {
+      if (seconds > 0.0)
+      {
+        throughput = throughput > 0.0 ? 0.5 * (throughput + samples / seconds) : samples / seconds;
+      }
+    };
+    average(device, deviceSamples, deviceSeconds);
+    average(host, hostSamples, hostSeconds);
+  }
+};
+
+/**
+ *\class VkFFTBackendDispatch
+ *
+ * \brief Dispatch of small transforms of a Vk FFT filter to the next FFT backend on the host.
+ *
+ * Vk FFT filters are registered ahead of the other FFT backends, so that every
+ * transform pays the overhead of the device. A transform with fewer samples than
+ * VkGlobalConfiguration::GetFFTDeviceMinimumSamples for the class of the Vk
+ * filter, its precision and its device is computed instead by the next backend
+ * registered for the base class of the filter, such as FFTW or Vnl, provided
+ * that the filter reads and writes images in host memory without options of its
+ * own and that the backend supports the size. The samples of a transform are
+ * those of the larger of its input and output.
+ *
+ * CalibrateDeviceMinimumSamples times both backends over a range of sizes and
+ * stores the crossover in VkGlobalConfiguration.
+ *
+ * GenerateDataSplit instead splits the batch of lines of a 1D filter between the
+ * device and the host backend, which run concurrently. The share of the host
+ * follows the throughputs that both reached in the previous updates of the
+ * filter, so that both parts take about as long.
+ *
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkGlobalConfiguration
+ */
+template <typename TVkFilter>
+class VkFFTBackendDispatch
+{
+public:
+  using VkFilterType = TVkFilter;
+  using BaseFilterType = typename VkFilterType::Superclass;
+  using BaseFilterPointer = typename BaseFilterType::Pointer;
+  using InputImageType = typename VkFilterType::InputImageType;
+  using OutputImageType = typename VkFilterType::OutputImageType;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using RealType = typename VkFilterType::RealType;
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  /** The first FFT backend registered for the base class of the Vk filter that is not the
+   *  Vk filter itself, or nullptr if there is none. */
+  static BaseFilterPointer
+  CreateHostBackend()
+  {
+    for (const LightObject::Pointer & object : ObjectFactoryBase::CreateAllInstance(typeid(BaseFilterType).name()))
+    {
+      auto * const backend{ dynamic_cast<BaseFilterType *>(object.GetPointer()) };
+      if (backend && !dynamic_cast<VkFilterType *>(backend))
+      {
+        return backend;
+      }
+    }
+    return nullptr;
+  }
+
+  /** Generate the output of the Vk filter with the host backend if its transform is smaller
+   *  than the crossover of its device. The backend is created once into `backend`, and
+   *  `configure` copies the parameters of the base class of the filter onto it. Returns
+   *  whether the host backend generated the output. */
+  template <typename TConfigure>
+  static bool
+  GenerateDataOnHost(VkFilterType * filter, BaseFilterPointer & backend, const TConfigure & configure)
+  {
+    const InputImageType * const input{ filter->GetInput() };
+    OutputImageType * const      output{ filter->GetOutput() };
+    if (!input || !output || VkImageDeviceBuffer<InputImageType>::IsDeviceImage(input) ||
+        VkImageDeviceBuffer<OutputImageType>::IsDeviceImage(output))
+    {
+      return false;
+    }
+    const uint64_t minimumSamples{ VkGlobalConfiguration::GetFFTDeviceMinimumSamples(
+      filter->GetDeviceID(), filter->GetNameOfClass(), sizeof(RealType)) };
+    if (GetNumberOfSamples(input, output) >= minimumSamples)
+    {
+      return false;
+    }
+    if (!backend)
+    {
+      backend = CreateHostBackend();
+    }
+    if (!backend || !IsSupported(backend, input, output))
+    {
+      return false;
+    }
+
+    // Transform in a mini-pipeline
+    configure(backend.GetPointer());
+    backend->SetNumberOfWorkUnits(filter->GetNumberOfWorkUnits());
+    backend->SetInput(input);
+    backend->GraftOutput(output);
+    backend->Update();
+    filter->GraftOutput(backend->GetOutput());
+    backend->SetInput(nullptr);
+    return true;
+  }
+
+  /** Generate the output of a Vk 1D FFT filter whose UseHostBatchSplit is on by splitting the
+   *  lines of its requested region along their outermost dimension other than the direction
+   *  of the transform: `deviceFilter`, a Vk filter of the same class created once, transforms
+   *  the first slab on the device while the host backend transforms the rest. The throughputs
+   *  of both parts update `throughput`. Returns whether the output was split. */
+  template <typename TConfigure>
+  static bool
+  GenerateDataSplit(VkFilterType *                   filter,
+                    BaseFilterPointer &              backend,
+                    typename VkFilterType::Pointer & deviceFilter,
+                    VkFFTBatchThroughput &           throughput,
+                    const TConfigure &               configure)
+  {
+    using ClockType = std::chrono::steady_clock;
+
+    const InputImageType * const input{ filter->GetInput() };
+    OutputImageType * const      output{ filter->GetOutput() };
+    if (!filter->GetUseHostBatchSplit() || !input || !output ||
+        VkImageDeviceBuffer<InputImageType>::IsDeviceImage(input) ||
+        VkImageDeviceBuffer<OutputImageType>::IsDeviceImage(output))
+    {
+      return false;
+    }
+
+    // Split across the outermost dimension with several lines other than the direction of the
+    // transform. Both slabs of the output buffer are contiguous, and are written in place,
+    // unless the transform runs along an outer dimension.
+    const OutputImageRegionType region{ output->GetRequestedRegion() };
+    unsigned int                splitDimension{ ImageDimension };
+    bool                        contiguous{ true };
+    for (unsigned int dim{ ImageDimension }; dim-- > 0;)
+    {
+      if (region.GetSize(dim) > 1)
+      {
+        if (dim != filter->GetDirection())
+        {
+          splitDimension = dim;
+          break;
+        }
+        contiguous = false;
+      }
+    }
+    if (splitDimension == ImageDimension)
+    {
+      return false;
+    }
+    if (!backend)
+    {
+      backend = CreateHostBackend();
+    }
+    if (!backend || !IsSupported(backend, input, output))
+    {
+      return false;
+    }
+    if (!deviceFilter)
+    {
+      deviceFilter = VkFilterType::New();
+    }
+
+    // Both parts get at least one line so that both throughputs keep being measured
+    const SizeValueType   lines{ region.GetSize(splitDimension) };
+    const SizeValueType   hostLines{ std::min<SizeValueType>(
+      lines - 1, std::max<SizeValueType>(1, std::llround(lines * throughput.GetHostShare()))) };
+    OutputImageRegionType deviceRegion{ region };
+    deviceRegion.SetSize(splitDimension, lines - hostLines);
+    OutputImageRegionType hostRegion{ region };
+    hostRegion.SetIndex(splitDimension,
+                        region.GetIndex(splitDimension) + static_cast<IndexValueType>(lines - hostLines));
+    hostRegion.SetSize(splitDimension, hostLines);
+
+    output->SetBufferedRegion(region);
+    output->Allocate();
+
+    // Transform a part in a mini-pipeline from a graft of the input into its slab of the output
+    // buffer when it is contiguous, copying it there otherwise or if the part allocated its own
+    // buffer, and time it
+    const auto transformPart = [input, output, contiguous](BaseFilterType *               part,
+                                                           const OutputImageRegionType & partRegion) {
+      auto partInput{ InputImageType::New() };
+      partInput->Graft(input);
+      auto partOutput{ OutputImageType::New() };
+      partOutput->CopyInformation(output);
+      partOutput->SetRequestedRegion(partRegion);
+      OutputPixelType * slab{ nullptr };
+      if (contiguous)
+      {
+        slab = output->GetBufferPointer() + output->ComputeOffset(partRegion.GetIndex());
+        partOutput->SetBufferedRegion(partRegion);
+        partOutput->GetPixelContainer()->SetImportPointer(slab, partRegion.GetNumberOfPixels());
+      }
+
+      const auto start{ ClockType::now() };
+      part->SetInput(partInput);
+      part->GraftOutput(partOutput);
+      part->Update();
+      if (part->GetOutput()->GetBufferPointer() != slab)
+      {
+        ImageAlgorithm::Copy(part->GetOutput(), output, partRegion, partRegion);
+      }
+      part->SetInput(nullptr);
+      return std::chrono::duration<double>(ClockType::now() - start).count();
+    };
+
+    configure(backend.GetPointer());
+    configure(deviceFilter.GetPointer());
+    deviceFilter->SetUseVkGlobalConfiguration(false);
+    deviceFilter->SetDeviceID(filter->GetDeviceID());
+    std::future<double> hostSeconds{ std::async(
+      std::launch::async, [&transformPart, &backend, &hostRegion]() { return transformPart(backend, hostRegion); }) };
+    const double deviceSeconds{ transformPart(deviceFilter, deviceRegion) };
+    throughput.Update(static_cast<double>(deviceRegion.GetNumberOfPixels()),
+                      deviceSeconds,
+                      static_cast<double>(hostRegion.GetNumberOfPixels()),
+                      hostSeconds.get());
+    return true;
+  }
+
+  /** Time the Vk filter and the host backend with their default parameters on images whose
+   *  sides are powers of two, up to the given number of samples, and store the smallest
+   *  number of samples from which the device is faster at every measured size in
+   *  VkGlobalConfiguration for the global device. */
+  static void
+  CalibrateDeviceMinimumSamples(const uint64_t maximumSamples = uint64_t{ 1 } << 20)
+  {
+    using ClockType = std::chrono::steady_clock;
+    constexpr unsigned int repetitions{ 3 };
+
+    const auto        vkFilter{ VkFilterType::New() };
+    BaseFilterPointer backend{ CreateHostBackend() };
+    if (!backend)
+    {
+      return;
+    }
+
+    // The Vk filter transforms every size on the device while it is timed
+    VkGlobalConfiguration::SetFFTDeviceMinimumSamples(
+      vkFilter->GetDeviceID(), vkFilter->GetNameOfClass(), sizeof(RealType), 0);
+
+    // Best of a few runs of a filter, after a first run that initializes it
+    const auto timeFilter = [](BaseFilterType * filter) {
+      filter->Update();
+      double seconds{ std::numeric_limits<double>::max() };
+      for (unsigned int repetition{ 0 }; repetition < repetitions; ++repetition)
+      {
+        filter->Modified();
+        const auto start{ ClockType::now() };
+        filter->Update();
+        seconds = std::min(seconds, std::chrono::duration<double>(ClockType::now() - start).count());
+      }
+      return seconds;
+    };
+
+    std::vector<std::pair<uint64_t, bool>> deviceFaster;
+    for (SizeValueType side{ 4 }; std::pow(static_cast<double>(side), ImageDimension) <= maximumSamples; side *= 2)
+    {
+      typename InputImageType::SizeType size;
+      size.Fill(side);
+      auto image{ InputImageType::New() };
+      image->SetRegions(size);
+      image->Allocate();
+      SizeValueType value{ 0 };
+      for (ImageRegionIterator<InputImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+      {
+        it.Set(static_cast<InputPixelType>(static_cast<RealType>(value++ % 251)));
+      }
+
+      vkFilter->SetInput(image);
+      backend->SetInput(image);
+      backend->UpdateOutputInformation();
+      if (!IsSupported(backend, image, backend->GetOutput()))
+      {
+        continue;
+      }
+      const double deviceSeconds{ timeFilter(vkFilter) };
+      const double hostSeconds{ timeFilter(backend) };
+      deviceFaster.emplace_back(GetNumberOfSamples(image, backend->GetOutput()), deviceSeconds < hostSeconds);
+    }
+    if (deviceFaster.empty())
+    {
+      return;
+    }
+
+    // The smallest size from which the device is faster at every larger size
+    uint64_t minimumSamples{ deviceFaster.back().first + 1 };
+    for (auto it = deviceFaster.rbegin(); it != deviceFaster.rend() && it->second; ++it)
+    {
+      minimumSamples = it->first;
+    }
+    if (minimumSamples == deviceFaster.front().first)
+    {
+      minimumSamples = 0;
+    }
+    VkGlobalConfiguration::SetFFTDeviceMinimumSamples(
+      vkFilter->GetDeviceID(), vkFilter->GetNameOfClass(), sizeof(RealType), minimumSamples);
+  }
+
+private:
+  static uint64_t
+  GetNumberOfSamples(const InputImageType * input, const OutputImageType * output)
+  {
+    return std::max<uint64_t>(input->GetLargestPossibleRegion().GetNumberOfPixels(),
+                              output->GetLargestPossibleRegion().GetNumberOfPixels());
+  }
+
+  /** Greatest prime factor of the sizes that the backend supports. Base classes that do not
+   *  report it are assumed to support prime factors up to 5, as Vnl does. */
+  template <typename TBackend>
+  static auto
+  GetGreatestPrimeFactor(const TBackend * backend, int) -> decltype(backend->GetSizeGreatestPrimeFactor())
+  {
+    return backend->GetSizeGreatestPrimeFactor();
+  }
+  template <typename TBackend>
+  static SizeValueType
+  GetGreatestPrimeFactor(const TBackend *, long)
+  {
+    return 5;
+  }
+
+  /** Whether the backend supports the sizes of the input and the output. */
+  static bool
+  IsSupported(const BaseFilterType * backend, const InputImageType * input, const OutputImageType * output)
+  {
+    const SizeValueType greatestPrimeFactor{ GetGreatestPrimeFactor(backend, 0) };
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      if (Math::GreatestPrimeFactor(input->GetLargestPossibleRegion().GetSize(dim)) > greatestPrimeFactor ||
+          Math::GreatestPrimeFactor(output->GetLargestPossibleRegion().GetSize(dim)) > greatestPrimeFactor)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+} // namespace itk
+
+#endif // itkVkFFTBackendDispatch_h
@@ -0,0 +1,145 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTConvolutionImageFilter_h
+#define itkVkFFTConvolutionImageFilter_h
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImage.h"
+#include "itkVkCommon.h"
+#include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
+
+namespace itk
+{
+/**
+ *\class VkFFTConvolutionImageFilter
+ *
+ * \brief Vk-based convolution of an image with a kernel through the FFT.
+ *
+ * This filter computes the same convolution as FFTConvolutionImageFilter
+ * entirely on the device: the input is padded according to the boundary
+ * condition, the kernel is moved to the origin of the padded domain, and
+ * VkFFT computes the forward transform, the multiplication by the kernel
+ * spectrum and the inverse transform in a single fused pass before the
+ * output region is cropped. Only the input, the kernel and the output
+ * cross the bus.
+ *
+ * Input, kernel and output pixels other than TInternalPrecision are
+ * converted on the host.
+ *
+ * Within the kernel spectrum cache budget of VkGlobalConfiguration, the
+ * spectrum of the kernel stays on the device, and later convolutions with
+ * the same unmodified kernel and padded size skip the kernel transform.
+ *
+ * \ingroup FourierTransform
+ * \ingroup ITKConvolution
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkCommon::GetBoundaryCondition
+ * \sa VkGlobalConfiguration
+ * \sa FFTConvolutionImageFilter
+ */
+template <typename TInputImage,
+          typename TKernelImage = TInputImage,
+          typename TOutputImage = TInputImage,
+          typename TInternalPrecision = double>
+class VkFFTConvolutionImageFilter
+  : public FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTConvolutionImageFilter);
+
+  using InputImageType = TInputImage;
+  using KernelImageType = TKernelImage;
+  using OutputImageType = TOutputImage;
+  static_assert(std::is_same<TInternalPrecision, float>::value || std::is_same<TInternalPrecision, double>::value,
+                "Unsupported internal precision");
+  static_assert(TInputImage::ImageDimension >= 1 && TInputImage::ImageDimension <= 3, "Unsupported image dimension");
+
+  /** Standard class type aliases. */
+  using Self = VkFFTConvolutionImageFilter;
+  using Superclass = FFTConvolutionImageFilter<InputImageType, KernelImageType, OutputImageType, TInternalPrecision>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using InputPixelType = typename InputImageType::PixelType;
+  using KernelPixelType = typename KernelImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using RealType = TInternalPrecision;
+  using SizeType = typename InputImageType::SizeType;
+  using SizeValueType = typename InputImageType::SizeValueType;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using BoundaryConditionEnum = VkCommon::BoundaryConditionEnum;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTConvolutionImageFilter, FFTConvolutionImageFilter);
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in filters constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current filter settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+  /** Boundary condition that the device generates for the boundary condition of
+   *  the filter, or NONE if it cannot generate it. */
+  BoundaryConditionEnum
+  GetVkBoundaryCondition() const;
+
+protected:
+  VkFFTConvolutionImageFilter();
+  ~VkFFTConvolutionImageFilter() override = default;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool     m_UseVkGlobalConfiguration{ true };
+  uint64_t m_DeviceID{ 0UL };
+
+  VkCommon m_VkCommon{};
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkFFTConvolutionImageFilter.hxx"
+#endif
+
+#endif // itkVkFFTConvolutionImageFilter_h
@@ -0,0 +1,251 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTConvolutionImageFilter_hxx
+#define itkVkFFTConvolutionImageFilter_hxx
+
+#include "itkVkFFTConvolutionImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+VkFFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::VkFFTConvolutionImageFilter()
+{
+  this->SetSizeGreatestPrimeFactor(m_VkCommon.GetGreatestPrimeFactor());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+VkFFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetVkBoundaryCondition()
+  const -> BoundaryConditionEnum
+{
+  return VkCommon::GetBoundaryCondition(this->GetBoundaryCondition());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
+{
+  const BoundaryConditionEnum boundaryCondition{ this->GetVkBoundaryCondition() };
+  if (boundaryCondition == BoundaryConditionEnum::NONE)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  // get pointers to the input, the kernel and the output
+  const InputImageType * const  input{ this->GetInput() };
+  const KernelImageType * const kernel{ this->GetKernelImage() };
+  OutputImageType * const       output{ this->GetOutput() };
+  if (!input || !kernel || !output)
+  {
+    return;
+  }
+
+  // we don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process
+  const ProgressReporter progress(this, 0, 1);
+
+  // allocate output buffer memory
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+
+  // Pad the input as FFTConvolutionImageFilter does, and crop the requested output region
+  // out of the padded domain
+  using KernelImageRegionType = typename KernelImageType::RegionType;
+  const InputImageRegionType &  inputRegion{ input->GetLargestPossibleRegion() };
+  const KernelImageRegionType & kernelRegion{ kernel->GetLargestPossibleRegion() };
+  const OutputImageRegionType & outputRegion{ output->GetRequestedRegion() };
+  itkAssertOrThrowMacro(input->GetBufferedRegion() == inputRegion, "Input region is not buffered");
+  itkAssertOrThrowMacro(kernel->GetBufferedRegion() == kernelRegion, "Kernel region is not buffered");
+  const SizeType padSize{ this->GetPadSize() };
+  const SizeType padLowerBound{ this->GetPadLowerBound() };
+
+  // Scale the kernel to a sum of one if requested
+  double kernelScale{ 1.0 };
+  if (this->GetNormalize())
+  {
+    double kernelSum{ 0.0 };
+    for (ImageRegionConstIterator<KernelImageType> it(kernel, kernelRegion); !it.IsAtEnd(); ++it)
+    {
+      kernelSum += static_cast<double>(it.Get());
+    }
+    kernelScale = 1.0 / kernelSum;
+  }
+
+  // VkFFT computes in the internal precision, to which other pixel types are converted on the host.
+  // Images of the internal precision are read from and left on the device where they can be.
+  using InternalImageType = Image<RealType, ImageDimension>;
+  constexpr bool convertInput{ !std::is_same<InputPixelType, RealType>::value };
+  constexpr bool convertKernel{ !std::is_same<KernelPixelType, RealType>::value };
+  constexpr bool convertOutput{ !std::is_same<OutputPixelType, RealType>::value };
+
+  const VkCommon::DeviceBufferPointer inputGPUBuffer{
+    convertInput ? nullptr : VkImageDeviceBuffer<InputImageType>::GetInputBuffer(input, this->GetDeviceID())
+  };
+  typename InternalImageType::Pointer internalInput;
+  const void *                        inputCPUBuffer{ nullptr };
+  if (!inputGPUBuffer)
+  {
+    if (convertInput)
+    {
+      internalInput = InternalImageType::New();
+      internalInput->SetRegions(inputRegion);
+      internalInput->Allocate();
+      ImageAlgorithm::Copy(input, internalInput.GetPointer(), inputRegion, inputRegion);
+      inputCPUBuffer = internalInput->GetBufferPointer();
+    }
+    else
+    {
+      inputCPUBuffer = input->GetBufferPointer();
+    }
+  }
+
+  const VkCommon::DeviceBufferPointer kernelGPUBuffer{
+    convertKernel ? nullptr : VkImageDeviceBuffer<KernelImageType>::GetInputBuffer(kernel, this->GetDeviceID())
+  };
+  typename InternalImageType::Pointer internalKernel;
+  const void *                        kernelCPUBuffer{ nullptr };
+  if (!kernelGPUBuffer)
+  {
+    if (convertKernel)
+    {
+      internalKernel = InternalImageType::New();
+      internalKernel->SetRegions(kernelRegion);
+      internalKernel->Allocate();
+      ImageAlgorithm::Copy(kernel, internalKernel.GetPointer(), kernelRegion, kernelRegion);
+      kernelCPUBuffer = internalKernel->GetBufferPointer();
+    }
+    else
+    {
+      kernelCPUBuffer = kernel->GetBufferPointer();
+    }
+  }
+
+  VkCommon::DeviceBufferPointer outputGPUBuffer;
+  const bool                    deviceOutput{ !convertOutput && VkImageDeviceBuffer<OutputImageType>::GetOutputBuffer(
+                                                 output, this->GetDeviceID(), outputGPUBuffer) };
+  typename InternalImageType::Pointer internalOutput;
+  void *                              outputCPUBuffer{ nullptr };
+  if (convertOutput)
+  {
+    internalOutput = InternalImageType::New();
+    internalOutput->SetRegions(outputRegion);
+    internalOutput->Allocate();
+    outputCPUBuffer = internalOutput->GetBufferPointer();
+  }
+  else
+  {
+    outputCPUBuffer = output->GetBufferPointer();
+  }
+  itkAssertOrThrowMacro(inputCPUBuffer != nullptr || inputGPUBuffer, "No input buffer");
+  itkAssertOrThrowMacro(kernelCPUBuffer != nullptr || kernelGPUBuffer, "No kernel buffer");
+  itkAssertOrThrowMacro(outputCPUBuffer != nullptr, "No CPU output buffer");
+
+  // Mostly use defaults for VkCommon::VkGPU
+  typename VkCommon::VkGPU vkGPU;
+  vkGPU.device_id = this->GetDeviceID();
+
+  // Describe this filter in VkCommon::VkParameters
+  typename VkCommon::VkParameters vkParameters;
+  if (ImageDimension > 0)
+    vkParameters.X = padSize[0];
+  if (ImageDimension > 1)
+    vkParameters.Y = padSize[1];
+  if (ImageDimension > 2)
+    vkParameters.Z = padSize[2];
+  if (std::is_same<RealType, float>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::FLOAT;
+  else if (std::is_same<RealType, double>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::DOUBLE;
+  else
+    itkAssertOrThrowMacro(false, "Unsupported type for real numbers.");
+  vkParameters.fft = VkCommon::FFTEnum::R2HalfH;
+  vkParameters.PSize = sizeof(RealType);
+  vkParameters.I = VkCommon::DirectionEnum::FORWARD;
+  vkParameters.normalized = VkCommon::NormalizationEnum::NORMALIZED;
+  vkParameters.performConvolution = 1;
+  vkParameters.boundaryCondition = boundaryCondition;
+  const typename KernelImageType::SizeType & kernelSize{ kernelRegion.GetSize() };
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    vkParameters.padInputSize[dim] = inputRegion.GetSize(dim);
+    vkParameters.padLowerBound[dim] = padLowerBound[dim];
+    vkParameters.kernelSize[dim] = kernelSize[dim];
+    vkParameters.kernelCenter[dim] = kernelSize[dim] / 2;
+    vkParameters.cropSize[dim] = outputRegion.GetSize(dim);
+    vkParameters.cropLowerBound[dim] = static_cast<uint64_t>(static_cast<IndexValueType>(padLowerBound[dim]) +
+                                                             outputRegion.GetIndex(dim) - inputRegion.GetIndex(dim));
+  }
+
+  vkParameters.inputCPUBuffer = inputCPUBuffer;
+  vkParameters.inputBufferBytes = inputRegion.GetNumberOfPixels() * sizeof(RealType);
+  if (!inputGPUBuffer && !internalInput)
+  {
+    VkCommon::IdentifyInput(vkParameters, input);
+  }
+  vkParameters.inputGPUBuffer = inputGPUBuffer;
+  vkParameters.kernelCPUBuffer = kernelCPUBuffer;
+  vkParameters.kernelBufferBytes = kernelRegion.GetNumberOfPixels() * sizeof(RealType);
+  vkParameters.kernelGPUBuffer = kernelGPUBuffer;
+  VkCommon::IdentifyKernel(vkParameters, kernel);
+  vkParameters.kernelScale = kernelScale;
+  vkParameters.outputCPUBuffer = outputCPUBuffer;
+  vkParameters.outputBufferBytes = outputRegion.GetNumberOfPixels() * sizeof(RealType);
+  if (deviceOutput)
+  {
+    vkParameters.outputGPUBuffer = &outputGPUBuffer;
+  }
+
+  const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
+  if (resFFT != VKFFT_SUCCESS)
+  {
+    std::ostringstream mesg;
+    mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
+    itkAssertOrThrowMacro(false, mesg.str());
+  }
+  if (deviceOutput)
+  {
+    VkImageDeviceBuffer<OutputImageType>::SetOutputBuffer(output, outputGPUBuffer);
+  }
+  if (internalOutput)
+  {
+    ImageAlgorithm::Copy(internalOutput.GetPointer(), output, outputRegion, outputRegion);
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "VkBoundaryCondition: " << this->GetVkBoundaryCondition() << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkFFTConvolutionImageFilter_hxx
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTConvolutionImageFilterFactory_h
+#define itkVkFFTConvolutionImageFilterFactory_h
+#include "VkFFTBackendExport.h"
+
+#include "itkVkFFTConvolutionImageFilter.h"
+#include "itkImage.h"
+#include "itkObjectFactoryBase.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+/** \class VkFFTConvolutionImageFilterFactory
+ *
+ * \brief Object Factory implementation for overriding
+ *  FFTConvolutionImageFilter with VkFFTConvolutionImageFilter
+ *
+ * \sa ObjectFactoryBase
+ * \sa FFTConvolutionImageFilter
+ * \sa VkFFTConvolutionImageFilter
+ *
+ * \ingroup VkFFTBackend
+ * \ingroup ITKConvolution
+ * \ingroup FourierTransform
+ */
+class VkFFTConvolutionImageFilterFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTConvolutionImageFilterFactory);
+
+  using Self = VkFFTConvolutionImageFilterFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "A VkFFTConvolutionImageFilterFactory factory";
+  }
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTConvolutionImageFilterFactory, itk::ObjectFactoryBase);
+
+  /** Register one factory of this type  */
+  static void
+  RegisterOneFactory()
+  {
+    VkFFTConvolutionImageFilterFactory::Pointer factory = VkFFTConvolutionImageFilterFactory::New();
+
+    ObjectFactoryBase::RegisterFactoryInternal(factory);
+  }
+
+protected:
+  /** Override base FFTConvolutionImageFilter constructor at runtime to return
+   *  an upcast VkFFTConvolutionImageFilter instance through the object factory
+   */
+  template <typename PixelType, typename InternalPrecisionType, unsigned int D, unsigned int... ImageDimensions>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int, D, ImageDimensions...> &)
+  {
+    using ImageType = Image<PixelType, D>;
+    using VkFilterType = VkFFTConvolutionImageFilter<ImageType, ImageType, ImageType, InternalPrecisionType>;
+    this->RegisterOverride(typeid(typename VkFilterType::Superclass).name(),
+                           typeid(VkFilterType).name(),
+                           "VkFFTConvolutionImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkFilterType>::New());
+    OverrideSuperclassType<PixelType, InternalPrecisionType>(std::integer_sequence<unsigned int, ImageDimensions...>{});
+  }
+  template <typename PixelType, typename InternalPrecisionType>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int> &)
+  {}
+
+  VkFFTConvolutionImageFilterFactory()
+  {
+    OverrideSuperclassType<float, double>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+    OverrideSuperclassType<float, float>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+
+    OverrideSuperclassType<double, double>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+    OverrideSuperclassType<double, float>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+  }
+};
+
+} // namespace itk
+
+#endif // itkVkFFTConvolutionImageFilterFactory_h
@@ -0,0 +1,209 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTDiscreteGaussianImageFilter_h
+#define itkVkFFTDiscreteGaussianImageFilter_h
+
+#include "itkFFTDiscreteGaussianImageFilter.h"
+#include "itkImage.h"
+#include "itkVkCommon.h"
+#include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
+
+namespace itk
+{
+/**
+ *\class VkFFTDiscreteGaussianImageFilter
+ *
+ * \brief Vk-based Gaussian smoothing with an analytic transfer function.
+ *
+ * FFTDiscreteGaussianImageFilter generates a kernel image, pads and
+ * transforms it before it convolves the input with it. This filter instead
+ * evaluates the transfer function of the discrete Gaussian on the device, in
+ * the half spectrum of the padded input, so that smoothing costs one forward
+ * and one inverse transform and neither a kernel image nor its transform is
+ * computed or uploaded.
+ *
+ * The transfer function is that of the kernel of GaussianOperator without
+ * truncation, exp(v * (cos(w) - 1)) along each dimension for the variance v in
+ * pixels, which takes the image spacing into account if UseImageSpacing is on.
+ * Dimensions beyond FilterDimensionality are not smoothed. MaximumError and
+ * MaximumKernelWidth only determine the radius by which the input is padded.
+ *
+ * With ShrinkFactors other than 1, the output is the smoothed input shrunk
+ * as ShrinkImageFilter shrinks it. The aliases of the smoothed spectrum are
+ * summed into the spectrum of the shrunk domain, so that only that is
+ * transformed back and the smoothed input at full resolution is never
+ * computed. Shrinking requires a boundary condition generated on the device.
+ *
+ * The device computes in single precision for float output pixels and in
+ * double precision otherwise. Inputs of unsigned char, short and unsigned
+ * short pixels are uploaded as they are and converted on the device. Other
+ * pixel types are converted on the host.
+ *
+ * \ingroup FourierTransform
+ * \ingroup ITKSmoothing
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkCommon::GetBoundaryCondition
+ * \sa VkGlobalConfiguration
+ * \sa FFTDiscreteGaussianImageFilter
+ * \sa GaussianOperator
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class VkFFTDiscreteGaussianImageFilter : public FFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTDiscreteGaussianImageFilter);
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  static_assert(TInputImage::ImageDimension >= 1 && TInputImage::ImageDimension <= 3, "Unsupported image dimension");
+
+  /** Standard class type aliases. */
+  using Self = VkFFTDiscreteGaussianImageFilter;
+  using Superclass = FFTDiscreteGaussianImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using RealType = typename std::conditional<std::is_same<OutputPixelType, float>::value, float, double>::type;
+  using SizeType = typename InputImageType::SizeType;
+  using SizeValueType = typename InputImageType::SizeValueType;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using BoundaryConditionEnum = VkCommon::BoundaryConditionEnum;
+  using ShrinkFactorsType = FixedArray<unsigned int, TInputImage::ImageDimension>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTDiscreteGaussianImageFilter, FFTDiscreteGaussianImageFilter);
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in filters constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current filter settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+  /** Boundary condition that the device generates for the input boundary condition
+   *  of the filter, or NONE if it cannot generate it. */
+  BoundaryConditionEnum
+  GetVkBoundaryCondition() const;
+
+  /** Boundary condition that the device generates for the given boundary condition of
+   *  the input, or NONE if it cannot generate it. */
+  static BoundaryConditionEnum
+  GetVkBoundaryCondition(const ImageBoundaryCondition<InputImageType> * boundaryCondition);
+
+  /** Lower bound of the radius by which the input is padded along each dimension.
+   *  Smoothings of the same input with different variances pad it into the same
+   *  domain when this covers the largest of their kernel radii. */
+  itkSetMacro(MinimumPadRadius, SizeType);
+  itkGetConstReferenceMacro(MinimumPadRadius, SizeType);
+
+  /** The padded size along each dimension is a multiple of this and of the shrink factor.
+   *  Smoothings with different shrink factors pad the input into the same domain when
+   *  this is a common multiple of their factors. */
+  itkSetMacro(PadMultiple, SizeType);
+  itkGetConstReferenceMacro(PadMultiple, SizeType);
+
+  /** Factors by which the smoothed input is shrunk along each dimension, as
+   *  ShrinkImageFilter shrinks it. Defaults to 1. */
+  itkSetMacro(ShrinkFactors, ShrinkFactorsType);
+  itkGetConstReferenceMacro(ShrinkFactors, ShrinkFactorsType);
+
+  /** Keep the spectrum of the padded input on the device after an update, so that later
+   *  updates with other variances only apply their transfer function and the inverse
+   *  transform while the input and its padded domain are unchanged. The largest possible
+   *  region of the input is requested, and only inputs that are read from the host without
+   *  conversion are shared. Off by default. */
+  itkSetMacro(ShareInputSpectrum, bool);
+  itkGetConstMacro(ShareInputSpectrum, bool);
+  itkBooleanMacro(ShareInputSpectrum);
+
+  /** Release the spectrum of the input kept on the device for sharing. */
+  void
+  ReleaseInputSpectrum()
+  {
+    m_VkCommon.ReleaseInputSpectrum();
+  }
+
+protected:
+  VkFFTDiscreteGaussianImageFilter();
+  ~VkFFTDiscreteGaussianImageFilter() override = default;
+
+  void
+  GenerateOutputInformation() override;
+
+  void
+  GenerateInputRequestedRegion() override;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool              m_UseVkGlobalConfiguration{ true };
+  uint64_t          m_DeviceID{ 0UL };
+  SizeType          m_MinimumPadRadius;
+  SizeType          m_PadMultiple;
+  ShrinkFactorsType m_ShrinkFactors;
+  bool              m_ShareInputSpectrum{ false };
+
+  bool
+  IsShrinking() const
+  {
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      if (m_ShrinkFactors[dim] != 1)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  VkCommon m_VkCommon{};
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkFFTDiscreteGaussianImageFilter.hxx"
+#endif
+
+#endif // itkVkFFTDiscreteGaussianImageFilter_h
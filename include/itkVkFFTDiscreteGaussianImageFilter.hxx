@@ -0,0 +1,332 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTDiscreteGaussianImageFilter_hxx
+#define itkVkFFTDiscreteGaussianImageFilter_hxx
+
+#include "itkVkFFTDiscreteGaussianImageFilter.h"
+#include "itkGaussianOperator.h"
+#include "itkImageAlgorithm.h"
+#include "itkMath.h"
+#include "itkProgressReporter.h"
+#include "itkShrinkImageFilter.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+VkFFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::VkFFTDiscreteGaussianImageFilter()
+{
+  m_MinimumPadRadius.Fill(0);
+  m_PadMultiple.Fill(1);
+  m_ShrinkFactors.Fill(1);
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+VkFFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GetVkBoundaryCondition() const -> BoundaryConditionEnum
+{
+  return GetVkBoundaryCondition(this->GetInputBoundaryCondition());
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+VkFFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GetVkBoundaryCondition(
+  const ImageBoundaryCondition<InputImageType> * boundaryCondition) -> BoundaryConditionEnum
+{
+  return VkCommon::GetBoundaryCondition(boundaryCondition);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkFFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (!this->IsShrinking())
+  {
+    return;
+  }
+
+  // The output has the geometry of the output of ShrinkImageFilter
+  using ShrinkerType = ShrinkImageFilter<InputImageType, OutputImageType>;
+  auto shrinker = ShrinkerType::New();
+  shrinker->SetInput(this->GetInput());
+  shrinker->SetShrinkFactors(m_ShrinkFactors);
+  shrinker->UpdateOutputInformation();
+  const OutputImageType * const shrunk{ shrinker->GetOutput() };
+  OutputImageType * const       output{ this->GetOutput() };
+  output->SetLargestPossibleRegion(shrunk->GetLargestPossibleRegion());
+  output->SetSpacing(shrunk->GetSpacing());
+  output->SetOrigin(shrunk->GetOrigin());
+  output->SetDirection(shrunk->GetDirection());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkFFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  if (!m_ShareInputSpectrum && !this->IsShrinking())
+  {
+    Superclass::GenerateInputRequestedRegion();
+    return;
+  }
+
+  // A shared spectrum is computed from, and padded around, the whole input, and so is a shrunk
+  // output, whose region is not one of the input
+  auto * const input{ const_cast<InputImageType *>(this->GetInput()) };
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkFFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const BoundaryConditionEnum boundaryCondition{ this->GetVkBoundaryCondition() };
+  if (boundaryCondition == BoundaryConditionEnum::NONE)
+  {
+    if (this->IsShrinking())
+    {
+      itkExceptionMacro("Shrinking requires a boundary condition that the device generates.");
+    }
+    Superclass::GenerateData();
+    return;
+  }
+
+  // get pointers to the input and the output
+  const InputImageType * const input{ this->GetInput() };
+  OutputImageType * const      output{ this->GetOutput() };
+  if (!input || !output)
+  {
+    return;
+  }
+
+  // we don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process
+  const ProgressReporter progress(this, 0, 1);
+
+  // allocate output buffer memory
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+
+  // The variance of the Gaussian in pixels along each dimension, and the radius of the kernel
+  // that GaussianOperator would generate for it, by which the buffered input is padded unless
+  // MinimumPadRadius is larger. The padded size is a multiple of PadMultiple and of the shrink
+  // factor, whose quotient has small prime factors.
+  const InputImageRegionType &  inputRegion{ input->GetBufferedRegion() };
+  const OutputImageRegionType & outputRegion{ output->GetRequestedRegion() };
+  double                        variance[ImageDimension];
+  SizeType                      padSize;
+  SizeType                      padLowerBound;
+  const SizeValueType           greatestPrimeFactor{ m_VkCommon.GetGreatestPrimeFactor() };
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    variance[dim] = 0.0;
+    SizeValueType radius{ 0 };
+    if (dim < this->GetFilterDimensionality() && this->GetVariance()[dim] > 0.0)
+    {
+      variance[dim] = this->GetVariance()[dim];
+      if (this->GetUseImageSpacing())
+      {
+        variance[dim] /= Math::sqr(input->GetSpacing()[dim]);
+      }
+      GaussianOperator<RealType, ImageDimension> oper;
+      oper.SetDirection(dim);
+      oper.SetVariance(variance[dim]);
+      oper.SetMaximumError(this->GetMaximumError()[dim]);
+      oper.SetMaximumKernelWidth(this->GetMaximumKernelWidth());
+      oper.CreateDirectional();
+      radius = oper.GetRadius(dim);
+    }
+    radius = std::max(radius, m_MinimumPadRadius[dim]);
+    SizeValueType multiple{ std::max<SizeValueType>(m_PadMultiple[dim], 1) };
+    while (multiple % m_ShrinkFactors[dim] != 0)
+    {
+      multiple += std::max<SizeValueType>(m_PadMultiple[dim], 1);
+    }
+    if (Math::GreatestPrimeFactor(multiple) > greatestPrimeFactor)
+    {
+      itkExceptionMacro("Shrink factor " << m_ShrinkFactors[dim] << " and pad multiple " << m_PadMultiple[dim]
+                                         << " have prime factors greater than " << greatestPrimeFactor << ".");
+    }
+    SizeValueType size{ (inputRegion.GetSize(dim) + 2 * radius + multiple - 1) / multiple };
+    while (Math::GreatestPrimeFactor(size) > greatestPrimeFactor)
+    {
+      ++size;
+    }
+    padSize[dim] = size * multiple;
+    padLowerBound[dim] = radius;
+  }
+
+  // VkFFT computes in the internal precision. Inputs of the integer pixel types that the device
+  // converts are uploaded as they are, and other pixel types are converted on the host. Images of
+  // the internal precision are read from and left on the device where they can be.
+  using InternalImageType = Image<RealType, ImageDimension>;
+  constexpr VkCommon::InputPixelEnum inputPixelType{ VkCommon::GetInputPixelType<InputPixelType>() };
+  constexpr bool                     convertInput{ !std::is_same<InputPixelType, RealType>::value &&
+                                   inputPixelType == VkCommon::InputPixelEnum::REAL };
+  constexpr bool convertOutput{ !std::is_same<OutputPixelType, RealType>::value };
+
+  const VkCommon::DeviceBufferPointer inputGPUBuffer{
+    convertInput ? nullptr : VkImageDeviceBuffer<InputImageType>::GetInputBuffer(input, this->GetDeviceID())
+  };
+  typename InternalImageType::Pointer internalInput;
+  const void *                        inputCPUBuffer{ nullptr };
+  if (!inputGPUBuffer)
+  {
+    if (convertInput)
+    {
+      internalInput = InternalImageType::New();
+      internalInput->SetRegions(inputRegion);
+      internalInput->Allocate();
+      ImageAlgorithm::Copy(input, internalInput.GetPointer(), inputRegion, inputRegion);
+      inputCPUBuffer = internalInput->GetBufferPointer();
+    }
+    else
+    {
+      inputCPUBuffer = input->GetBufferPointer();
+    }
+  }
+
+  VkCommon::DeviceBufferPointer outputGPUBuffer;
+  const bool                    deviceOutput{ !convertOutput && VkImageDeviceBuffer<OutputImageType>::GetOutputBuffer(
+                                                 output, this->GetDeviceID(), outputGPUBuffer) };
+  typename InternalImageType::Pointer internalOutput;
+  void *                              outputCPUBuffer{ nullptr };
+  if (convertOutput)
+  {
+    internalOutput = InternalImageType::New();
+    internalOutput->SetRegions(outputRegion);
+    internalOutput->Allocate();
+    outputCPUBuffer = internalOutput->GetBufferPointer();
+  }
+  else
+  {
+    outputCPUBuffer = output->GetBufferPointer();
+  }
+  itkAssertOrThrowMacro(inputCPUBuffer != nullptr || inputGPUBuffer, "No input buffer");
+  itkAssertOrThrowMacro(outputCPUBuffer != nullptr, "No CPU output buffer");
+
+  // Mostly use defaults for VkCommon::VkGPU
+  typename VkCommon::VkGPU vkGPU;
+  vkGPU.device_id = this->GetDeviceID();
+
+  // Describe this filter in VkCommon::VkParameters
+  typename VkCommon::VkParameters vkParameters;
+  if (ImageDimension > 0)
+    vkParameters.X = padSize[0];
+  if (ImageDimension > 1)
+    vkParameters.Y = padSize[1];
+  if (ImageDimension > 2)
+    vkParameters.Z = padSize[2];
+  if (std::is_same<RealType, float>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::FLOAT;
+  else if (std::is_same<RealType, double>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::DOUBLE;
+  else
+    itkAssertOrThrowMacro(false, "Unsupported type for real numbers.");
+  vkParameters.fft = VkCommon::FFTEnum::R2HalfH;
+  vkParameters.PSize = sizeof(RealType);
+  vkParameters.I = VkCommon::DirectionEnum::FORWARD;
+  vkParameters.normalized = VkCommon::NormalizationEnum::NORMALIZED;
+  vkParameters.performGaussianSmoothing = 1;
+  vkParameters.keepInputSpectrum = m_ShareInputSpectrum ? 1 : 0;
+  vkParameters.boundaryCondition = boundaryCondition;
+
+  // The output samples the input at the output index times the shrink factor plus the offset
+  // that ShrinkImageFilter computes
+  typename InputImageType::IndexType sampleOffset;
+  sampleOffset.Fill(0);
+  if (this->IsShrinking())
+  {
+    const typename OutputImageType::IndexType & outputIndex{ output->GetLargestPossibleRegion().GetIndex() };
+    typename OutputImageType::PointType         point;
+    output->TransformIndexToPhysicalPoint(outputIndex, point);
+    const typename InputImageType::IndexType inputIndex{ input->TransformPhysicalPointToIndex(point) };
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      sampleOffset[dim] = std::max<IndexValueType>(0, inputIndex[dim] - outputIndex[dim] * m_ShrinkFactors[dim]);
+    }
+  }
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    vkParameters.gaussianVariance[dim] = variance[dim];
+    vkParameters.gaussianShrinkFactor[dim] = m_ShrinkFactors[dim];
+    vkParameters.padInputSize[dim] = inputRegion.GetSize(dim);
+    vkParameters.padLowerBound[dim] = padLowerBound[dim];
+    vkParameters.cropSize[dim] = outputRegion.GetSize(dim);
+    vkParameters.cropLowerBound[dim] = static_cast<uint64_t>(
+      static_cast<IndexValueType>(padLowerBound[dim]) + outputRegion.GetIndex(dim) * m_ShrinkFactors[dim] +
+      sampleOffset[dim] - inputRegion.GetIndex(dim));
+  }
+
+  vkParameters.inputCPUBuffer = inputCPUBuffer;
+  vkParameters.inputPixelType = inputPixelType;
+  vkParameters.inputBufferBytes =
+    inputRegion.GetNumberOfPixels() * (convertInput ? sizeof(RealType) : sizeof(InputPixelType));
+  if (!inputGPUBuffer && !internalInput)
+  {
+    VkCommon::IdentifyInput(vkParameters, input);
+  }
+  vkParameters.inputGPUBuffer = inputGPUBuffer;
+  vkParameters.outputCPUBuffer = outputCPUBuffer;
+  vkParameters.outputBufferBytes = outputRegion.GetNumberOfPixels() * sizeof(RealType);
+  if (deviceOutput)
+  {
+    vkParameters.outputGPUBuffer = &outputGPUBuffer;
+  }
+
+  const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
+  if (resFFT != VKFFT_SUCCESS)
+  {
+    std::ostringstream mesg;
+    mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
+    itkAssertOrThrowMacro(false, mesg.str());
+  }
+  if (deviceOutput)
+  {
+    VkImageDeviceBuffer<OutputImageType>::SetOutputBuffer(output, outputGPUBuffer);
+  }
+  if (internalOutput)
+  {
+    ImageAlgorithm::Copy(internalOutput.GetPointer(), output, outputRegion, outputRegion);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkFFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "VkBoundaryCondition: " << this->GetVkBoundaryCondition() << std::endl;
+  os << indent << "MinimumPadRadius: " << m_MinimumPadRadius << std::endl;
+  os << indent << "PadMultiple: " << m_PadMultiple << std::endl;
+  os << indent << "ShrinkFactors: " << m_ShrinkFactors << std::endl;
+  os << indent << "ShareInputSpectrum: " << m_ShareInputSpectrum << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkFFTDiscreteGaussianImageFilter_hxx
@@ -0,0 +1,110 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTDiscreteGaussianImageFilterFactory_h
+#define itkVkFFTDiscreteGaussianImageFilterFactory_h
+#include "VkFFTBackendExport.h"
+
+#include "itkVkFFTDiscreteGaussianImageFilter.h"
+#include "itkImage.h"
+#include "itkObjectFactoryBase.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+/** \class VkFFTDiscreteGaussianImageFilterFactory
+ *
+ * \brief Object Factory implementation for overriding
+ *  FFTDiscreteGaussianImageFilter with VkFFTDiscreteGaussianImageFilter
+ *
+ * \sa ObjectFactoryBase
+ * \sa FFTDiscreteGaussianImageFilter
+ * \sa VkFFTDiscreteGaussianImageFilter
+ *
+ * \ingroup VkFFTBackend
+ * \ingroup ITKSmoothing
+ * \ingroup FourierTransform
+ */
+class VkFFTDiscreteGaussianImageFilterFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTDiscreteGaussianImageFilterFactory);
+
+  using Self = VkFFTDiscreteGaussianImageFilterFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "A VkFFTDiscreteGaussianImageFilterFactory factory";
+  }
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTDiscreteGaussianImageFilterFactory, itk::ObjectFactoryBase);
+
+  /** Register one factory of this type  */
+  static void
+  RegisterOneFactory()
+  {
+    VkFFTDiscreteGaussianImageFilterFactory::Pointer factory = VkFFTDiscreteGaussianImageFilterFactory::New();
+
+    ObjectFactoryBase::RegisterFactoryInternal(factory);
+  }
+
+protected:
+  /** Override base FFTDiscreteGaussianImageFilter constructor at runtime to return
+   *  an upcast VkFFTDiscreteGaussianImageFilter instance through the object factory
+   */
+  template <typename PixelType, unsigned int D, unsigned int... ImageDimensions>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int, D, ImageDimensions...> &)
+  {
+    using ImageType = Image<PixelType, D>;
+    using VkFilterType = VkFFTDiscreteGaussianImageFilter<ImageType, ImageType>;
+    this->RegisterOverride(typeid(typename VkFilterType::Superclass).name(),
+                           typeid(VkFilterType).name(),
+                           "VkFFTDiscreteGaussianImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkFilterType>::New());
+    OverrideSuperclassType<PixelType>(std::integer_sequence<unsigned int, ImageDimensions...>{});
+  }
+  template <typename PixelType>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int> &)
+  {}
+
+  VkFFTDiscreteGaussianImageFilterFactory()
+  {
+    OverrideSuperclassType<float>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+    OverrideSuperclassType<double>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+  }
+};
+
+} // namespace itk
+
+#endif // itkVkFFTDiscreteGaussianImageFilterFactory_h
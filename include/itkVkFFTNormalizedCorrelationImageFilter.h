@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTNormalizedCorrelationImageFilter_h
+#define itkVkFFTNormalizedCorrelationImageFilter_h
+
+#include "itkFFTNormalizedCorrelationImageFilter.h"
+#include "itkVkMaskedFFTNormalizedCorrelationImageFilter.h"
+
+namespace itk
+{
+/**
+ *\class VkFFTNormalizedCorrelationImageFilter
+ *
+ * \brief Vk-based normalized cross-correlation of two images.
+ *
+ * This filter computes the same normalized cross-correlation as
+ * FFTNormalizedCorrelationImageFilter entirely on the device, through a
+ * VkMaskedFFTNormalizedCorrelationImageFilter without masks.
+ *
+ * \ingroup FourierTransform
+ * \ingroup ITKConvolution
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkGlobalConfiguration
+ * \sa FFTNormalizedCorrelationImageFilter
+ * \sa VkMaskedFFTNormalizedCorrelationImageFilter
+ */
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TMaskImage = Image<unsigned char, TInputImage::ImageDimension>>
+class VkFFTNormalizedCorrelationImageFilter
+  : public FFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTNormalizedCorrelationImageFilter);
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using MaskImageType = TMaskImage;
+
+  /** Standard class type aliases. */
+  using Self = VkFFTNormalizedCorrelationImageFilter;
+  using Superclass = FFTNormalizedCorrelationImageFilter<InputImageType, OutputImageType, MaskImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using MaskedFilterType = VkMaskedFFTNormalizedCorrelationImageFilter<InputImageType, OutputImageType, MaskImageType>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTNormalizedCorrelationImageFilter, FFTNormalizedCorrelationImageFilter);
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in filters constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current filter settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+protected:
+  VkFFTNormalizedCorrelationImageFilter() = default;
+  ~VkFFTNormalizedCorrelationImageFilter() override = default;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool     m_UseVkGlobalConfiguration{ true };
+  uint64_t m_DeviceID{ 0UL };
+
+  // Computes the correlation, keeping its device context between updates
+  typename MaskedFilterType::Pointer m_MaskedFilter{ MaskedFilterType::New() };
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkFFTNormalizedCorrelationImageFilter.hxx"
+#endif
+
+#endif // itkVkFFTNormalizedCorrelationImageFilter_h
@@ -0,0 +1,56 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTNormalizedCorrelationImageFilter_hxx
+#define itkVkFFTNormalizedCorrelationImageFilter_hxx
+
+#include "itkVkFFTNormalizedCorrelationImageFilter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+VkFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateData()
+{
+  // Run the masked correlation without masks on the inputs of this filter, into its output
+  m_MaskedFilter->SetFixedImage(this->GetFixedImage());
+  m_MaskedFilter->SetMovingImage(this->GetMovingImage());
+  m_MaskedFilter->SetRequiredNumberOfOverlappingPixels(this->GetRequiredNumberOfOverlappingPixels());
+  m_MaskedFilter->SetRequiredFractionOfOverlappingPixels(this->GetRequiredFractionOfOverlappingPixels());
+  m_MaskedFilter->SetUseVkGlobalConfiguration(false);
+  m_MaskedFilter->SetDeviceID(this->GetDeviceID());
+  m_MaskedFilter->GraftOutput(this->GetOutput());
+  m_MaskedFilter->Update();
+  this->GraftOutput(m_MaskedFilter->GetOutput());
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+VkFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::PrintSelf(std::ostream & os,
+                                                                                          Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkFFTNormalizedCorrelationImageFilter_hxx
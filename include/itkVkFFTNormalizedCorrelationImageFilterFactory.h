@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTNormalizedCorrelationImageFilterFactory_h
+#define itkVkFFTNormalizedCorrelationImageFilterFactory_h
+#include "VkFFTBackendExport.h"
+
+#include "itkVkFFTNormalizedCorrelationImageFilter.h"
+#include "itkVkMaskedFFTNormalizedCorrelationImageFilter.h"
+#include "itkImage.h"
+#include "itkObjectFactoryBase.h"
+#include "itkVersion.h"
+
+namespace itk
+{
+/** \class VkFFTNormalizedCorrelationImageFilterFactory
+ *
+ * \brief Object Factory implementation for overriding
+ *  FFTNormalizedCorrelationImageFilter with VkFFTNormalizedCorrelationImageFilter
+ *  and MaskedFFTNormalizedCorrelationImageFilter with
+ *  VkMaskedFFTNormalizedCorrelationImageFilter
+ *
+ * \sa ObjectFactoryBase
+ * \sa FFTNormalizedCorrelationImageFilter
+ * \sa MaskedFFTNormalizedCorrelationImageFilter
+ * \sa VkFFTNormalizedCorrelationImageFilter
+ * \sa VkMaskedFFTNormalizedCorrelationImageFilter
+ *
+ * \ingroup VkFFTBackend
+ * \ingroup ITKConvolution
+ * \ingroup FourierTransform
+ */
+class VkFFTNormalizedCorrelationImageFilterFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTNormalizedCorrelationImageFilterFactory);
+
+  using Self = VkFFTNormalizedCorrelationImageFilterFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "A VkFFTNormalizedCorrelationImageFilterFactory factory";
+  }
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTNormalizedCorrelationImageFilterFactory, itk::ObjectFactoryBase);
+
+  /** Register one factory of this type  */
+  static void
+  RegisterOneFactory()
+  {
+    VkFFTNormalizedCorrelationImageFilterFactory::Pointer factory = VkFFTNormalizedCorrelationImageFilterFactory::New();
+
+    ObjectFactoryBase::RegisterFactoryInternal(factory);
+  }
+
+protected:
+  /** Override base FFTNormalizedCorrelationImageFilter and
+   *  MaskedFFTNormalizedCorrelationImageFilter constructors at runtime to return
+   *  upcast Vk instances through the object factory
+   */
+  template <typename PixelType, unsigned int D, unsigned int... ImageDimensions>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int, D, ImageDimensions...> &)
+  {
+    using ImageType = Image<PixelType, D>;
+    using VkFilterType = VkFFTNormalizedCorrelationImageFilter<ImageType, ImageType>;
+    this->RegisterOverride(typeid(typename VkFilterType::Superclass).name(),
+                           typeid(VkFilterType).name(),
+                           "VkFFTNormalizedCorrelationImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkFilterType>::New());
+    using VkMaskedFilterType = VkMaskedFFTNormalizedCorrelationImageFilter<ImageType, ImageType>;
+    this->RegisterOverride(typeid(typename VkMaskedFilterType::Superclass).name(),
+                           typeid(VkMaskedFilterType).name(),
+                           "VkMaskedFFTNormalizedCorrelationImageFilter Override",
+                           true,
+                           CreateObjectFunction<VkMaskedFilterType>::New());
+    OverrideSuperclassType<PixelType>(std::integer_sequence<unsigned int, ImageDimensions...>{});
+  }
+  template <typename PixelType>
+  void
+  OverrideSuperclassType(const std::integer_sequence<unsigned int> &)
+  {}
+
+  VkFFTNormalizedCorrelationImageFilterFactory()
+  {
+    OverrideSuperclassType<float>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+    OverrideSuperclassType<double>(std::integer_sequence<unsigned int, 3, 2, 1>{});
+  }
+};
+
+} // namespace itk
+
+#endif // itkVkFFTNormalizedCorrelationImageFilterFactory_h
@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTPhaseCorrelationCalculator_h
+#define itkVkFFTPhaseCorrelationCalculator_h
+
+#include "itkImage.h"
+#include "itkObject.h"
+#include "itkVector.h"
+#include "itkVkCommon.h"
+#include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
+
+namespace itk
+{
+/**
+ *\class VkFFTPhaseCorrelationCalculator
+ *
+ * \brief Vk-based estimation of the translation between two images by phase correlation.
+ *
+ * Compute() estimates the shift by which the content of the moving image
+ * lies beyond that of the fixed image, in pixels,
+ *
+ *   moving(x) ~ fixed(x - shift),
+ *
+ * from the peak of the inverse transform of the normalized cross-power
+ * spectrum of the images. Both images are padded according to the boundary
+ * condition, zeros by default, to a size that VkFFT transforms, and
+ * transformed with the same plan. The normalization of the cross-power
+ * spectrum, its inverse transform, the peak search and the refinement of the
+ * peak to a subpixel position by a parabola along each dimension run on the
+ * device, so that only the shift and the peak value are downloaded.
+ *
+ * Shifts are wrapped into [-size / 2, size / 2) of the padded domain. Both
+ * images are of the same size, and only their pixel grids are considered.
+ *
+ * Pixels other than TInternalPrecision are converted on the host.
+ *
+ * \ingroup FourierTransform
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkGlobalConfiguration
+ * \sa VkFFTTemplateMatchingImageFilter
+ */
+template <typename TImage, typename TInternalPrecision = double>
+class VkFFTPhaseCorrelationCalculator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTPhaseCorrelationCalculator);
+
+  using ImageType = TImage;
+  static_assert(std::is_same<TInternalPrecision, float>::value || std::is_same<TInternalPrecision, double>::value,
+                "Unsupported internal precision");
+  static_assert(TImage::ImageDimension >= 1 && TImage::ImageDimension <= 3, "Unsupported image dimension");
+
+  /** Standard class type aliases. */
+  using Self = VkFFTPhaseCorrelationCalculator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using PixelType = typename ImageType::PixelType;
+  using RealType = TInternalPrecision;
+  using SizeType = typename ImageType::SizeType;
+  using SizeValueType = typename ImageType::SizeValueType;
+  using RegionType = typename ImageType::RegionType;
+  using BoundaryConditionEnum = VkCommon::BoundaryConditionEnum;
+
+  static constexpr unsigned int ImageDimension{ ImageType::ImageDimension };
+
+  using ShiftType = Vector<double, ImageDimension>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTPhaseCorrelationCalculator, Object);
+
+  /** The images whose translation is estimated */
+  itkSetConstObjectMacro(FixedImage, ImageType);
+  itkGetConstObjectMacro(FixedImage, ImageType);
+  itkSetConstObjectMacro(MovingImage, ImageType);
+  itkGetConstObjectMacro(MovingImage, ImageType);
+
+  /** How the images are padded to the transform size. Defaults to ZERO; NONE is not
+   *  supported. */
+  itkSetEnumMacro(BoundaryCondition, BoundaryConditionEnum);
+  itkGetConstMacro(BoundaryCondition, BoundaryConditionEnum);
+
+  /** Estimate the shift between the images. */
+  void
+  Compute();
+
+  /** Shift of the moving image with respect to the fixed image, in pixels, from the last
+   *  Compute() */
+  itkGetConstReferenceMacro(Shift, ShiftType);
+
+  /** Height of the phase correlation peak, at most one, from the last Compute() */
+  itkGetConstMacro(PeakValue, double);
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in objects constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+protected:
+  VkFFTPhaseCorrelationCalculator() = default;
+  ~VkFFTPhaseCorrelationCalculator() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  typename ImageType::ConstPointer m_FixedImage{};
+  typename ImageType::ConstPointer m_MovingImage{};
+  BoundaryConditionEnum            m_BoundaryCondition{ BoundaryConditionEnum::ZERO };
+
+  ShiftType m_Shift{};
+  double    m_PeakValue{ 0.0 };
+
+  bool     m_UseVkGlobalConfiguration{ true };
+  uint64_t m_DeviceID{ 0UL };
+
+  VkCommon m_VkCommon{};
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkFFTPhaseCorrelationCalculator.hxx"
+#endif
+
+#endif // itkVkFFTPhaseCorrelationCalculator_h
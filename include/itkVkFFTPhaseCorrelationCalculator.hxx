@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTPhaseCorrelationCalculator_hxx
+#define itkVkFFTPhaseCorrelationCalculator_hxx
+
+#include "itkVkFFTPhaseCorrelationCalculator.h"
+#include "itkImageAlgorithm.h"
+#include "itkMath.h"
+
+namespace itk
+{
+
+template <typename TImage, typename TInternalPrecision>
+void
+VkFFTPhaseCorrelationCalculator<TImage, TInternalPrecision>::Compute()
+{
+  itkAssertOrThrowMacro(m_FixedImage && m_MovingImage, "Fixed or moving image is not set");
+  itkAssertOrThrowMacro(m_BoundaryCondition != BoundaryConditionEnum::NONE, "Images must be padded");
+  const RegionType & fixedRegion{ m_FixedImage->GetBufferedRegion() };
+  const RegionType & movingRegion{ m_MovingImage->GetBufferedRegion() };
+  itkAssertOrThrowMacro(fixedRegion.GetSize() == movingRegion.GetSize(), "Images are of different sizes");
+
+  // Pad the images to a size that VkFFT transforms
+  SizeType padSize;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    SizeValueType size{ fixedRegion.GetSize(dim) };
+    while (Math::GreatestPrimeFactor(size) > m_VkCommon.GetGreatestPrimeFactor())
+    {
+      ++size;
+    }
+    padSize[dim] = size;
+  }
+
+  // VkFFT computes in the internal precision, to which other pixel types are converted on the host.
+  // Images of the internal precision are read from the device where they can be.
+  using InternalImageType = Image<RealType, ImageDimension>;
+  constexpr bool convertImages{ !std::is_same<PixelType, RealType>::value };
+  const auto     toInternal = [](const ImageType * image) {
+    typename InternalImageType::Pointer internalImage{ InternalImageType::New() };
+    internalImage->SetRegions(image->GetBufferedRegion());
+    internalImage->Allocate();
+    ImageAlgorithm::Copy(image, internalImage.GetPointer(), image->GetBufferedRegion(), image->GetBufferedRegion());
+    return internalImage;
+  };
+
+  const VkCommon::DeviceBufferPointer fixedGPUBuffer{
+    convertImages ? nullptr : VkImageDeviceBuffer<ImageType>::GetInputBuffer(m_FixedImage, this->GetDeviceID())
+  };
+  const VkCommon::DeviceBufferPointer movingGPUBuffer{
+    convertImages ? nullptr : VkImageDeviceBuffer<ImageType>::GetInputBuffer(m_MovingImage, this->GetDeviceID())
+  };
+  typename InternalImageType::Pointer internalFixed;
+  typename InternalImageType::Pointer internalMoving;
+  const void *                        fixedCPUBuffer{ nullptr };
+  const void *                        movingCPUBuffer{ nullptr };
+  if (!fixedGPUBuffer)
+  {
+    if (convertImages)
+    {
+      internalFixed = toInternal(m_FixedImage);
+      fixedCPUBuffer = internalFixed->GetBufferPointer();
+    }
+    else
+    {
+      fixedCPUBuffer = m_FixedImage->GetBufferPointer();
+    }
+  }
+  if (!movingGPUBuffer)
+  {
+    if (convertImages)
+    {
+      internalMoving = toInternal(m_MovingImage);
+      movingCPUBuffer = internalMoving->GetBufferPointer();
+    }
+    else
+    {
+      movingCPUBuffer = m_MovingImage->GetBufferPointer();
+    }
+  }
+
+  // Mostly use defaults for VkCommon::VkGPU
+  typename VkCommon::VkGPU vkGPU;
+  vkGPU.device_id = this->GetDeviceID();
+
+  // Describe this calculator in VkCommon::VkParameters
+  typename VkCommon::VkParameters vkParameters;
+  if (ImageDimension > 0)
+    vkParameters.X = padSize[0];
+  if (ImageDimension > 1)
+    vkParameters.Y = padSize[1];
+  if (ImageDimension > 2)
+    vkParameters.Z = padSize[2];
+  if (std::is_same<RealType, float>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::FLOAT;
+  else if (std::is_same<RealType, double>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::DOUBLE;
+  else
+    itkAssertOrThrowMacro(false, "Unsupported type for real numbers.");
+  vkParameters.fft = VkCommon::FFTEnum::R2HalfH;
+  vkParameters.PSize = sizeof(RealType);
+  vkParameters.I = VkCommon::DirectionEnum::FORWARD;
+  vkParameters.normalized = VkCommon::NormalizationEnum::NORMALIZED;
+  vkParameters.performPhaseCorrelation = 1;
+  vkParameters.boundaryCondition = m_BoundaryCondition;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    vkParameters.padInputSize[dim] = fixedRegion.GetSize(dim);
+    vkParameters.movingSize[dim] = movingRegion.GetSize(dim);
+  }
+
+  vkParameters.inputCPUBuffer = fixedCPUBuffer;
+  vkParameters.inputBufferBytes = fixedRegion.GetNumberOfPixels() * sizeof(RealType);
+  if (!fixedGPUBuffer && !internalFixed)
+  {
+    VkCommon::IdentifyInput(vkParameters, m_FixedImage);
+  }
+  vkParameters.inputGPUBuffer = fixedGPUBuffer;
+  vkParameters.movingCPUBuffer = movingCPUBuffer;
+  vkParameters.movingBufferBytes = movingRegion.GetNumberOfPixels() * sizeof(RealType);
+  vkParameters.movingGPUBuffer = movingGPUBuffer;
+  double shift[3]{ 0.0, 0.0, 0.0 };
+  vkParameters.phaseShift = shift;
+  vkParameters.peakValues = &m_PeakValue;
+
+  const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
+  if (resFFT != VKFFT_SUCCESS)
+  {
+    std::ostringstream mesg;
+    mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
+    itkAssertOrThrowMacro(false, mesg.str());
+  }
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    m_Shift[dim] = shift[dim];
+  }
+}
+
+template <typename TImage, typename TInternalPrecision>
+void
+VkFFTPhaseCorrelationCalculator<TImage, TInternalPrecision>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  itkPrintSelfObjectMacro(FixedImage);
+  itkPrintSelfObjectMacro(MovingImage);
+  os << indent << "BoundaryCondition: " << m_BoundaryCondition << std::endl;
+  os << indent << "Shift: " << m_Shift << std::endl;
+  os << indent << "PeakValue: " << m_PeakValue << std::endl;
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkFFTPhaseCorrelationCalculator_hxx
@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTTemplateMatchingImageFilter_h
+#define itkVkFFTTemplateMatchingImageFilter_h
+
+#include "itkImage.h"
+#include "itkImageToImageFilter.h"
+#include "itkVkCommon.h"
+#include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ *\class VkFFTTemplateMatchingImageFilter
+ *
+ * \brief Vk-based normalized cross-correlation of an image with a batch of templates through the FFT.
+ *
+ * For each template set with SetTemplateImage(), the output of the same index
+ * is the normalized cross-correlation of the input with the template centered
+ * at each input pixel,
+ *
+ *   output(x) = sum_u (input(x + u) - m(x)) (template(u + center) - t) / (s(x) n),
+ *
+ * where the center of a template is at index size / 2, the input is zero
+ * outside of its largest possible region, m(x) is the mean of the input under
+ * the template at x and t that of the template, and s(x) and n are the norms
+ * of the input minus m(x) under the template and of the template minus t. The
+ * output is in [-1, 1], and zero where the input under the template or the
+ * template is constant. The output regions are the input region.
+ *
+ * The input is uploaded and transformed once. VkFFT multiplies its spectrum
+ * by the spectra of all templates in one launch and inverse-transforms the
+ * batch. The sums of the input and of its squares under the template, from
+ * which the norms s(x) follow, are computed once for all templates on the
+ * device, since all templates are of the same size, and the correlation maps
+ * are normalized there. The location and value of the largest sample of each
+ * normalized map are found on the device as well. Without
+ * ComputeCorrelationMaps, only these peaks are downloaded and the outputs are
+ * left unallocated.
+ *
+ * The templates are stacked into a single image, with the mean t subtracted
+ * and divided by the norm n, that is rebuilt when a template is modified, so
+ * that their spectra are reused across inputs within the kernel spectrum cache
+ * budget of VkGlobalConfiguration.
+ *
+ * \ingroup FourierTransform
+ * \ingroup ITKConvolution
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkGlobalConfiguration
+ * \sa VkFFTConvolutionImageFilter
+ * \sa FFTNormalizedCorrelationImageFilter
+ */
+template <typename TInputImage,
+          typename TTemplateImage = TInputImage,
+          typename TOutputImage = TInputImage,
+          typename TInternalPrecision = double>
+class VkFFTTemplateMatchingImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkFFTTemplateMatchingImageFilter);
+
+  using InputImageType = TInputImage;
+  using TemplateImageType = TTemplateImage;
+  using OutputImageType = TOutputImage;
+  static_assert(std::is_same<TInternalPrecision, float>::value || std::is_same<TInternalPrecision, double>::value,
+                "Unsupported internal precision");
+  static_assert(TInputImage::ImageDimension >= 1 && TInputImage::ImageDimension <= 3, "Unsupported image dimension");
+
+  /** Standard class type aliases. */
+  using Self = VkFFTTemplateMatchingImageFilter;
+  using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using InputPixelType = typename InputImageType::PixelType;
+  using TemplatePixelType = typename TemplateImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using RealType = TInternalPrecision;
+  using IndexType = typename InputImageType::IndexType;
+  using SizeType = typename InputImageType::SizeType;
+  using SizeValueType = typename InputImageType::SizeValueType;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkFFTTemplateMatchingImageFilter, ImageToImageFilter);
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  /** Set the template that the output of index `i` correlates the input with. Setting a
+   *  template beyond the last one adds outputs. */
+  void
+  SetTemplateImage(unsigned int i, const TemplateImageType * templateImage);
+
+  const TemplateImageType *
+  GetTemplateImage(unsigned int i) const;
+
+  /** Number of templates, and of outputs */
+  unsigned int
+  GetNumberOfTemplateImages() const
+  {
+    return this->GetNumberOfIndexedInputs() > 0 ? this->GetNumberOfIndexedInputs() - 1 : 0;
+  }
+
+  /** Whether to download the correlation maps into the outputs. Otherwise only the peaks are
+   *  computed. Defaults to true. */
+  itkSetMacro(ComputeCorrelationMaps, bool);
+  itkGetConstMacro(ComputeCorrelationMaps, bool);
+  itkBooleanMacro(ComputeCorrelationMaps);
+
+  /** Index of the largest sample of the normalized correlation map of template `i`, in the last update */
+  IndexType
+  GetPeakIndex(unsigned int i) const;
+
+  /** Largest sample of the normalized correlation map of template `i`, in the last update */
+  double
+  GetPeakValue(unsigned int i) const;
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in filters constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current filter settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+protected:
+  VkFFTTemplateMatchingImageFilter();
+  ~VkFFTTemplateMatchingImageFilter() override = default;
+
+  /** The input and the templates are needed in their entirety */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The outputs are produced in their entirety */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using InternalImageType = Image<RealType, ImageDimension>;
+
+  /** Stack the templates, with zero mean and unit norm, along the last dimension into
+   *  m_TemplateStack, unless it holds their current state */
+  void
+  StackTemplates();
+
+  bool     m_ComputeCorrelationMaps{ true };
+  bool     m_UseVkGlobalConfiguration{ true };
+  uint64_t m_DeviceID{ 0UL };
+
+  typename InternalImageType::Pointer m_TemplateStack{};
+  std::vector<const DataObject *>     m_StackedTemplates{};
+  std::vector<IndexType>              m_PeakIndices{};
+  std::vector<double>                 m_PeakValues{};
+
+  VkCommon m_VkCommon{};
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkFFTTemplateMatchingImageFilter.hxx"
+#endif
+
+#endif // itkVkFFTTemplateMatchingImageFilter_h
@@ -0,0 +1,359 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkFFTTemplateMatchingImageFilter_hxx
+#define itkVkFFTTemplateMatchingImageFilter_hxx
+
+#include "itkVkFFTTemplateMatchingImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIterator.h"
+#include "itkMath.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::
+  VkFFTTemplateMatchingImageFilter()
+{
+  this->SetNumberOfRequiredInputs(2);
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::SetTemplateImage(
+  unsigned int              i,
+  const TemplateImageType * templateImage)
+{
+  this->SetNthInput(i + 1, const_cast<TemplateImageType *>(templateImage));
+
+  const unsigned int numberOfOutputs{ this->GetNumberOfIndexedOutputs() };
+  if (numberOfOutputs <= i)
+  {
+    this->SetNumberOfIndexedOutputs(i + 1);
+    for (unsigned int output{ numberOfOutputs }; output <= i; ++output)
+    {
+      this->SetNthOutput(output, this->MakeOutput(output));
+    }
+  }
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+auto
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::GetTemplateImage(
+  unsigned int i) const -> const TemplateImageType *
+{
+  return itkDynamicCastInDebugMode<const TemplateImageType *>(this->ProcessObject::GetInput(i + 1));
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+auto
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::GetPeakIndex(
+  unsigned int i) const -> IndexType
+{
+  itkAssertOrThrowMacro(i < m_PeakIndices.size(), "No peak for this template");
+  return m_PeakIndices[i];
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+double
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::GetPeakValue(
+  unsigned int i) const
+{
+  itkAssertOrThrowMacro(i < m_PeakValues.size(), "No peak for this template");
+  return m_PeakValues[i];
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::
+  GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  for (const auto & input : this->GetInputs())
+  {
+    if (auto * const image = dynamic_cast<ImageBase<ImageDimension> *>(input.GetPointer()))
+    {
+      image->SetRequestedRegionToLargestPossibleRegion();
+    }
+  }
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::
+  EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+
+  for (unsigned int i{ 0 }; i < this->GetNumberOfIndexedOutputs(); ++i)
+  {
+    this->GetOutput(i)->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::StackTemplates()
+{
+  const unsigned int numberOfTemplates{ this->GetNumberOfTemplateImages() };
+  itkAssertOrThrowMacro(numberOfTemplates > 0 && this->GetTemplateImage(0) != nullptr, "No template image");
+  using TemplateSizeType = typename TemplateImageType::SizeType;
+  const TemplateSizeType templateSize{ this->GetTemplateImage(0)->GetLargestPossibleRegion().GetSize() };
+
+  typename InternalImageType::SizeType stackSize;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    stackSize[dim] = templateSize[dim];
+  }
+  stackSize[ImageDimension - 1] *= numberOfTemplates;
+
+  // The stack is current if it holds the same templates, none modified since it was built
+  bool current{ m_TemplateStack && m_TemplateStack->GetLargestPossibleRegion().GetSize() == stackSize &&
+                m_StackedTemplates.size() == numberOfTemplates };
+  for (unsigned int i{ 0 }; i < numberOfTemplates; ++i)
+  {
+    const TemplateImageType * const templateImage{ this->GetTemplateImage(i) };
+    itkAssertOrThrowMacro(templateImage != nullptr, "Missing template image");
+    itkAssertOrThrowMacro(templateImage->GetLargestPossibleRegion().GetSize() == templateSize,
+                          "Template images are of different sizes");
+    itkAssertOrThrowMacro(templateImage->GetBufferedRegion() == templateImage->GetLargestPossibleRegion(),
+                          "Template region is not buffered");
+    current = current && m_StackedTemplates[i] == templateImage &&
+              std::max(templateImage->GetMTime(), templateImage->GetUpdateMTime()) < m_TemplateStack->GetMTime();
+  }
+  if (current)
+  {
+    return;
+  }
+
+  m_TemplateStack = InternalImageType::New();
+  m_TemplateStack->SetRegions(stackSize);
+  m_TemplateStack->Allocate();
+  m_StackedTemplates.clear();
+  for (unsigned int i{ 0 }; i < numberOfTemplates; ++i)
+  {
+    const TemplateImageType * const        templateImage{ this->GetTemplateImage(i) };
+    typename InternalImageType::RegionType stackRegion;
+    typename InternalImageType::IndexType  stackIndex{};
+    typename InternalImageType::SizeType   sliceSize;
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      sliceSize[dim] = templateSize[dim];
+    }
+    stackIndex[ImageDimension - 1] = static_cast<IndexValueType>(i * templateSize[ImageDimension - 1]);
+    stackRegion.SetIndex(stackIndex);
+    stackRegion.SetSize(sliceSize);
+    ImageAlgorithm::Copy(
+      templateImage, m_TemplateStack.GetPointer(), templateImage->GetLargestPossibleRegion(), stackRegion);
+    m_StackedTemplates.push_back(templateImage);
+
+    // Give the template zero mean and unit norm, so that the device only needs to divide its
+    // correlation map by the norm of the zero-mean input under the template. A constant template
+    // is set to zero.
+    double sum{ 0.0 };
+    for (ImageRegionConstIterator<InternalImageType> it(m_TemplateStack, stackRegion); !it.IsAtEnd(); ++it)
+    {
+      sum += static_cast<double>(it.Get());
+    }
+    const double mean{ sum / static_cast<double>(stackRegion.GetNumberOfPixels()) };
+    double       sumOfSquares{ 0.0 };
+    for (ImageRegionConstIterator<InternalImageType> it(m_TemplateStack, stackRegion); !it.IsAtEnd(); ++it)
+    {
+      sumOfSquares += (static_cast<double>(it.Get()) - mean) * (static_cast<double>(it.Get()) - mean);
+    }
+    const double norm{ std::sqrt(sumOfSquares) };
+    for (ImageRegionIterator<InternalImageType> it(m_TemplateStack, stackRegion); !it.IsAtEnd(); ++it)
+    {
+      it.Set(norm > 0.0 ? static_cast<RealType>((static_cast<double>(it.Get()) - mean) / norm) : RealType{});
+    }
+  }
+  m_TemplateStack->Modified();
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::GenerateData()
+{
+  const InputImageType * const input{ this->GetInput() };
+  this->StackTemplates();
+  const unsigned int numberOfTemplates{ this->GetNumberOfTemplateImages() };
+
+  // we don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process
+  const ProgressReporter progress(this, 0, 1);
+
+  // Pad the input with zeros to a size that VkFFT transforms and that is large enough for the
+  // correlation not to wrap around
+  const InputImageRegionType & inputRegion{ input->GetLargestPossibleRegion() };
+  itkAssertOrThrowMacro(input->GetBufferedRegion() == inputRegion, "Input region is not buffered");
+  const SizeType &                             inputSize{ inputRegion.GetSize() };
+  const typename TemplateImageType::SizeType & templateSize{
+    this->GetTemplateImage(0)->GetLargestPossibleRegion().GetSize()
+  };
+  SizeType padSize;
+  SizeType templateCenter;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    SizeValueType size{ inputSize[dim] + templateSize[dim] - 1 };
+    while (Math::GreatestPrimeFactor(size) > m_VkCommon.GetGreatestPrimeFactor())
+    {
+      ++size;
+    }
+    padSize[dim] = size;
+    templateCenter[dim] = templateSize[dim] / 2;
+  }
+
+  // VkFFT computes in the internal precision, to which other pixel types are converted on the host.
+  // An input of the internal precision is read from the device where it can be.
+  constexpr bool convertInput{ !std::is_same<InputPixelType, RealType>::value };
+  const VkCommon::DeviceBufferPointer inputGPUBuffer{
+    convertInput ? nullptr : VkImageDeviceBuffer<InputImageType>::GetInputBuffer(input, this->GetDeviceID())
+  };
+  typename InternalImageType::Pointer internalInput;
+  const void *                        inputCPUBuffer{ nullptr };
+  if (!inputGPUBuffer)
+  {
+    if (convertInput)
+    {
+      internalInput = InternalImageType::New();
+      internalInput->SetRegions(inputRegion);
+      internalInput->Allocate();
+      ImageAlgorithm::Copy(input, internalInput.GetPointer(), inputRegion, inputRegion);
+      inputCPUBuffer = internalInput->GetBufferPointer();
+    }
+    else
+    {
+      inputCPUBuffer = input->GetBufferPointer();
+    }
+  }
+
+  // The correlation maps of all templates are downloaded into one stack
+  typename InternalImageType::Pointer mapStack;
+  if (m_ComputeCorrelationMaps)
+  {
+    typename InternalImageType::RegionType mapStackRegion{ inputRegion };
+    mapStackRegion.SetSize(ImageDimension - 1, inputSize[ImageDimension - 1] * numberOfTemplates);
+    mapStack = InternalImageType::New();
+    mapStack->SetRegions(mapStackRegion);
+    mapStack->Allocate();
+  }
+  std::vector<uint64_t> peakOffsets(numberOfTemplates, 0);
+  m_PeakValues.assign(numberOfTemplates, 0.0);
+
+  // Mostly use defaults for VkCommon::VkGPU
+  typename VkCommon::VkGPU vkGPU;
+  vkGPU.device_id = this->GetDeviceID();
+
+  // Describe this filter in VkCommon::VkParameters
+  typename VkCommon::VkParameters vkParameters;
+  if (ImageDimension > 0)
+    vkParameters.X = padSize[0];
+  if (ImageDimension > 1)
+    vkParameters.Y = padSize[1];
+  if (ImageDimension > 2)
+    vkParameters.Z = padSize[2];
+  if (std::is_same<RealType, float>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::FLOAT;
+  else if (std::is_same<RealType, double>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::DOUBLE;
+  else
+    itkAssertOrThrowMacro(false, "Unsupported type for real numbers.");
+  vkParameters.fft = VkCommon::FFTEnum::R2HalfH;
+  vkParameters.PSize = sizeof(RealType);
+  vkParameters.I = VkCommon::DirectionEnum::FORWARD;
+  vkParameters.normalized = VkCommon::NormalizationEnum::NORMALIZED;
+  vkParameters.performConvolution = 1;
+  vkParameters.correlation = 1;
+  vkParameters.normalizeCorrelation = 1;
+  vkParameters.numberKernels = numberOfTemplates;
+  vkParameters.boundaryCondition = VkCommon::BoundaryConditionEnum::ZERO;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    vkParameters.padInputSize[dim] = inputSize[dim];
+    vkParameters.padLowerBound[dim] = templateCenter[dim];
+    vkParameters.kernelSize[dim] = templateSize[dim];
+    vkParameters.kernelCenter[dim] = templateCenter[dim];
+    vkParameters.cropSize[dim] = inputSize[dim];
+    vkParameters.cropLowerBound[dim] = templateCenter[dim];
+  }
+
+  vkParameters.inputCPUBuffer = inputCPUBuffer;
+  vkParameters.inputBufferBytes = inputRegion.GetNumberOfPixels() * sizeof(RealType);
+  if (!inputGPUBuffer && !internalInput)
+  {
+    VkCommon::IdentifyInput(vkParameters, input);
+  }
+  vkParameters.inputGPUBuffer = inputGPUBuffer;
+  vkParameters.kernelCPUBuffer = m_TemplateStack->GetBufferPointer();
+  vkParameters.kernelBufferBytes = m_TemplateStack->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(RealType);
+  VkCommon::IdentifyKernel(vkParameters, m_TemplateStack);
+  if (mapStack)
+  {
+    vkParameters.outputCPUBuffer = mapStack->GetBufferPointer();
+    vkParameters.outputBufferBytes = mapStack->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(RealType);
+  }
+  vkParameters.peakIndices = peakOffsets.data();
+  vkParameters.peakValues = m_PeakValues.data();
+
+  const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
+  if (resFFT != VKFFT_SUCCESS)
+  {
+    std::ostringstream mesg;
+    mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
+    itkAssertOrThrowMacro(false, mesg.str());
+  }
+
+  m_PeakIndices.clear();
+  for (unsigned int i{ 0 }; i < numberOfTemplates; ++i)
+  {
+    m_PeakIndices.push_back(input->ComputeIndex(static_cast<OffsetValueType>(peakOffsets[i])));
+
+    if (mapStack)
+    {
+      OutputImageType * const output{ this->GetOutput(i) };
+      output->SetBufferedRegion(output->GetRequestedRegion());
+      output->Allocate();
+      typename InternalImageType::RegionType mapRegion{ inputRegion };
+      mapRegion.SetIndex(ImageDimension - 1,
+                         inputRegion.GetIndex(ImageDimension - 1) +
+                           static_cast<IndexValueType>(i * inputSize[ImageDimension - 1]));
+      ImageAlgorithm::Copy(mapStack.GetPointer(), output, mapRegion, output->GetRequestedRegion());
+    }
+  }
+}
+
+template <typename TInputImage, typename TTemplateImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkFFTTemplateMatchingImageFilter<TInputImage, TTemplateImage, TOutputImage, TInternalPrecision>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfTemplateImages: " << this->GetNumberOfTemplateImages() << std::endl;
+  os << indent << "ComputeCorrelationMaps: " << m_ComputeCorrelationMaps << std::endl;
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkFFTTemplateMatchingImageFilter_hxx
@@ -21,7 +21,9 @@
 #include "itkFFTImageFilterFactory.h"
 #include "itkForward1DFFTImageFilter.h"
 #include "itkVkCommon.h"
+#include "itkVkFFTBackendDispatch.h"
 #include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
 
 namespace itk
 {
@@ -76,6 +78,7 @@ public:
   using RealType = typename ComplexType::value_type;
   using SizeType = typename InputImageType::SizeType;
   using SizeValueType = typename InputImageType::SizeValueType;
+  using InputImageRegionType = typename InputImageType::RegionType;
   using OutputImageRegionType = typename OutputImageType::RegionType;
 
   /** Method for creation through the object factory. */
@@ -105,6 +108,25 @@ public:
     return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
   }
 
+  /** Split the lines of host images between the device and the next registered backend,
+   *  which transform them at the same time in proportion to their measured throughputs.
+   *  Off by default. */
+  itkSetMacro(UseHostBatchSplit, bool);
+  itkGetMacro(UseHostBatchSplit, bool);
+  itkBooleanMacro(UseHostBatchSplit);
+
+  /** Throughputs of the device and of the host backend measured on the split batches, zero
+   *  until a batch was split. */
+  const VkFFTBatchThroughput &
+  GetBatchThroughput() const
+  {
+    return m_BatchThroughput;
+  }
+
+  /** Whether the last update was computed by the next registered backend because the
+   *  transform was smaller than the crossover of the device. */
+  itkGetConstMacro(GeneratedDataOnHost, bool);
+
   SizeValueType
   GetSizeGreatestPrimeFactor() const override;
 
@@ -123,6 +145,15 @@ private:
   uint64_t m_DeviceID{ 0UL };
 
   VkCommon m_VkCommon{};
+
+  /** Next registered backend for transforms that are too small for the device. */
+  typename Superclass::Pointer m_HostBackend{};
+  bool                         m_GeneratedDataOnHost{ false };
+
+  /** Device part of the batches split with the host backend, and the throughputs of both. */
+  bool                 m_UseHostBatchSplit{ false };
+  Pointer              m_DeviceFilter{};
+  VkFFTBatchThroughput m_BatchThroughput{};
 };
 
 // Describe whether input/output are real- or complex-valued
@@ -22,7 +22,9 @@
 #include "itkForwardFFTImageFilter.h"
 #include "itkImage.h"
 #include "itkVkCommon.h"
+#include "itkVkFFTBackendDispatch.h"
 #include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
 
 namespace itk
 {
@@ -74,7 +76,9 @@ public:
   using RealType = typename ComplexType::value_type;
   using SizeType = typename InputImageType::SizeType;
   using SizeValueType = typename InputImageType::SizeValueType;
+  using InputImageRegionType = typename InputImageType::RegionType;
   using OutputImageRegionType = typename OutputImageType::RegionType;
+  using BoundaryConditionEnum = VkCommon::BoundaryConditionEnum;
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
@@ -103,13 +107,41 @@ public:
     return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
   }
 
+  /** Whether the last update was computed by the next registered backend because the
+   *  transform was smaller than the crossover of the device. */
+  itkGetConstMacro(GeneratedDataOnHost, bool);
+
   SizeValueType
   GetSizeGreatestPrimeFactor() const override;
 
+  /** Region of the input image outside of which all pixels are known to be zero,
+   *  as for an image that has been zero padded ahead of a convolution. VkFFT then
+   *  skips reading and transforming the block of zeros along each dimension.
+   *  An empty region (the default) declares no zeros. */
+  itkSetMacro(NonZeroInputRegion, InputImageRegionType);
+  itkGetConstReferenceMacro(NonZeroInputRegion, InputImageRegionType);
+
+  /** Number of samples to add below and above the input along each dimension
+   *  before transforming. Padding is generated on the device from the uploaded
+   *  input, so the padded image never exists in host memory. The output covers
+   *  the padded domain, starting PadLowerBound samples below the input index. */
+  itkSetMacro(PadLowerBound, SizeType);
+  itkGetConstReferenceMacro(PadLowerBound, SizeType);
+  itkSetMacro(PadUpperBound, SizeType);
+  itkGetConstReferenceMacro(PadUpperBound, SizeType);
+
+  /** Boundary condition that generates the padded samples: ZERO, PERIODIC,
+   *  ZERO_FLUX_NEUMANN (the default) or MIRROR. */
+  itkSetEnumMacro(BoundaryCondition, BoundaryConditionEnum);
+  itkGetEnumMacro(BoundaryCondition, BoundaryConditionEnum);
+
 protected:
   VkForwardFFTImageFilter();
   ~VkForwardFFTImageFilter() override = default;
 
+  void
+  GenerateOutputInformation() override;
+
   void
   GenerateData() override;
 
@@ -120,7 +152,20 @@ private:
   bool     m_UseVkGlobalConfiguration{ true };
   uint64_t m_DeviceID{ 0UL };
 
+  /** Whether any padding is requested. */
+  bool
+  IsPadded() const;
+
+  InputImageRegionType  m_NonZeroInputRegion{};
+  SizeType              m_PadLowerBound{};
+  SizeType              m_PadUpperBound{};
+  BoundaryConditionEnum m_BoundaryCondition{ BoundaryConditionEnum::ZERO_FLUX_NEUMANN };
+
   VkCommon m_VkCommon{};
+
+  /** Next registered backend for transforms that are too small for the device. */
+  typename Superclass::Pointer m_HostBackend{};
+  bool                         m_GeneratedDataOnHost{ false };
 };
 
 // Describe whether input/output are real- or complex-valued
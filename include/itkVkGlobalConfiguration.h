@@ -22,6 +22,12 @@
 #include "itkLightObject.h"
 #include "itkMacro.h"
 
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
 namespace itk
 {
 
@@ -61,6 +67,110 @@ public:
   static uint64_t
   GetDeviceID();
 
+  /** Number of bytes of device memory that may hold copies of filter inputs after a
+   *  transform, so that a later transform of the same unmodified input on the same device
+   *  skips the upload. Default 0, which disables residency. */
+  static void
+  SetDeviceResidencyBudget(const uint64_t bytes);
+
+  /** Number of bytes of device memory that may hold copies of filter inputs */
+  static uint64_t
+  GetDeviceResidencyBudget();
+
+  /** Number of bytes of device memory that may hold the spectra of convolution kernels,
+   *  so that a later convolution with the same unmodified kernel on the same device and
+   *  of the same padded size skips the kernel transform. Default 0, which disables the
+   *  kernel spectrum cache. */
+  static void
+  SetKernelSpectrumCacheBudget(const uint64_t bytes);
+
+  /** Number of bytes of device memory that may hold the spectra of convolution kernels */
+  static uint64_t
+  GetKernelSpectrumCacheBudget();
+
+  /** Run time of Gaussian smoothing, fitted by benchmarks of separable spatial smoothing
+   *  on the CPU and of FFT smoothing on a device. Predictions are linear combinations of
+   *  the coefficients with the terms described below. */
+  struct SmoothingCostModel
+  {
+    double   spatialCoefficients[3] = { 0.0, 0.0, 0.0 }; // seconds per pixel and kernel tap, per pixel, per run
+    double   fftCoefficients[3] = { 0.0, 0.0, 0.0 };     // seconds per padded sample times its base 2 logarithm,
+                                                         // per pixel, per run
+    uint64_t numberOfWorkUnits{ 0 };                     // CPU threads that the spatial smoothing was benchmarked on
+
+    /** Predicted seconds of spatial smoothing of `pixels` pixels with a separable kernel of
+     *  `taps` taps summed over the dimensions. */
+    double
+    PredictSpatial(double pixels, double taps) const
+    {
+      return spatialCoefficients[0] * pixels * taps + spatialCoefficients[1] * pixels + spatialCoefficients[2];
+    }
+
+    /** Predicted seconds of FFT smoothing of `pixels` pixels padded into `paddedSamples` samples. */
+    double
+    PredictFFT(double pixels, double paddedSamples) const
+    {
+      return fftCoefficients[0] * paddedSamples * std::log2(paddedSamples) + fftCoefficients[1] * pixels +
+             fftCoefficients[2];
+    }
+  };
+
+  /** Cost model of Gaussian smoothing with the given device, typically fitted by
+   *  VkMultiResolutionPyramidImageFilter::CalibrateSmoothing. */
+  static void
+  SetSmoothingCostModel(const uint64_t deviceID, const SmoothingCostModel & model);
+
+  /** Get the cost model of Gaussian smoothing with the given device. Returns false if
+   *  the device has not been calibrated. */
+  static bool
+  GetSmoothingCostModel(const uint64_t deviceID, SmoothingCostModel & model);
+
+  /** Forget the cost models of all devices. */
+  static void
+  RemoveSmoothingCostModels();
+
+  /** Write the cost models of all calibrated devices to a text file, so that later
+   *  processes can read them instead of calibrating again. */
+  static void
+  WriteSmoothingCostModels(const std::string & fileName);
+
+  /** Read cost models written by WriteSmoothingCostModels. They replace the models of
+   *  the same devices. */
+  static void
+  ReadSmoothingCostModels(const std::string & fileName);
+
+  /** Smallest number of samples that Vk FFT filters transform on the device when they read
+   *  and write images in host memory and use no option of their own. Smaller transforms are
+   *  computed by the next FFT backend registered for their base class. Default 0, which
+   *  transforms everything on the device. */
+  static void
+  SetDefaultFFTDeviceMinimumSamples(const uint64_t samples);
+
+  /** Smallest number of samples that Vk FFT filters transform on the device by default */
+  static uint64_t
+  GetDefaultFFTDeviceMinimumSamples();
+
+  /** Smallest number of samples that the Vk FFT filter of the given class name transforms
+   *  in the given precision, in bytes per real number, on the given device, typically
+   *  measured by VkFFTBackendDispatch::CalibrateDeviceMinimumSamples. Replaces the default
+   *  for them. */
+  static void
+  SetFFTDeviceMinimumSamples(const uint64_t      deviceID,
+                             const std::string & filterName,
+                             const unsigned int  precisionBytes,
+                             const uint64_t      samples);
+
+  /** Smallest number of samples that the Vk FFT filter of the given class name transforms
+   *  in the given precision on the given device, or the default if it was not set. */
+  static uint64_t
+  GetFFTDeviceMinimumSamples(const uint64_t      deviceID,
+                             const std::string & filterName,
+                             const unsigned int  precisionBytes);
+
+  /** Forget the minimum samples set for particular filters, leaving the default. */
+  static void
+  RemoveFFTDeviceMinimumSamples();
+
 private:
   VkGlobalConfiguration() = default;
   ~VkGlobalConfiguration() override = default;
@@ -80,6 +190,15 @@ private:
   static VkGlobalConfigurationGlobals * m_PimplGlobals;
 
   uint64_t m_DeviceID{ 0 };
+  uint64_t m_DeviceResidencyBudget{ 0 };
+  uint64_t m_KernelSpectrumCacheBudget{ 0 };
+
+  std::map<uint64_t, SmoothingCostModel> m_SmoothingCostModels{};
+  std::mutex                             m_SmoothingCostModelLock{};
+
+  uint64_t                                                           m_DefaultFFTDeviceMinimumSamples{ 0 };
+  std::map<std::tuple<uint64_t, std::string, unsigned int>, uint64_t> m_FFTDeviceMinimumSamples{};
+  std::mutex                                                         m_FFTDeviceMinimumSamplesLock{};
 };
 } // namespace itk
 
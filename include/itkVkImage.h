@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkImage_h
+#define itkVkImage_h
+
+#include "itkImage.h"
+#include "itkVkDeviceContext.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace itk
+{
+/**
+ *\class VkImage
+ *
+ * \brief Image whose pixels may be held in device memory by the Vk filters.
+ *
+ * A Vk filter whose output is a VkImage leaves its result in device memory,
+ * and a Vk filter whose input is a VkImage with its pixels on the filter's
+ * device reads them from there. A chain of Vk filters, such as a forward
+ * and an inverse FFT, then never copies its intermediate images through
+ * host memory.
+ *
+ * The host buffer is brought up to date only when it is accessed through
+ * GetBufferPointer(), GetPixelContainer(), GetPixel() or operator[], which
+ * is how iterators, non-Vk filters and writers that are instantiated for the
+ * VkImage type read it. Code that reads the pixels through a pointer to the
+ * itk::Image superclass should call UpdateHostBuffer() first. Writing through
+ * the host accessors releases the device copy, and so does generating the image
+ * in a filter that does not hand it a new device buffer, such as an in-place
+ * filter that grafts a VkImage input onto it and writes the pixels through
+ * iterators. Code outside a pipeline that writes through an iterator must call
+ * Modified() afterwards, as for any image; the device copy is then no longer
+ * used, because it is older than the image.
+ *
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkDeviceBuffer
+ */
+template <typename TPixel, unsigned int VImageDimension = 2>
+class VkImage : public Image<TPixel, VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkImage);
+
+  /** Standard class type aliases. */
+  using Self = VkImage;
+  using Superclass = Image<TPixel, VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ConstWeakPointer = WeakPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkImage, Image);
+
+  static constexpr unsigned int ImageDimension{ VImageDimension };
+
+  using PixelType = typename Superclass::PixelType;
+  using IndexType = typename Superclass::IndexType;
+  using PixelContainer = typename Superclass::PixelContainer;
+  using DeviceBufferPointer = VkDeviceBuffer::Pointer;
+
+  template <typename UPixelType, unsigned int NUnitDimension = VImageDimension>
+  struct Rebind
+  {
+    using Type = VkImage<UPixelType, NUnitDimension>;
+  };
+
+  /** Hand the pixels of the buffered region over to a device buffer. The host
+   *  buffer is out of date until it is accessed. */
+  void
+  SetDeviceBuffer(const DeviceBufferPointer & buffer);
+
+  /** Device buffer that holds the current pixels, or nullptr. A device copy is not
+   *  current once the image has been modified after it was handed over. */
+  DeviceBufferPointer
+  GetDeviceBuffer() const;
+
+  /** Device buffer that holds the current pixels on the enumerated device, or nullptr. */
+  DeviceBufferPointer
+  GetDeviceBuffer(uint64_t deviceID) const;
+
+  /** Whether the host buffer holds the current pixels. */
+  bool
+  IsHostBufferCurrent() const
+  {
+    return m_HostBufferIsCurrent;
+  }
+
+  /** Copy the pixels from the device to the host buffer if it is out of date. */
+  void
+  UpdateHostBuffer() const;
+
+  void
+  Allocate(bool initializePixels = false) override;
+
+  void
+  Initialize() override;
+
+  void
+  Graft(const DataObject * data) override;
+
+  /** Note when the pipeline starts generating the image. */
+  void
+  PrepareForNewData() override;
+
+  /** Release a device copy that was handed over before the pipeline started generating the
+   *  image, since the filter that generated it wrote its pixels in host memory. */
+  void
+  DataHasBeenGenerated() override;
+
+  /** Host access to the pixels. These bring the host buffer up to date, and
+   *  the non-const ones release the device copy. */
+  void
+  FillBuffer(const TPixel & value);
+
+  void
+  SetPixel(const IndexType & index, const TPixel & value)
+  {
+    this->PrepareHostWrite();
+    Superclass::SetPixel(index, value);
+  }
+
+  const TPixel &
+  GetPixel(const IndexType & index) const
+  {
+    this->UpdateHostBuffer();
+    return Superclass::GetPixel(index);
+  }
+
+  TPixel &
+  GetPixel(const IndexType & index)
+  {
+    this->PrepareHostWrite();
+    return Superclass::GetPixel(index);
+  }
+
+  TPixel & operator[](const IndexType & index) { return this->GetPixel(index); }
+
+  const TPixel & operator[](const IndexType & index) const { return this->GetPixel(index); }
+
+  TPixel *
+  GetBufferPointer()
+  {
+    this->PrepareHostWrite();
+    return Superclass::GetBufferPointer();
+  }
+
+  const TPixel *
+  GetBufferPointer() const
+  {
+    this->UpdateHostBuffer();
+    return Superclass::GetBufferPointer();
+  }
+
+  PixelContainer *
+  GetPixelContainer()
+  {
+    this->PrepareHostWrite();
+    return Superclass::GetPixelContainer();
+  }
+
+  const PixelContainer *
+  GetPixelContainer() const
+  {
+    this->UpdateHostBuffer();
+    return Superclass::GetPixelContainer();
+  }
+
+  void
+  SetPixelContainer(PixelContainer * container);
+
+protected:
+  VkImage() = default;
+  ~VkImage() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Bring the host buffer up to date and release the device copy */
+  void
+  PrepareHostWrite();
+
+  /** Release the device copy, leaving the host buffer as it is */
+  void
+  ReleaseDeviceBuffer();
+
+  mutable std::mutex        m_DeviceMutex{};
+  mutable std::atomic<bool> m_HostBufferIsCurrent{ true };
+  std::atomic<bool>         m_DeviceBufferIsCurrent{ false };
+  DeviceBufferPointer       m_DeviceBuffer{};
+
+  // When the device buffer was handed over, possibly to an image grafted onto this one, and
+  // when the pipeline last started generating this image
+  TimeStamp m_DeviceBufferTime{};
+  TimeStamp m_NewDataTime{};
+
+  // Modification time of this image when the device copy became its current pixels
+  ModifiedTimeType m_DeviceBufferMTime{ 0 };
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkImage.hxx"
+#endif
+
+#endif // itkVkImage_h
@@ -0,0 +1,225 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkImage_hxx
+#define itkVkImage_hxx
+
+#include "itkVkImage.h"
+
+namespace itk
+{
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::SetDeviceBuffer(const DeviceBufferPointer & buffer)
+{
+  if (!buffer)
+  {
+    this->UpdateHostBuffer();
+    this->ReleaseDeviceBuffer();
+    return;
+  }
+  const SizeValueType bufferBytes{ this->GetBufferedRegion().GetNumberOfPixels() * sizeof(TPixel) };
+  itkAssertOrThrowMacro(buffer->GetBytes() == bufferBytes, "Device buffer does not match the buffered region.");
+
+  const std::lock_guard<std::mutex> lock{ m_DeviceMutex };
+  m_DeviceBuffer = buffer;
+  m_DeviceBufferIsCurrent = true;
+  m_HostBufferIsCurrent = false;
+  m_DeviceBufferTime.Modified();
+  m_DeviceBufferMTime = this->GetMTime();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+VkImage<TPixel, VImageDimension>::GetDeviceBuffer() const -> DeviceBufferPointer
+{
+  const std::lock_guard<std::mutex> lock{ m_DeviceMutex };
+  return m_DeviceBufferIsCurrent && this->GetMTime() <= m_DeviceBufferMTime ? m_DeviceBuffer : nullptr;
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+VkImage<TPixel, VImageDimension>::GetDeviceBuffer(uint64_t deviceID) const -> DeviceBufferPointer
+{
+  const DeviceBufferPointer buffer{ this->GetDeviceBuffer() };
+  return buffer && buffer->GetDeviceID() == deviceID ? buffer : nullptr;
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::UpdateHostBuffer() const
+{
+  if (m_HostBufferIsCurrent)
+  {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock{ m_DeviceMutex };
+  // Another thread may have updated the host buffer while this one waited
+  if (m_HostBufferIsCurrent)
+  {
+    return;
+  }
+
+  VkDeviceContext::Pointer context;
+  VkFFTResult              resFFT{ VkDeviceContext::GetInstance(m_DeviceBuffer->GetDeviceID(), context) };
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = context->MakeCurrent();
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = context->CopyDeviceToHost(const_cast<TPixel *>(Superclass::GetBufferPointer()),
+                                       m_DeviceBuffer->GetMemory(),
+                                       m_DeviceBuffer->GetBytes());
+  if (resFFT != VKFFT_SUCCESS)
+  {
+    itkExceptionMacro("Copying the pixels from the device failed with error code " << resFFT << ".");
+  }
+  m_HostBufferIsCurrent = true;
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::Allocate(bool initializePixels)
+{
+  this->ReleaseDeviceBuffer();
+  m_HostBufferIsCurrent = true;
+  Superclass::Allocate(initializePixels);
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::Initialize()
+{
+  this->ReleaseDeviceBuffer();
+  m_HostBufferIsCurrent = true;
+  Superclass::Initialize();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::Graft(const DataObject * data)
+{
+  Superclass::Graft(data);
+
+  // Share the device copy too, so that it stays the current one
+  const auto * const image{ dynamic_cast<const Self *>(data) };
+  if (image == this)
+  {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock{ m_DeviceMutex };
+  if (image)
+  {
+    const std::lock_guard<std::mutex> imageLock{ image->m_DeviceMutex };
+    m_DeviceBuffer = image->m_DeviceBuffer;
+    m_DeviceBufferIsCurrent = image->m_DeviceBufferIsCurrent && image->GetMTime() <= image->m_DeviceBufferMTime;
+    m_HostBufferIsCurrent = image->m_HostBufferIsCurrent.load();
+    m_DeviceBufferTime = image->m_DeviceBufferTime;
+    // Grafting modified this image, which holds the same pixels as before
+    m_DeviceBufferMTime = this->GetMTime();
+  }
+  else
+  {
+    m_DeviceBuffer.reset();
+    m_DeviceBufferIsCurrent = false;
+    m_HostBufferIsCurrent = true;
+  }
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::PrepareForNewData()
+{
+  m_NewDataTime.Modified();
+  Superclass::PrepareForNewData();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::DataHasBeenGenerated()
+{
+  Superclass::DataHasBeenGenerated();
+
+  // A filter that hands over a device buffer does so after the pipeline started generating
+  // the image. An older device copy was grafted onto the image, which was then generated in
+  // host memory.
+  if (m_DeviceBufferIsCurrent && m_DeviceBufferTime.GetMTime() < m_NewDataTime.GetMTime())
+  {
+    this->PrepareHostWrite();
+  }
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::FillBuffer(const TPixel & value)
+{
+  this->ReleaseDeviceBuffer();
+  m_HostBufferIsCurrent = true;
+  Superclass::FillBuffer(value);
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::SetPixelContainer(PixelContainer * container)
+{
+  this->ReleaseDeviceBuffer();
+  m_HostBufferIsCurrent = true;
+  Superclass::SetPixelContainer(container);
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::PrepareHostWrite()
+{
+  this->UpdateHostBuffer();
+  this->ReleaseDeviceBuffer();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::ReleaseDeviceBuffer()
+{
+  if (!m_DeviceBufferIsCurrent)
+  {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock{ m_DeviceMutex };
+  m_DeviceBufferIsCurrent = false;
+  m_DeviceBuffer.reset();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+VkImage<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  const DeviceBufferPointer buffer{ this->GetDeviceBuffer() };
+  os << indent << "HostBufferIsCurrent: " << m_HostBufferIsCurrent << std::endl;
+  os << indent << "DeviceBuffer: ";
+  if (buffer)
+  {
+    os << buffer->GetBytes() << " bytes on device " << buffer->GetDeviceID() << std::endl;
+  }
+  else
+  {
+    os << "(none)" << std::endl;
+  }
+}
+
+} // end namespace itk
+
+#endif // itkVkImage_hxx
@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkImageDeviceBuffer_h
+#define itkVkImageDeviceBuffer_h
+
+#include "itkVkImage.h"
+#ifdef VKFFT_USE_ITK_GPU
+#  include "itkGPUImage.h"
+#endif
+
+namespace itk
+{
+/**
+ *\class VkImageDeviceBuffer
+ *
+ * \brief Access to the pixels of the input and output images of a Vk filter in device memory.
+ *
+ * The pixels of a VkImage are read from and left in its device buffer. When
+ * ITK is built with ITK_USE_GPU and the OpenCL backend is used, the pixels of
+ * a GPUImage are read from and written to its OpenCL buffer, provided that the
+ * Vk filter runs in the context of ITK's GPUContextManager. The pixels of all
+ * other images are read from and written to host memory by the Vk filter.
+ *
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkImage
+ */
+template <typename TImage>
+class VkImageDeviceBuffer
+{
+public:
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using DeviceBufferPointer = VkDeviceBuffer::Pointer;
+
+  static constexpr unsigned int ImageDimension{ ImageType::ImageDimension };
+
+  using VkImageType = VkImage<PixelType, ImageDimension>;
+#ifdef VKFFT_USE_ITK_GPU
+  using GPUImageType = GPUImage<PixelType, ImageDimension>;
+#endif
+
+  /** Device buffer on the enumerated device that holds the pixels of the buffered
+   *  region of an input image, or nullptr if they are to be read from host memory. */
+  static DeviceBufferPointer
+  GetInputBuffer(const ImageType * image, uint64_t deviceID)
+  {
+    if (const auto * const vkImage = dynamic_cast<const VkImageType *>(image))
+    {
+      return vkImage->GetDeviceBuffer(deviceID);
+    }
+#ifdef VKFFT_USE_ITK_GPU
+    if (const auto * const gpuImage = dynamic_cast<const GPUImageType *>(image))
+    {
+      return GetGPUImageBuffer(gpuImage, deviceID, true);
+    }
+#endif
+    return nullptr;
+  }
+
+  /** Whether the pixels of an image are held in device memory by its type, as those of a
+   *  VkImage, or of a GPUImage when ITK's GPU module is used. */
+  static bool
+  IsDeviceImage(const ImageType * image)
+  {
+    if (dynamic_cast<const VkImageType *>(image))
+    {
+      return true;
+    }
+#ifdef VKFFT_USE_ITK_GPU
+    if (dynamic_cast<const GPUImageType *>(image))
+    {
+      return true;
+    }
+#endif
+    return false;
+  }
+
+  /** Whether the pixels of an allocated output image are to be left on the enumerated
+   *  device. If so, `buffer` is the device buffer that they are written to, or nullptr
+   *  if the Vk filter is to allocate one. */
+  static bool
+  GetOutputBuffer(ImageType * image, uint64_t deviceID, DeviceBufferPointer & buffer)
+  {
+    buffer.reset();
+    if (dynamic_cast<VkImageType *>(image))
+    {
+      return true;
+    }
+#ifdef VKFFT_USE_ITK_GPU
+    if (const auto * const gpuImage = dynamic_cast<GPUImageType *>(image))
+    {
+      buffer = GetGPUImageBuffer(gpuImage, deviceID, false);
+      return buffer != nullptr;
+    }
+#endif
+    (void)deviceID;
+    return false;
+  }
+
+  /** Hand the device buffer that the pixels of an output image were written to over
+   *  to the image. The host buffer is out of date until it is accessed. */
+  static void
+  SetOutputBuffer(ImageType * image, const DeviceBufferPointer & buffer)
+  {
+    if (auto * const vkImage = dynamic_cast<VkImageType *>(image))
+    {
+      vkImage->SetDeviceBuffer(buffer);
+      return;
+    }
+#ifdef VKFFT_USE_ITK_GPU
+    if (auto * const gpuImage = dynamic_cast<GPUImageType *>(image))
+    {
+      GPUDataManager * const dataManager{ gpuImage->GetGPUDataManager() };
+      dataManager->SetGPUDirtyFlag(false);
+      dataManager->SetCPUDirtyFlag(true);
+    }
+#endif
+  }
+
+private:
+#ifdef VKFFT_USE_ITK_GPU
+  /** Reference the OpenCL buffer of a GPUImage if the enumerated device shares the context
+   *  of ITK's GPU module. The buffer of an input is brought up to date first. */
+  static DeviceBufferPointer
+  GetGPUImageBuffer(const GPUImageType * image, uint64_t deviceID, bool isInput)
+  {
+    VkDeviceContext::Pointer context;
+    if (VkDeviceContext::GetInstance(deviceID, context) != VKFFT_SUCCESS || !context->IsSharingGPUContext())
+    {
+      return nullptr;
+    }
+    GPUDataManager * const dataManager{ image->GetGPUDataManager() };
+    if (isInput)
+    {
+      dataManager->UpdateGPUBuffer();
+    }
+    const cl_mem * const memory{ dataManager->GetGPUBufferPointer() };
+    const uint64_t       bytes{ image->GetBufferedRegion().GetNumberOfPixels() * sizeof(PixelType) };
+    if (memory == nullptr || *memory == nullptr || dataManager->GetBufferSize() != bytes)
+    {
+      return nullptr;
+    }
+
+    DeviceBufferPointer buffer;
+    if (context->Share(*memory, bytes, buffer) != VKFFT_SUCCESS)
+    {
+      return nullptr;
+    }
+    return buffer;
+  }
+#endif
+};
+
+} // namespace itk
+
+#endif // itkVkImageDeviceBuffer_h
@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkInverseDeconvolutionImageFilter_h
+#define itkVkInverseDeconvolutionImageFilter_h
+
+#include "itkInverseDeconvolutionImageFilter.h"
+#include "itkVkCommon.h"
+#include "itkVkDeconvolutionHelper.h"
+#include "itkVkGlobalConfiguration.h"
+
+namespace itk
+{
+/**
+ *\class VkInverseDeconvolutionImageFilter
+ *
+ * \brief Vk-based inverse deconvolution in half-Hermitian space.
+ *
+ * This filter computes the same division of the spectrum of the input by the
+ * transfer function as InverseDeconvolutionImageFilter, entirely on the device:
+ * the padded input and the placed kernel are transformed with one VkFFT plan,
+ * a device kernel divides the half-Hermitian spectrum of the input wherever the
+ * magnitude of the transfer function reaches KernelZeroMagnitudeThreshold, and
+ * the quotient is transformed back before the output region is cropped. Only
+ * the input, the kernel and the cropped output cross the bus.
+ *
+ * \ingroup FourierTransform
+ * \ingroup ITKDeconvolution
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkCommon::GetBoundaryCondition
+ * \sa VkGlobalConfiguration
+ * \sa InverseDeconvolutionImageFilter
+ */
+template <typename TInputImage,
+          typename TKernelImage = TInputImage,
+          typename TOutputImage = TInputImage,
+          typename TInternalPrecision = double>
+class VkInverseDeconvolutionImageFilter
+  : public InverseDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkInverseDeconvolutionImageFilter);
+
+  using InputImageType = TInputImage;
+  using KernelImageType = TKernelImage;
+  using OutputImageType = TOutputImage;
+  static_assert(std::is_same<TInternalPrecision, float>::value || std::is_same<TInternalPrecision, double>::value,
+                "Unsupported internal precision");
+  static_assert(TInputImage::ImageDimension >= 1 && TInputImage::ImageDimension <= 3, "Unsupported image dimension");
+
+  /** Standard class type aliases. */
+  using Self = VkInverseDeconvolutionImageFilter;
+  using Superclass =
+    InverseDeconvolutionImageFilter<InputImageType, KernelImageType, OutputImageType, TInternalPrecision>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using RealType = TInternalPrecision;
+  using SizeValueType = typename InputImageType::SizeValueType;
+  using HelperType = VkDeconvolutionHelper<InputImageType, KernelImageType, OutputImageType, RealType>;
+  using BoundaryConditionEnum = VkCommon::BoundaryConditionEnum;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkInverseDeconvolutionImageFilter, InverseDeconvolutionImageFilter);
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in filters constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current filter settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+  /** Boundary condition that the device generates for the boundary condition of
+   *  the filter, or NONE if it cannot generate it. */
+  BoundaryConditionEnum
+  GetVkBoundaryCondition() const
+  {
+    return VkCommon::GetBoundaryCondition(this->GetBoundaryCondition());
+  }
+
+protected:
+  VkInverseDeconvolutionImageFilter();
+  ~VkInverseDeconvolutionImageFilter() override = default;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool     m_UseVkGlobalConfiguration{ true };
+  uint64_t m_DeviceID{ 0UL };
+
+  VkCommon m_VkCommon{};
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkInverseDeconvolutionImageFilter.hxx"
+#endif
+
+#endif // itkVkInverseDeconvolutionImageFilter_h
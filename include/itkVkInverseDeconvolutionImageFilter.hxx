@@ -0,0 +1,72 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkInverseDeconvolutionImageFilter_hxx
+#define itkVkInverseDeconvolutionImageFilter_hxx
+
+#include "itkVkInverseDeconvolutionImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+VkInverseDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::
+  VkInverseDeconvolutionImageFilter()
+{
+  this->SetSizeGreatestPrimeFactor(m_VkCommon.GetGreatestPrimeFactor());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkInverseDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
+{
+  if (this->GetVkBoundaryCondition() == BoundaryConditionEnum::NONE)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  // The division is a single pass on the device, so only its beginning and end are reported
+  const ProgressReporter progress(this, 0, 1);
+
+  const typename InputImageType::SizeType padSize{ this->GetPadSize() };
+  typename VkCommon::VkParameters         vkParameters;
+  // The threshold applies to the magnitude of the transfer function
+  vkParameters.deconvolution = VkCommon::DeconvolutionEnum::INVERSE;
+  vkParameters.zeroMagnitudeThreshold = this->GetKernelZeroMagnitudeThreshold();
+
+  HelperType::Deconvolve(this, padSize, this->GetPadLowerBound(), this->GetDeviceID(), m_VkCommon, vkParameters);
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkInverseDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "VkBoundaryCondition: " << this->GetVkBoundaryCondition() << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkInverseDeconvolutionImageFilter_hxx
@@ -22,7 +22,9 @@
 #include "itkImage.h"
 #include "itkInverseFFTImageFilter.h"
 #include "itkVkCommon.h"
+#include "itkVkFFTBackendDispatch.h"
 #include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
 
 namespace itk
 {
@@ -103,9 +105,21 @@ public:
     return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
   }
 
+  /** Whether the last update was computed by the next registered backend because the
+   *  transform was smaller than the crossover of the device. */
+  itkGetConstMacro(GeneratedDataOnHost, bool);
+
   SizeValueType
   GetSizeGreatestPrimeFactor() const override;
 
+  /** Region of the output image that is actually needed, as for a convolution
+   *  that is cropped after the inverse transform. VkFFT then skips computing and
+   *  writing the block outside of this region along each dimension, and output
+   *  pixels in the skipped block are left undefined.
+   *  An empty region (the default) keeps the full output. */
+  itkSetMacro(KeptOutputRegion, OutputImageRegionType);
+  itkGetConstReferenceMacro(KeptOutputRegion, OutputImageRegionType);
+
 protected:
   VkInverseFFTImageFilter();
   ~VkInverseFFTImageFilter() override = default;
@@ -120,7 +134,13 @@ private:
   bool     m_UseVkGlobalConfiguration{ true };
   uint64_t m_DeviceID{ 0UL };
 
+  OutputImageRegionType m_KeptOutputRegion{};
+
   VkCommon m_VkCommon{};
+
+  /** Next registered backend for transforms that are too small for the device. */
+  typename Superclass::Pointer m_HostBackend{};
+  bool                         m_GeneratedDataOnHost{ false };
 };
 
 // Describe whether input/output are real- or complex-valued
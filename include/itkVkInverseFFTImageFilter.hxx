@@ -47,6 +47,15 @@ VkInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     return;
   }
 
+  // Transform small images in host memory with the next registered backend unless an option
+  // of this filter is set
+  m_GeneratedDataOnHost = m_KeptOutputRegion.GetNumberOfPixels() == 0 &&
+                          VkFFTBackendDispatch<Self>::GenerateDataOnHost(this, m_HostBackend, [](Superclass *) {});
+  if (m_GeneratedDataOnHost)
+  {
+    return;
+  }
+
   // we don't have a nice progress to report, but at least this simple line
   // reports the beginning and the end of the process
   const ProgressReporter progress(this, 0, 1);
@@ -57,9 +66,17 @@ VkInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   const SizeType & inputSize{ input->GetLargestPossibleRegion().GetSize() };
 
-  const InputPixelType * const inputCPUBuffer{ input->GetBufferPointer() };
+  // Read an input that is held on the device from there, and leave the output on the device
+  // when it can hold it there
+  const VkCommon::DeviceBufferPointer inputGPUBuffer{ VkImageDeviceBuffer<InputImageType>::GetInputBuffer(
+    input, this->GetDeviceID()) };
+  VkCommon::DeviceBufferPointer       outputGPUBuffer;
+  const bool                          deviceOutput{ VkImageDeviceBuffer<OutputImageType>::GetOutputBuffer(
+    output, this->GetDeviceID(), outputGPUBuffer) };
+
+  const InputPixelType * const inputCPUBuffer{ inputGPUBuffer ? nullptr : input->GetBufferPointer() };
   OutputPixelType * const      outputCPUBuffer{ output->GetBufferPointer() };
-  itkAssertOrThrowMacro(inputCPUBuffer != nullptr, "No CPU input buffer");
+  itkAssertOrThrowMacro(inputCPUBuffer != nullptr || inputGPUBuffer, "No input buffer");
   itkAssertOrThrowMacro(outputCPUBuffer != nullptr, "No CPU output buffer");
   const SizeValueType inBytes{ input->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(InputPixelType) };
   const SizeValueType outBytes{ output->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(OutputPixelType) };
@@ -87,10 +104,33 @@ VkInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   vkParameters.I = VkCommon::DirectionEnum::INVERSE;
   vkParameters.normalized = VkCommon::NormalizationEnum::NORMALIZED;
 
+  if (m_KeptOutputRegion.GetNumberOfPixels() > 0)
+  {
+    const OutputImageRegionType & largestRegion{ output->GetLargestPossibleRegion() };
+    itkAssertOrThrowMacro(largestRegion.IsInside(m_KeptOutputRegion),
+                          "KeptOutputRegion must lie inside the largest possible output region.");
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      const uint64_t supportBegin{ static_cast<uint64_t>(m_KeptOutputRegion.GetIndex(dim) -
+                                                         largestRegion.GetIndex(dim)) };
+      VkCommon::SetSpatialSupport(
+        vkParameters, dim, inputSize[dim], supportBegin, supportBegin + m_KeptOutputRegion.GetSize(dim));
+    }
+  }
+
   vkParameters.inputCPUBuffer = inputCPUBuffer;
   vkParameters.inputBufferBytes = inBytes;
+  if (!inputGPUBuffer)
+  {
+    VkCommon::IdentifyInput(vkParameters, input);
+  }
+  vkParameters.inputGPUBuffer = inputGPUBuffer;
   vkParameters.outputCPUBuffer = outputCPUBuffer;
   vkParameters.outputBufferBytes = outBytes;
+  if (deviceOutput)
+  {
+    vkParameters.outputGPUBuffer = &outputGPUBuffer;
+  }
 
   const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
   if (resFFT != VKFFT_SUCCESS)
@@ -99,6 +139,10 @@ VkInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
     itkAssertOrThrowMacro(false, mesg.str());
   }
+  if (deviceOutput)
+  {
+    VkImageDeviceBuffer<OutputImageType>::SetOutputBuffer(output, outputGPUBuffer);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -110,6 +154,7 @@ VkInverseFFTImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os,
   os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
   os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
   os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "KeptOutputRegion: " << m_KeptOutputRegion << std::endl;
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkLandweberDeconvolutionImageFilter_h
+#define itkVkLandweberDeconvolutionImageFilter_h
+
+#include "itkLandweberDeconvolutionImageFilter.h"
+#include "itkVkCommon.h"
+#include "itkVkDeconvolutionHelper.h"
+#include "itkVkGlobalConfiguration.h"
+
+namespace itk
+{
+/**
+ *\class VkLandweberDeconvolutionImageFilter
+ *
+ * \brief Vk-based Landweber deconvolution with device-resident iterations.
+ *
+ * This filter computes the same iterations as LandweberDeconvolutionImageFilter,
+ * but entirely on the device. As the Landweber iteration is linear, it advances
+ * the spectrum of the estimate by one device kernel per iteration, from the
+ * spectra of the padded input and the kernel, which are computed once with the
+ * same VkFFT plan. The estimate is only transformed back into the spatial domain
+ * when it is copied to the host and when the output is cropped out of it. Only
+ * the input, the kernel and the cropped output cross the bus.
+ *
+ * IterationEvent is invoked before each iteration, and SetStopIteration() ends
+ * the iterations early, as for LandweberDeconvolutionImageFilter. The current
+ * estimate is copied to the host before every CurrentEstimateInterval-th
+ * iteration only; by default it stays on the device.
+ *
+ * \ingroup FourierTransform
+ * \ingroup ITKDeconvolution
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkCommon::GetBoundaryCondition
+ * \sa VkGlobalConfiguration
+ * \sa LandweberDeconvolutionImageFilter
+ */
+template <typename TInputImage,
+          typename TKernelImage = TInputImage,
+          typename TOutputImage = TInputImage,
+          typename TInternalPrecision = double>
+class VkLandweberDeconvolutionImageFilter
+  : public LandweberDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkLandweberDeconvolutionImageFilter);
+
+  using InputImageType = TInputImage;
+  using KernelImageType = TKernelImage;
+  using OutputImageType = TOutputImage;
+  static_assert(std::is_same<TInternalPrecision, float>::value || std::is_same<TInternalPrecision, double>::value,
+                "Unsupported internal precision");
+  static_assert(TInputImage::ImageDimension >= 1 && TInputImage::ImageDimension <= 3, "Unsupported image dimension");
+
+  /** Standard class type aliases. */
+  using Self = VkLandweberDeconvolutionImageFilter;
+  using Superclass =
+    LandweberDeconvolutionImageFilter<InputImageType, KernelImageType, OutputImageType, TInternalPrecision>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using RealType = TInternalPrecision;
+  using InternalImageType = typename Superclass::InternalImageType;
+  using HelperType = VkDeconvolutionHelper<InputImageType, KernelImageType, OutputImageType, RealType>;
+  using BoundaryConditionEnum = VkCommon::BoundaryConditionEnum;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkLandweberDeconvolutionImageFilter, LandweberDeconvolutionImageFilter);
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in filters constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current filter settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+  /** Number of iterations between copies of the current estimate, over the padded
+   *  domain, to the host before IterationEvent. 0, the default, keeps the estimate
+   *  on the device until the output is cropped out of it, and GetCurrentEstimate()
+   *  returns nullptr during the iterations. */
+  itkSetMacro(CurrentEstimateInterval, unsigned int);
+  itkGetConstMacro(CurrentEstimateInterval, unsigned int);
+
+  /** Number of iterations completed, also when they run on the device. */
+  unsigned int
+  GetIteration() const override
+  {
+    return m_DeconvolvingOnDevice ? m_VkIteration : Superclass::GetIteration();
+  }
+
+  /** Boundary condition that the device generates for the boundary condition of
+   *  the filter, or NONE if it cannot generate it. */
+  BoundaryConditionEnum
+  GetVkBoundaryCondition() const
+  {
+    return VkCommon::GetBoundaryCondition(this->GetBoundaryCondition());
+  }
+
+protected:
+  VkLandweberDeconvolutionImageFilter();
+  ~VkLandweberDeconvolutionImageFilter() override = default;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool         m_UseVkGlobalConfiguration{ true };
+  uint64_t     m_DeviceID{ 0UL };
+  unsigned int m_CurrentEstimateInterval{ 0 };
+  unsigned int m_VkIteration{ 0 };
+  bool         m_DeconvolvingOnDevice{ false };
+
+  VkCommon m_VkCommon{};
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkLandweberDeconvolutionImageFilter.hxx"
+#endif
+
+#endif // itkVkLandweberDeconvolutionImageFilter_h
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkMaskedFFTNormalizedCorrelationImageFilter_h
+#define itkVkMaskedFFTNormalizedCorrelationImageFilter_h
+
+#include "itkImage.h"
+#include "itkMaskedFFTNormalizedCorrelationImageFilter.h"
+#include "itkVkCommon.h"
+#include "itkVkGlobalConfiguration.h"
+#include "itkVkImageDeviceBuffer.h"
+
+namespace itk
+{
+/**
+ *\class VkMaskedFFTNormalizedCorrelationImageFilter
+ *
+ * \brief Vk-based masked normalized cross-correlation of two images.
+ *
+ * This filter computes the same normalized cross-correlation as
+ * MaskedFFTNormalizedCorrelationImageFilter entirely on the device. The
+ * masked fixed and moving images, their squares and their masks are padded,
+ * the moving ones rotated, and transformed as one batch. The six products of
+ * their spectra that yield the local sums and the overlap are inverse
+ * transformed with the same plan, and combined into the correlation by device
+ * kernels. Only the images, the masks and the output cross the bus.
+ *
+ * Image pixels other than the output pixel type, in which the correlation is
+ * computed, and the masks are converted on the host.
+ *
+ * MaximumNumberOfOverlappingPixels is not updated by this filter.
+ *
+ * \ingroup FourierTransform
+ * \ingroup ITKConvolution
+ * \ingroup VkFFTBackend
+ *
+ * \sa VkGlobalConfiguration
+ * \sa MaskedFFTNormalizedCorrelationImageFilter
+ * \sa VkFFTNormalizedCorrelationImageFilter
+ */
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TMaskImage = Image<unsigned char, TInputImage::ImageDimension>>
+class VkMaskedFFTNormalizedCorrelationImageFilter
+  : public MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkMaskedFFTNormalizedCorrelationImageFilter);
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using MaskImageType = TMaskImage;
+  using RealType = typename OutputImageType::PixelType;
+  static_assert(std::is_same<RealType, float>::value || std::is_same<RealType, double>::value,
+                "Unsupported output pixel type");
+  static_assert(TInputImage::ImageDimension >= 1 && TInputImage::ImageDimension <= 3, "Unsupported image dimension");
+
+  /** Standard class type aliases. */
+  using Self = VkMaskedFFTNormalizedCorrelationImageFilter;
+  using Superclass = MaskedFFTNormalizedCorrelationImageFilter<InputImageType, OutputImageType, MaskImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using InputPixelType = typename InputImageType::PixelType;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using SizeType = typename InputImageType::SizeType;
+  using SizeValueType = typename InputImageType::SizeValueType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkMaskedFFTNormalizedCorrelationImageFilter, MaskedFFTNormalizedCorrelationImageFilter);
+
+  static constexpr unsigned int ImageDimension{ InputImageType::ImageDimension };
+
+  /** Determine whether local or global properties will be
+   *  referenced for setting up GPU acceleration.
+   *  Defaults to global so that the user can adjust default properties
+   *  in filters constructed through the ITK object factory. */
+  itkSetMacro(UseVkGlobalConfiguration, bool);
+  itkGetMacro(UseVkGlobalConfiguration, bool);
+
+  /** Local setting for enumerated GPU device to use for FFT.
+   *  Ignored if `UseVkGlobalConfiguration` is true. */
+  itkSetMacro(DeviceID, uint64_t);
+
+  /** Return the enumerated GPU device to use for FFT
+   *  according to current filter settings. */
+  uint64_t
+  GetDeviceID() const
+  {
+    return uint64_t{ m_UseVkGlobalConfiguration ? VkGlobalConfiguration::GetDeviceID() : m_DeviceID };
+  }
+
+protected:
+  VkMaskedFFTNormalizedCorrelationImageFilter() = default;
+  ~VkMaskedFFTNormalizedCorrelationImageFilter() override = default;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool     m_UseVkGlobalConfiguration{ true };
+  uint64_t m_DeviceID{ 0UL };
+
+  VkCommon m_VkCommon{};
+};
+
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkMaskedFFTNormalizedCorrelationImageFilter.hxx"
+#endif
+
+#endif // itkVkMaskedFFTNormalizedCorrelationImageFilter_h
@@ -0,0 +1,212 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkMaskedFFTNormalizedCorrelationImageFilter_hxx
+#define itkVkMaskedFFTNormalizedCorrelationImageFilter_hxx
+
+#include "itkVkMaskedFFTNormalizedCorrelationImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkMath.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+VkMaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateData()
+{
+  // get pointers to the images, the masks and the output
+  const InputImageType * const fixedImage{ this->GetFixedImage() };
+  const InputImageType * const movingImage{ this->GetMovingImage() };
+  const MaskImageType * const  fixedMask{ this->GetFixedImageMask() };
+  const MaskImageType * const  movingMask{ this->GetMovingImageMask() };
+  OutputImageType * const      output{ this->GetOutput() };
+  if (!fixedImage || !movingImage || !output)
+  {
+    return;
+  }
+
+  // we don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process
+  const ProgressReporter progress(this, 0, 1);
+
+  // allocate output buffer memory
+  const OutputImageRegionType & outputRegion{ output->GetLargestPossibleRegion() };
+  output->SetBufferedRegion(outputRegion);
+  output->Allocate();
+
+  // Pad both images with zeros to a size that VkFFT transforms and that is large enough for the
+  // correlation not to wrap around
+  const InputImageRegionType & fixedRegion{ fixedImage->GetLargestPossibleRegion() };
+  const InputImageRegionType & movingRegion{ movingImage->GetLargestPossibleRegion() };
+  itkAssertOrThrowMacro(fixedImage->GetBufferedRegion() == fixedRegion, "Fixed image region is not buffered");
+  itkAssertOrThrowMacro(movingImage->GetBufferedRegion() == movingRegion, "Moving image region is not buffered");
+  itkAssertOrThrowMacro(!fixedMask || fixedMask->GetBufferedRegion().GetSize() == fixedRegion.GetSize(),
+                        "Fixed image mask is of a different size");
+  itkAssertOrThrowMacro(!movingMask || movingMask->GetBufferedRegion().GetSize() == movingRegion.GetSize(),
+                        "Moving image mask is of a different size");
+  SizeType padSize;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    SizeValueType size{ fixedRegion.GetSize(dim) + movingRegion.GetSize(dim) - 1 };
+    while (Math::GreatestPrimeFactor(size) > m_VkCommon.GetGreatestPrimeFactor())
+    {
+      ++size;
+    }
+    padSize[dim] = size;
+  }
+
+  // VkFFT computes in the output pixel type, to which images of other pixel types and the masks
+  // are converted on the host. Images of the output pixel type are read from the device where
+  // they can be.
+  using InternalImageType = Image<RealType, ImageDimension>;
+  constexpr bool convertImages{ !std::is_same<InputPixelType, RealType>::value };
+  const auto     toInternal = [](const auto * image) {
+    typename InternalImageType::Pointer internalImage{ InternalImageType::New() };
+    internalImage->SetRegions(image->GetBufferedRegion());
+    internalImage->Allocate();
+    ImageAlgorithm::Copy(image, internalImage.GetPointer(), image->GetBufferedRegion(), image->GetBufferedRegion());
+    return internalImage;
+  };
+
+  const VkCommon::DeviceBufferPointer fixedGPUBuffer{
+    convertImages ? nullptr : VkImageDeviceBuffer<InputImageType>::GetInputBuffer(fixedImage, this->GetDeviceID())
+  };
+  const VkCommon::DeviceBufferPointer movingGPUBuffer{
+    convertImages ? nullptr : VkImageDeviceBuffer<InputImageType>::GetInputBuffer(movingImage, this->GetDeviceID())
+  };
+  typename InternalImageType::Pointer internalFixed;
+  typename InternalImageType::Pointer internalMoving;
+  const void *                        fixedCPUBuffer{ nullptr };
+  const void *                        movingCPUBuffer{ nullptr };
+  if (!fixedGPUBuffer)
+  {
+    if (convertImages)
+    {
+      internalFixed = toInternal(fixedImage);
+      fixedCPUBuffer = internalFixed->GetBufferPointer();
+    }
+    else
+    {
+      fixedCPUBuffer = fixedImage->GetBufferPointer();
+    }
+  }
+  if (!movingGPUBuffer)
+  {
+    if (convertImages)
+    {
+      internalMoving = toInternal(movingImage);
+      movingCPUBuffer = internalMoving->GetBufferPointer();
+    }
+    else
+    {
+      movingCPUBuffer = movingImage->GetBufferPointer();
+    }
+  }
+  const typename InternalImageType::Pointer internalFixedMask{ fixedMask ? toInternal(fixedMask) : nullptr };
+  const typename InternalImageType::Pointer internalMovingMask{ movingMask ? toInternal(movingMask) : nullptr };
+
+  VkCommon::DeviceBufferPointer outputGPUBuffer;
+  const bool deviceOutput{ VkImageDeviceBuffer<OutputImageType>::GetOutputBuffer(
+    output, this->GetDeviceID(), outputGPUBuffer) };
+
+  // Mostly use defaults for VkCommon::VkGPU
+  typename VkCommon::VkGPU vkGPU;
+  vkGPU.device_id = this->GetDeviceID();
+
+  // Describe this filter in VkCommon::VkParameters
+  typename VkCommon::VkParameters vkParameters;
+  if (ImageDimension > 0)
+    vkParameters.X = padSize[0];
+  if (ImageDimension > 1)
+    vkParameters.Y = padSize[1];
+  if (ImageDimension > 2)
+    vkParameters.Z = padSize[2];
+  if (std::is_same<RealType, float>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::FLOAT;
+  else if (std::is_same<RealType, double>::value)
+    vkParameters.P = VkCommon::PrecisionEnum::DOUBLE;
+  else
+    itkAssertOrThrowMacro(false, "Unsupported type for real numbers.");
+  vkParameters.fft = VkCommon::FFTEnum::R2HalfH;
+  vkParameters.PSize = sizeof(RealType);
+  vkParameters.I = VkCommon::DirectionEnum::FORWARD;
+  vkParameters.normalized = VkCommon::NormalizationEnum::NORMALIZED;
+  vkParameters.performNormalizedCorrelation = 1;
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    vkParameters.padInputSize[dim] = fixedRegion.GetSize(dim);
+    vkParameters.movingSize[dim] = movingRegion.GetSize(dim);
+    vkParameters.cropSize[dim] = outputRegion.GetSize(dim);
+  }
+
+  vkParameters.inputCPUBuffer = fixedCPUBuffer;
+  vkParameters.inputBufferBytes = fixedRegion.GetNumberOfPixels() * sizeof(RealType);
+  if (!fixedGPUBuffer && !internalFixed)
+  {
+    VkCommon::IdentifyInput(vkParameters, fixedImage);
+  }
+  vkParameters.inputGPUBuffer = fixedGPUBuffer;
+  vkParameters.movingCPUBuffer = movingCPUBuffer;
+  vkParameters.movingBufferBytes = movingRegion.GetNumberOfPixels() * sizeof(RealType);
+  vkParameters.movingGPUBuffer = movingGPUBuffer;
+  if (internalFixedMask)
+  {
+    vkParameters.inputMaskCPUBuffer = internalFixedMask->GetBufferPointer();
+  }
+  if (internalMovingMask)
+  {
+    vkParameters.movingMaskCPUBuffer = internalMovingMask->GetBufferPointer();
+  }
+  vkParameters.requiredOverlapFraction = static_cast<double>(this->GetRequiredFractionOfOverlappingPixels());
+  vkParameters.requiredOverlap = static_cast<uint64_t>(this->GetRequiredNumberOfOverlappingPixels());
+  vkParameters.outputCPUBuffer = output->GetBufferPointer();
+  vkParameters.outputBufferBytes = outputRegion.GetNumberOfPixels() * sizeof(RealType);
+  if (deviceOutput)
+  {
+    vkParameters.outputGPUBuffer = &outputGPUBuffer;
+  }
+
+  const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
+  if (resFFT != VKFFT_SUCCESS)
+  {
+    std::ostringstream mesg;
+    mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
+    itkAssertOrThrowMacro(false, mesg.str());
+  }
+  if (deviceOutput)
+  {
+    VkImageDeviceBuffer<OutputImageType>::SetOutputBuffer(output, outputGPUBuffer);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+VkMaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::PrintSelf(std::ostream & os,
+                                                                                                Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkMaskedFFTNormalizedCorrelationImageFilter_hxx
@@ -22,7 +22,10 @@
 
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkFFTDiscreteGaussianImageFilter.h"
+#include "itkVkDiscreteGaussianImageFilter.h"
+#include "itkVkFFTDiscreteGaussianImageFilter.h"
 #include "itkVector.h"
+#include "itkVkGlobalConfiguration.h"
 #include "itkMacro.h"
 #include "VkFFTBackendExport.h"
 
@@ -46,7 +49,10 @@ namespace itk
  * increasing kernel size. By contrast ITK FFT convolution accelerated
  * with a VkFFT GPU backend scales slowly with increasing kernel size
  * but is typically outperformed by spatial convolution filters
- * for small kernel sizes.
+ * for small kernel sizes. Up to three dimensions, FFT smoothing is
+ * computed by VkFFTDiscreteGaussianImageFilter, which evaluates the
+ * Gaussian transfer function on the device instead of transforming
+ * a kernel image.
  *
  * VkMultiResolutionPyramidImageFilter allows the user to fix the
  * metric threshold at which a performance tradeoff is expected
@@ -54,6 +60,26 @@ namespace itk
  * on user hardware and can be estimated through benchmarking with
  * scripts in the ITKVkFFTBackend repository.
  *
+ * With ShareInputSpectrum on, the levels smoothed through the FFT up to
+ * three dimensions share a single forward transform of the input: its
+ * spectrum stays on the device, and each level only applies its own
+ * transfer function and the inverse transform.
+ *
+ * With SpectralDecimation and UseShrinkImageFilter on, the levels smoothed
+ * through the FFT up to three dimensions are shrunk in the frequency domain:
+ * the smoothed spectrum is folded into the spectrum of the level, and only
+ * the level is transformed back. The smoothed input at full resolution is
+ * neither computed nor allocated for them.
+ *
+ * With ConcurrentLevels on, the levels smoothed through the FFT are
+ * generated on a thread of their own while the CPU smooths the other levels,
+ * so that the device and the CPU work at the same time.
+ *
+ * With GenerateLevelsOnDemand on, updating the output of a level generates
+ * that level only, and the other outputs hold no memory until they are
+ * updated themselves. Update() and UpdateLargestPossibleRegion() of the
+ * filter still generate all levels.
+ *
  * By mitigating blurring times on levels with large kernel sizes
  * VkMultiResolutionPyramidImageFilter has been observed to run in
  * as little as 50% of the time of its base class.
@@ -64,6 +90,7 @@ namespace itk
  * \sa MultiResolutionPyramidImageFilter
  * \sa DiscreteGaussianImageFilter
  * \sa FFTDiscreteGaussianImageFilter
+ * \sa VkFFTDiscreteGaussianImageFilter
  * \sa ShrinkImageFilter
  *
  * \ingroup VkFFTBackend
@@ -109,8 +136,20 @@ public:
   /** Types for acceleration.
    *  Assumes and does not verify that FFT backend is accelerated. */
   using BaseSmootherType = DiscreteGaussianImageFilter<OutputImageType, OutputImageType>;
-  using SpatialSmootherType = DiscreteGaussianImageFilter<OutputImageType, OutputImageType>;
-  using FFTSmootherType = FFTDiscreteGaussianImageFilter<OutputImageType, OutputImageType>;
+  /** The spatial smoother is fixed to smoothing on the CPU, so that a factory override of
+   *  DiscreteGaussianImageFilter does not choose again for the levels. */
+  using SpatialSmootherType = VkDiscreteGaussianImageFilter<OutputImageType, OutputImageType>;
+  using FFTSmootherType =
+    typename std::conditional<ImageDimension <= 3,
+                              VkFFTDiscreteGaussianImageFilter<OutputImageType, OutputImageType>,
+                              FFTDiscreteGaussianImageFilter<OutputImageType, OutputImageType>>::type;
+
+  /** Up to three dimensions the FFT smoother of the levels reads the input itself, so that
+   *  integer input pixels are converted on the device rather than cast on the host. */
+  using LevelFFTSmootherType =
+    typename std::conditional<ImageDimension <= 3,
+                              VkFFTDiscreteGaussianImageFilter<InputImageType, OutputImageType>,
+                              FFTSmootherType>::type;
 
   /** Set the metric threshold to decide between
    *  accelerated methods such as CPU-based separable smoothing
@@ -139,6 +178,9 @@ public:
    *  and may need to be adjusted to better match benchmarking results for
    *  particular hardware and expected image sizes so that nuances such as
    *  multithreading and GPU performance may be taken into account.
+   *
+   *  CalibrateSmoothing measures the tradeoff on the current device and
+   *  number of threads instead, and GetUseFFT then consults its cost model.
    */
   itkSetMacro(MetricThreshold, float);
   itkGetMacro(MetricThreshold, float);
@@ -165,12 +207,71 @@ public:
   GetVariance(unsigned int ilevel) const;
 
   /** Get whether FFT smoothing will be used for the given
-   *  pyramid level */
+   *  pyramid level. If UseSmoothingCostModel is on and VkGlobalConfiguration
+   *  holds a cost model of the device benchmarked with the current global
+   *  default number of threads, the smoothing with the lower predicted time
+   *  is chosen. Otherwise the metric is compared to the metric threshold. */
   bool
   GetUseFFT(const KernelSizeType & kernelRadius) const;
 
+  /** Consult the smoothing cost model of the device when it is available.
+   *  On by default. */
+  itkSetMacro(UseSmoothingCostModel, bool);
+  itkGetConstMacro(UseSmoothingCostModel, bool);
+  itkBooleanMacro(UseSmoothingCostModel);
+
+  /** Generate only the level whose output is updated, instead of all levels. Each level
+   *  depends on the input only, so that the other outputs are released rather than
+   *  computed; they are generated when they are updated themselves. Update() and
+   *  UpdateLargestPossibleRegion() of the filter generate all levels. Off by default. */
+  itkSetMacro(GenerateLevelsOnDemand, bool);
+  itkGetConstMacro(GenerateLevelsOnDemand, bool);
+  itkBooleanMacro(GenerateLevelsOnDemand);
+
+  /** Update all levels, also when they are generated on demand. */
+  void
+  Update() override;
+  void
+  UpdateLargestPossibleRegion() override;
+
+  /** Remember which level is updated before the pipeline generates it. */
+  void
+  UpdateOutputData(DataObject * output) override;
+
+  /** Benchmark spatial and FFT smoothing of images of the output type over a grid of
+   *  image sizes and variances with the current global default number of threads and
+   *  the device of VkGlobalConfiguration, fit their cost model, and store it in
+   *  VkGlobalConfiguration for the device. The cost model can be written to a file
+   *  with VkGlobalConfiguration::WriteSmoothingCostModels and read by later
+   *  processes instead of calibrating again. */
+  void
+  CalibrateSmoothing();
+
+  /** Compute the forward transform of the input once for all the levels smoothed
+   *  through the FFT, pad it by the largest of their kernel radii, and keep its
+   *  spectrum on the device while the levels are generated. Applies up to three
+   *  dimensions and is off by default. */
+  itkSetMacro(ShareInputSpectrum, bool);
+  itkGetConstMacro(ShareInputSpectrum, bool);
+  itkBooleanMacro(ShareInputSpectrum);
+
+  /** Shrink the levels smoothed through the FFT in the frequency domain instead of
+   *  smoothing the input at full resolution and shrinking it with ShrinkImageFilter.
+   *  Applies with UseShrinkImageFilter up to three dimensions and is off by default. */
+  itkSetMacro(SpectralDecimation, bool);
+  itkGetConstMacro(SpectralDecimation, bool);
+  itkBooleanMacro(SpectralDecimation);
+
+  /** Generate the levels smoothed through the FFT asynchronously while the levels
+   *  smoothed spatially are generated, and graft them once they complete. The cast
+   *  input is computed first and both paths read it, except for the FFT smoother up to
+   *  three dimensions, which reads the input. Off by default. */
+  itkSetMacro(ConcurrentLevels, bool);
+  itkGetConstMacro(ConcurrentLevels, bool);
+  itkBooleanMacro(ConcurrentLevels);
+
 protected:
-  VkMultiResolutionPyramidImageFilter() = default;
+  VkMultiResolutionPyramidImageFilter();
   ~VkMultiResolutionPyramidImageFilter() override = default;
 
   /** Generate the output data. */
@@ -181,9 +282,76 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Estimate the kernel radius for a variance in pixels */
+  KernelSizeType
+  ComputeKernelRadius(const VarianceType & variance) const;
+
+  /** Terms of the smoothing cost model for an image size and kernel radius: the pixels,
+   *  the kernel taps summed over the dimensions and the padded samples of FFT smoothing */
+  static void
+  ComputeSmoothingTerms(const InputSizeType &  size,
+                        const KernelSizeType & kernelRadius,
+                        double &               pixels,
+                        double &               taps,
+                        double &               paddedSamples);
+
+  /** Smooth the input for the given level, with the FFT or the spatial smoother, and
+   *  shrink it. The spatial smoother reads the cast input, and so does the FFT smoother
+   *  in four dimensions. Returns the level to graft onto the output. */
+  OutputImagePointer
+  GenerateLevel(unsigned int            ilevel,
+                const InputImageType *  input,
+                const OutputImageType * castInput,
+                bool                    useFFT,
+                bool                    spectralDecimation);
+
+  /** Run an update of the filter as a whole, which generates all levels also on demand. */
+  template <typename TUpdate>
+  void
+  UpdateAllLevels(const TUpdate & update);
+
+  /** Select the image that the FFT smoother of the levels reads. */
+  static const InputImageType *
+  GetFFTSmootherInput(const InputImageType * input, const OutputImageType *, std::true_type)
+  {
+    return input;
+  }
+  static const OutputImageType *
+  GetFFTSmootherInput(const InputImageType *, const OutputImageType * castInput, std::false_type)
+  {
+    return castInput;
+  }
+
+  /** Configure the FFT smoother to keep the spectrum of its input for the given
+   *  padding radius and multiple, or release it. Only the Vk smoother can share
+   *  its spectrum. */
+  void
+  ShareSmootherInputSpectrum(bool                   share,
+                             const KernelSizeType & padRadius,
+                             const KernelSizeType & padMultiple,
+                             std::true_type);
+  void
+  ShareSmootherInputSpectrum(bool, const KernelSizeType &, const KernelSizeType &, std::false_type)
+  {}
+
+  /** Set the factors by which the FFT smoother shrinks its output. Only the Vk
+   *  smoother shrinks. */
+  void
+  SetSmootherShrinkFactors(const unsigned int factors[ImageDimension], std::true_type);
+  void
+  SetSmootherShrinkFactors(const unsigned int[ImageDimension], std::false_type)
+  {}
+
   float                              m_MetricThreshold = 8.0f;
+  bool                               m_ShareInputSpectrum = false;
+  bool                               m_SpectralDecimation = false;
+  bool                               m_ConcurrentLevels = false;
+  bool                               m_UseSmoothingCostModel = true;
+  bool                               m_GenerateLevelsOnDemand = false;
+  unsigned int                       m_DemandedLevel = 0;
+  bool                               m_DemandAllLevels = false;
   typename SpatialSmootherType::Pointer spatialSmoother = SpatialSmootherType::New();
-  typename FFTSmootherType::Pointer              fftSmoother = FFTSmootherType::New();
+  typename LevelFFTSmootherType::Pointer fftSmoother = LevelFFTSmootherType::New();
 
 };
 } // namespace itk
@@ -25,11 +25,27 @@
 #include "itkResampleImageFilter.h"
 #include "itkShrinkImageFilter.h"
 #include "itkIdentityTransform.h"
+#include "itkImageRegionIterator.h"
+#include "itkMultiThreaderBase.h"
+#include "vnl/algo/vnl_svd.h"
 
 #include "itkMath.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <vector>
+
 namespace itk
 {
+template <typename TInputImage, typename TOutputImage>
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::VkMultiResolutionPyramidImageFilter()
+{
+  spatialSmoother->SetSmoothing(SpatialSmootherType::SmoothingEnum::SPATIAL);
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateData()
@@ -39,97 +55,339 @@ VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateData()
   // Get the input and output pointers
   InputImageConstPointer inputPtr = this->GetInput();
 
-  // Create caster, smoother and resampleShrinker filters
+  // Create the caster that the smoothers read, other than the Vk smoother, which converts the
+  // input on the device. The caster only runs when a level reads it.
   using CasterType = CastImageFilter<TInputImage, TOutputImage>;
+  auto caster = CasterType::New();
+  caster->SetInput(inputPtr);
 
-  using ImageToImageType = ImageToImageFilter<TOutputImage, TOutputImage>;
-  using ResampleShrinkerType = ResampleImageFilter<TOutputImage, TOutputImage>;
-  using ShrinkerType = ShrinkImageFilter<TOutputImage, TOutputImage>;
+  unsigned int ilevel, idim;
 
-  auto                               caster = CasterType::New();
-  typename BaseSmootherType::Pointer smoother;
+  // Levels smoothed through the FFT by the Vk smoother can be shrunk in the frequency domain
+  using VkSmootherType = std::integral_constant<bool, (ImageDimension <= 3)>;
+  const bool spectralDecimation = m_SpectralDecimation && VkSmootherType::value && this->GetUseShrinkImageFilter();
 
-  typename ImageToImageType::Pointer shrinkerFilter;
-  //
-  // only one of these pointers is going to be valid, depending on the
-  // value of UseShrinkImageFilter flag
-  typename ResampleShrinkerType::Pointer resampleShrinker;
-  typename ShrinkerType::Pointer         shrinker;
-
-  if (this->GetUseShrinkImageFilter())
+  // Each level only depends on the input, so that on demand only the level whose output is
+  // updated is generated. The other outputs are released.
+  std::vector<bool> generate(this->m_NumberOfLevels, true);
+  if (m_GenerateLevelsOnDemand && m_DemandedLevel < this->m_NumberOfLevels)
   {
-    shrinker = ShrinkerType::New();
-    shrinkerFilter = shrinker.GetPointer();
+    std::fill(generate.begin(), generate.end(), false);
+    generate[m_DemandedLevel] = true;
   }
-  else
+
+  // select spatial or FFT smoothing for each level based on user threshold settings
+  // to maximize anticipated performance
+  std::vector<bool> useFFT(this->m_NumberOfLevels);
+  bool              anyFFT = false;
+  bool              anySpatial = false;
+  for (ilevel = 0; ilevel < this->m_NumberOfLevels; ++ilevel)
   {
-    resampleShrinker = ResampleShrinkerType::New();
-    using LinearInterpolatorType = itk::LinearInterpolateImageFunction<OutputImageType, double>;
-    auto interpolator = LinearInterpolatorType::New();
-    resampleShrinker->SetInterpolator(interpolator);
-    resampleShrinker->SetDefaultPixelValue(0);
-    shrinkerFilter = resampleShrinker.GetPointer();
+    useFFT[ilevel] = generate[ilevel] && GetUseFFT(this->GetKernelRadius(ilevel));
+    anyFFT = anyFFT || useFFT[ilevel];
+    anySpatial = anySpatial || (generate[ilevel] && !useFFT[ilevel]);
   }
-  // Setup the filters
-  caster->SetInput(inputPtr);
 
-  unsigned int ilevel, idim;
-  unsigned int factors[ImageDimension];
-  VarianceType variance;
+  // Pad the input once by the largest kernel radius of the levels smoothed through the FFT, and
+  // to a common multiple of their shrink factors if they are decimated, so that they all share
+  // the spectrum of the input
+  bool           shareInputSpectrum = false;
+  KernelSizeType padRadius;
+  KernelSizeType padMultiple;
+  padRadius.Fill(0);
+  padMultiple.Fill(1);
+  if (m_ShareInputSpectrum)
+  {
+    for (ilevel = 0; ilevel < this->m_NumberOfLevels; ++ilevel)
+    {
+      if (useFFT[ilevel])
+      {
+        shareInputSpectrum = true;
+        const KernelSizeType radius = this->GetKernelRadius(ilevel);
+        for (idim = 0; idim < ImageDimension; ++idim)
+        {
+          padRadius[idim] = std::max(padRadius[idim], radius[idim]);
+          const auto factor = static_cast<SizeValueType>(this->m_Schedule[ilevel][idim]);
+          if (spectralDecimation && factor > 0)
+          {
+            const SizeValueType multiple = padMultiple[idim];
+            while (padMultiple[idim] % factor != 0)
+            {
+              padMultiple[idim] += multiple;
+            }
+          }
+        }
+      }
+    }
+  }
+  this->ShareSmootherInputSpectrum(shareInputSpectrum, padRadius, padMultiple, VkSmootherType{});
 
+  // Allocate memory for each generated output
   for (ilevel = 0; ilevel < this->m_NumberOfLevels; ++ilevel)
   {
-    this->UpdateProgress(static_cast<float>(ilevel) / static_cast<float>(this->m_NumberOfLevels));
-
-    // Allocate memory for each output
+    if (!generate[ilevel])
+    {
+      this->GetOutput(ilevel)->Initialize();
+      continue;
+    }
     OutputImagePointer outputPtr = this->GetOutput(ilevel);
     outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
     outputPtr->Allocate();
+  }
+
+  if (m_ConcurrentLevels && anyFFT && anySpatial)
+  {
+    // The caster is updated once, and each path reads its own graft of the input and of its
+    // output, so that the pipeline is not updated from two threads
+    caster->UpdateLargestPossibleRegion();
+    auto fftInput = InputImageType::New();
+    fftInput->Graft(inputPtr);
+    auto fftCastInput = OutputImageType::New();
+    fftCastInput->Graft(caster->GetOutput());
+    auto spatialInput = OutputImageType::New();
+    spatialInput->Graft(caster->GetOutput());
 
-    // compute shrink factors
-    for (idim = 0; idim < ImageDimension; ++idim)
+    // The device smooths its levels one after the other while the CPU smooths the others
+    std::future<std::vector<OutputImagePointer>> fftLevels =
+      std::async(std::launch::async, [this, &useFFT, &fftInput, &fftCastInput, spectralDecimation]() {
+        std::vector<OutputImagePointer> levels(this->m_NumberOfLevels);
+        for (unsigned int level = 0; level < this->m_NumberOfLevels; ++level)
+        {
+          if (useFFT[level])
+          {
+            levels[level] = this->GenerateLevel(level, fftInput, fftCastInput, true, spectralDecimation);
+          }
+        }
+        return levels;
+      });
+
+    for (ilevel = 0; ilevel < this->m_NumberOfLevels; ++ilevel)
     {
-      factors[idim] = this->m_Schedule[ilevel][idim];
+      if (generate[ilevel] && !useFFT[ilevel])
+      {
+        this->UpdateProgress(static_cast<float>(ilevel) / static_cast<float>(this->m_NumberOfLevels));
+        this->GraftNthOutput(ilevel, this->GenerateLevel(ilevel, nullptr, spatialInput, false, false));
+      }
     }
-
-    if (!this->GetUseShrinkImageFilter())
+    const std::vector<OutputImagePointer> levels = fftLevels.get();
+    for (ilevel = 0; ilevel < this->m_NumberOfLevels; ++ilevel)
     {
-      using IdentityTransformType = itk::IdentityTransform<double, OutputImageType::ImageDimension>;
-      auto identityTransform = IdentityTransformType::New();
-      resampleShrinker->SetOutputParametersFromImage(outputPtr);
-      resampleShrinker->SetTransform(identityTransform);
+      if (useFFT[ilevel])
+      {
+        this->GraftNthOutput(ilevel, levels[ilevel]);
+      }
     }
-    else
+  }
+  else
+  {
+    for (ilevel = 0; ilevel < this->m_NumberOfLevels; ++ilevel)
     {
-      shrinker->SetShrinkFactors(factors);
+      if (generate[ilevel])
+      {
+        this->UpdateProgress(static_cast<float>(ilevel) / static_cast<float>(this->m_NumberOfLevels));
+        this->GraftNthOutput(
+          ilevel, this->GenerateLevel(ilevel, inputPtr, caster->GetOutput(), useFFT[ilevel], spectralDecimation));
+      }
     }
+  }
+
+  if (shareInputSpectrum)
+  {
+    padRadius.Fill(0);
+    padMultiple.Fill(1);
+    this->ShareSmootherInputSpectrum(false, padRadius, padMultiple, VkSmootherType{});
+  }
+}
 
-    // select spatial or FFT smoothing based on user threshold settings
-    // to maximize anticipated performance
-    if (GetUseFFT(this->GetKernelRadius(ilevel)))
+template <typename TInputImage, typename TOutputImage>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::Update()
+{
+  this->UpdateAllLevels([this]() { Superclass::Update(); });
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::UpdateLargestPossibleRegion()
+{
+  this->UpdateAllLevels([this]() { Superclass::UpdateLargestPossibleRegion(); });
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TUpdate>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::UpdateAllLevels(const TUpdate & update)
+{
+  // The pipeline updates the filter through its first output. When an earlier update generated
+  // some levels only, the first output may be current while others are released, so that it is
+  // released as well for the filter to run again.
+  if (m_GenerateLevelsOnDemand)
+  {
+    for (unsigned int ilevel = 0; ilevel < this->m_NumberOfLevels; ++ilevel)
     {
-      smoother = static_cast<BaseSmootherType *>(fftSmoother);
+      if (this->GetOutput(ilevel)->GetBufferedRegion().GetNumberOfPixels() == 0)
+      {
+        this->GetOutput(0)->ReleaseData();
+        break;
+      }
     }
-    else
+  }
+
+  m_DemandAllLevels = true;
+  try
+  {
+    update();
+  }
+  catch (...)
+  {
+    m_DemandAllLevels = false;
+    throw;
+  }
+  m_DemandAllLevels = false;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * output)
+{
+  // Remember the level whose output is updated, or all levels for an update of the filter as a
+  // whole and for other data objects
+  m_DemandedLevel = this->m_NumberOfLevels;
+  for (unsigned int ilevel = 0; ilevel < this->m_NumberOfLevels && !m_DemandAllLevels; ++ilevel)
+  {
+    if (output == this->GetOutput(ilevel))
     {
-      smoother = static_cast<BaseSmootherType *>(spatialSmoother);
+      m_DemandedLevel = ilevel;
     }
+  }
+  Superclass::UpdateOutputData(output);
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateLevel(
+  unsigned int            ilevel,
+  const InputImageType *  input,
+  const OutputImageType * castInput,
+  bool                    useFFT,
+  bool                    spectralDecimation) -> OutputImagePointer
+{
+  using ImageToImageType = ImageToImageFilter<TOutputImage, TOutputImage>;
+  using ResampleShrinkerType = ResampleImageFilter<TOutputImage, TOutputImage>;
+  using ShrinkerType = ShrinkImageFilter<TOutputImage, TOutputImage>;
+  using VkSmootherType = std::integral_constant<bool, (ImageDimension <= 3)>;
 
-    // Set up smoothing filter
+  OutputImagePointer outputPtr = this->GetOutput(ilevel);
+
+  // compute shrink factors
+  unsigned int factors[ImageDimension];
+  for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+  {
+    factors[idim] = this->m_Schedule[ilevel][idim];
+  }
+
+  // Set up smoothing filter. The FFT smoother may read the input rather than the cast input.
+  const auto setUpSmoother = [this, ilevel](auto * smoother, const auto * smootherInput) {
     smoother->SetUseImageSpacing(false);
-    smoother->SetInput(caster->GetOutput());
+    smoother->SetInput(smootherInput);
     smoother->SetMaximumError(this->m_MaximumError);
-    variance = this->GetVariance(ilevel);
-    smoother->SetVariance(variance);
-    shrinkerFilter->SetInput(smoother->GetOutput());
+    smoother->SetVariance(this->GetVariance(ilevel));
+  };
+  typename ImageSource<OutputImageType>::Pointer smoother;
+  if (useFFT)
+  {
+    setUpSmoother(fftSmoother.GetPointer(), GetFFTSmootherInput(input, castInput, VkSmootherType{}));
+    smoother = fftSmoother.GetPointer();
+  }
+  else
+  {
+    setUpSmoother(spatialSmoother.GetPointer(), castInput);
+    smoother = spatialSmoother.GetPointer();
+  }
 
-    shrinkerFilter->GraftOutput(outputPtr);
+  // The FFT smoother shrinks the level itself in the frequency domain. The level is grafted
+  // onto an image of its own, since the smoother output is grafted onto the next level.
+  if (useFFT)
+  {
+    unsigned int smootherFactors[ImageDimension];
+    for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+    {
+      smootherFactors[idim] = spectralDecimation ? factors[idim] : 1;
+    }
+    this->SetSmootherShrinkFactors(smootherFactors, VkSmootherType{});
+    if (spectralDecimation)
+    {
+      smoother->GraftOutput(outputPtr);
+      smoother->Modified();
+      smoother->UpdateLargestPossibleRegion();
+      OutputImagePointer level = OutputImageType::New();
+      level->Graft(smoother->GetOutput());
+      return level;
+    }
+  }
 
-    // force to always update in case shrink factors are the same
-    shrinkerFilter->Modified();
-    shrinkerFilter->UpdateLargestPossibleRegion();
-    this->GraftNthOutput(ilevel, shrinkerFilter->GetOutput());
+  // only one of these filters is created, depending on the
+  // value of UseShrinkImageFilter flag
+  typename ImageToImageType::Pointer shrinkerFilter;
+  if (this->GetUseShrinkImageFilter())
+  {
+    auto shrinker = ShrinkerType::New();
+    shrinker->SetShrinkFactors(factors);
+    shrinkerFilter = shrinker.GetPointer();
+  }
+  else
+  {
+    auto resampleShrinker = ResampleShrinkerType::New();
+    using LinearInterpolatorType = itk::LinearInterpolateImageFunction<OutputImageType, double>;
+    auto interpolator = LinearInterpolatorType::New();
+    resampleShrinker->SetInterpolator(interpolator);
+    resampleShrinker->SetDefaultPixelValue(0);
+    using IdentityTransformType = itk::IdentityTransform<double, OutputImageType::ImageDimension>;
+    auto identityTransform = IdentityTransformType::New();
+    resampleShrinker->SetOutputParametersFromImage(outputPtr);
+    resampleShrinker->SetTransform(identityTransform);
+    shrinkerFilter = resampleShrinker.GetPointer();
+  }
+
+  shrinkerFilter->SetInput(smoother->GetOutput());
+
+  shrinkerFilter->GraftOutput(outputPtr);
+
+  // force to always update in case shrink factors are the same
+  shrinkerFilter->Modified();
+  shrinkerFilter->UpdateLargestPossibleRegion();
+  return shrinkerFilter->GetOutput();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::ShareSmootherInputSpectrum(
+  bool                   share,
+  const KernelSizeType & padRadius,
+  const KernelSizeType & padMultiple,
+  std::true_type)
+{
+  fftSmoother->SetMinimumPadRadius(padRadius);
+  fftSmoother->SetPadMultiple(padMultiple);
+  fftSmoother->SetShareInputSpectrum(share);
+  if (!share)
+  {
+    fftSmoother->ReleaseInputSpectrum();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::SetSmootherShrinkFactors(
+  const unsigned int factors[ImageDimension],
+  std::true_type)
+{
+  typename LevelFFTSmootherType::ShrinkFactorsType shrinkFactors;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    shrinkFactors[dim] = factors[dim];
   }
+  fftSmoother->SetShrinkFactors(shrinkFactors);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -138,16 +396,7 @@ VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::ComputeMetricVal
   const InputSizeType &  inputSize,
   const KernelSizeType & kernelRadius) const
 {
-  unsigned int totalKernelSize = 0;
-  float        metricValue = 1.0f;
-  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
-  {
-    totalKernelSize += kernelRadius[dim] * 2 + 1;
-    metricValue *= inputSize[dim];
-  }
-  metricValue *= totalKernelSize;
-  metricValue = std::log10(metricValue);
-  return metricValue;
+  return SpatialSmootherType::ComputeMetricValue(inputSize, kernelRadius);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -155,24 +404,144 @@ bool
 VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GetUseFFT(const KernelSizeType & kernelRadius) const
 {
   auto requestedSize = this->GetInput()->GetRequestedRegion().GetSize();
+
+  // Prefer the predictions of the cost model of the device, if it was calibrated with as many threads
+  VkGlobalConfiguration::SmoothingCostModel model;
+  if (m_UseSmoothingCostModel &&
+      VkGlobalConfiguration::GetSmoothingCostModel(VkGlobalConfiguration::GetDeviceID(), model) &&
+      model.numberOfWorkUnits == MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+  {
+    double pixels, taps, paddedSamples;
+    ComputeSmoothingTerms(requestedSize, kernelRadius, pixels, taps, paddedSamples);
+    return model.PredictFFT(pixels, paddedSamples) < model.PredictSpatial(pixels, taps);
+  }
+
   auto metricValue = this->ComputeMetricValue(requestedSize, kernelRadius);
   return metricValue > m_MetricThreshold;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::ComputeSmoothingTerms(
+  const InputSizeType &  size,
+  const KernelSizeType & kernelRadius,
+  double &               pixels,
+  double &               taps,
+  double &               paddedSamples)
+{
+  SpatialSmootherType::ComputeSmoothingTerms(size, kernelRadius, pixels, taps, paddedSamples);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::CalibrateSmoothing()
+{
+  using ClockType = std::chrono::steady_clock;
+  constexpr unsigned int repetitions = 3;
+
+  // Best of a few runs of a smoother, after a first run that initializes it
+  const auto timeSmoother = [](BaseSmootherType * smoother) {
+    smoother->Update();
+    double seconds = std::numeric_limits<double>::max();
+    for (unsigned int repetition = 0; repetition < repetitions; ++repetition)
+    {
+      smoother->Modified();
+      const auto start = ClockType::now();
+      smoother->Update();
+      seconds = std::min(seconds, std::chrono::duration<double>(ClockType::now() - start).count());
+    }
+    return seconds;
+  };
+
+  // Benchmark both smoothers over a grid of image sizes and variances
+  const std::vector<double> pixelCounts{ 1 << 12, 1 << 15, 1 << 18 };
+  const std::vector<double> variances{ 1.0, 4.0, 16.0, 64.0 };
+  const unsigned int        numberOfRuns = pixelCounts.size() * variances.size();
+  vnl_matrix<double>        spatialTerms(numberOfRuns, 3);
+  vnl_matrix<double>        fftTerms(numberOfRuns, 3);
+  vnl_vector<double>        spatialSeconds(numberOfRuns);
+  vnl_vector<double>        fftSeconds(numberOfRuns);
+  unsigned int              run = 0;
+  for (const double pixelCount : pixelCounts)
+  {
+    OutputSizeType size;
+    size.Fill(std::max<SizeValueType>(
+      8, static_cast<SizeValueType>(std::round(std::pow(pixelCount, 1.0 / static_cast<double>(ImageDimension))))));
+    auto image = OutputImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+    SizeValueType value = 0;
+    for (ImageRegionIterator<OutputImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<OutputPixelType>(value++ % 251));
+    }
+
+    for (const double variance : variances)
+    {
+      VarianceType varianceVector;
+      varianceVector.Fill(variance);
+      double pixels, taps, paddedSamples;
+      ComputeSmoothingTerms(size, this->ComputeKernelRadius(varianceVector), pixels, taps, paddedSamples);
+
+      auto spatial = SpatialSmootherType::New();
+      spatial->SetSmoothing(SpatialSmootherType::SmoothingEnum::SPATIAL);
+      auto fft = FFTSmootherType::New();
+      for (BaseSmootherType * smoother :
+           { static_cast<BaseSmootherType *>(spatial.GetPointer()), static_cast<BaseSmootherType *>(fft.GetPointer()) })
+      {
+        smoother->SetUseImageSpacing(false);
+        smoother->SetInput(image);
+        smoother->SetMaximumError(this->m_MaximumError);
+        smoother->SetVariance(varianceVector);
+      }
+      spatialTerms(run, 0) = pixels * taps;
+      spatialTerms(run, 1) = pixels;
+      spatialTerms(run, 2) = 1.0;
+      spatialSeconds(run) = timeSmoother(spatial);
+      fftTerms(run, 0) = paddedSamples * std::log2(paddedSamples);
+      fftTerms(run, 1) = pixels;
+      fftTerms(run, 2) = 1.0;
+      fftSeconds(run) = timeSmoother(fft);
+      ++run;
+    }
+  }
+
+  // Least-squares fit of the cost model
+  const vnl_vector<double>                  spatialCoefficients = vnl_svd<double>(spatialTerms).solve(spatialSeconds);
+  const vnl_vector<double>                  fftCoefficients = vnl_svd<double>(fftTerms).solve(fftSeconds);
+  VkGlobalConfiguration::SmoothingCostModel model;
+  for (unsigned int term = 0; term < 3; ++term)
+  {
+    model.spatialCoefficients[term] = spatialCoefficients[term];
+    model.fftCoefficients[term] = fftCoefficients[term];
+  }
+  model.numberOfWorkUnits = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  VkGlobalConfiguration::SetSmoothingCostModel(VkGlobalConfiguration::GetDeviceID(), model);
+  this->Modified();
+}
+
 template <typename TInputImage, typename TOutputImage>
 typename VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::KernelSizeType
 VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GetKernelRadius(unsigned int ilevel) const
+{
+  return this->ComputeKernelRadius(this->GetVariance(ilevel));
+}
+
+template <typename TInputImage, typename TOutputImage>
+typename VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::KernelSizeType
+VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::ComputeKernelRadius(
+  const VarianceType & variance) const
 {
   using OperatorType = itk::GaussianOperator<OutputPixelType, ImageDimension>;
-  auto *         oper = new OperatorType;
+  OperatorType   oper;
   KernelSizeType radius;
   for (unsigned int dim = 0; dim < ImageDimension; ++dim)
   {
-    oper->SetDirection(dim);
-    oper->SetMaximumError(this->m_MaximumError);
-    oper->SetVariance(this->GetVariance(ilevel)[dim]);
-    oper->CreateDirectional();
-    radius[dim] = oper->GetRadius()[dim];
+    oper.SetDirection(dim);
+    oper.SetMaximumError(this->m_MaximumError);
+    oper.SetVariance(variance[dim]);
+    oper.CreateDirectional();
+    radius[dim] = oper.GetRadius()[dim];
   }
   return radius;
 }
@@ -199,6 +568,11 @@ VkMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::PrintSelf(std::o
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Kernel/image size metric threshold: " << m_MetricThreshold << std::endl;
+  os << indent << "ShareInputSpectrum: " << m_ShareInputSpectrum << std::endl;
+  os << indent << "SpectralDecimation: " << m_SpectralDecimation << std::endl;
+  os << indent << "ConcurrentLevels: " << m_ConcurrentLevels << std::endl;
+  os << indent << "UseSmoothingCostModel: " << m_UseSmoothingCostModel << std::endl;
+  os << indent << "GenerateLevelsOnDemand: " << m_GenerateLevelsOnDemand << std::endl;
 }
 } // namespace itk
 
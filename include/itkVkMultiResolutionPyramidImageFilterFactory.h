@@ -21,6 +21,7 @@
 #include "VkFFTBackendExport.h"
 
 #include "itkVkMultiResolutionPyramidImageFilter.h"
+#include "itkVkRecursiveMultiResolutionPyramidImageFilter.h"
 #include "itkImage.h"
 #include "itkObjectFactoryBase.h"
 #include "itkVersion.h"
@@ -31,10 +32,13 @@ namespace itk
  *
  * \brief Object Factory implementation for overriding
  *  MultiResolutionPyramidImageFilterFactory with VkMultiResolutionPyramidImageFilterFactory
+ *  and RecursiveMultiResolutionPyramidImageFilter with VkRecursiveMultiResolutionPyramidImageFilter
  *
  * \sa ObjectFactoryBase
  * \sa MultiResolutionPyramidImageFilter
  * \sa VkMultiResolutionPyramidImageFilter
+ * \sa RecursiveMultiResolutionPyramidImageFilter
+ * \sa VkRecursiveMultiResolutionPyramidImageFilter
  *
  * \ingroup VkFFTBackend
  * \ingroup ITKRegistration
@@ -79,33 +83,65 @@ public:
   }
 
 protected:
-  /** Override base MultiResolutionPyramidImageFilter constructor at runtime to return
-   *  an upcast VkMultiResolutionPyramidImageFilter instance through the object factory
+  /** Override the base class of a Vk pyramid at runtime to return an upcast instance of
+   *  the Vk pyramid through the object factory
    */
-  template <typename InputPixelType, typename OutputPixelType, unsigned int D, unsigned int... ImageDimensions>
+  template <template <typename, typename> class TVkPyramid,
+            typename InputPixelType,
+            typename OutputPixelType,
+            unsigned int D,
+            unsigned int... ImageDimensions>
   void
-  OverrideSuperclassType(const std::integer_sequence<unsigned int, D, ImageDimensions...> &)
+  OverrideSuperclassType(const char * description, const std::integer_sequence<unsigned int, D, ImageDimensions...> &)
   {
-    using InputImageType = Image<InputPixelType, D>;
-    using OutputImageType = Image<OutputPixelType, D>;
-    this->RegisterOverride(
-      typeid(typename VkMultiResolutionPyramidImageFilter<InputImageType, OutputImageType>::Superclass).name(),
-      typeid(VkMultiResolutionPyramidImageFilter<InputImageType, OutputImageType>).name(),
-      "VkMultiResolutionPyramidImageFilter Override",
-      true,
-      CreateObjectFunction<VkMultiResolutionPyramidImageFilter<InputImageType, OutputImageType>>::New());
-    OverrideSuperclassType<InputPixelType, OutputPixelType>(std::integer_sequence<unsigned int, ImageDimensions...>{});
+    using VkPyramidType = TVkPyramid<Image<InputPixelType, D>, Image<OutputPixelType, D>>;
+    this->RegisterOverride(typeid(typename VkPyramidType::Superclass).name(),
+                           typeid(VkPyramidType).name(),
+                           description,
+                           true,
+                           CreateObjectFunction<VkPyramidType>::New());
+    OverrideSuperclassType<TVkPyramid, InputPixelType, OutputPixelType>(
+      description, std::integer_sequence<unsigned int, ImageDimensions...>{});
   }
-  template <typename InputPixelType, typename OutputPixelType>
+  template <template <typename, typename> class TVkPyramid, typename InputPixelType, typename OutputPixelType>
   void
-  OverrideSuperclassType(const std::integer_sequence<unsigned int> &)
+  OverrideSuperclassType(const char *, const std::integer_sequence<unsigned int> &)
   {}
 
   VkMultiResolutionPyramidImageFilterFactory()
   {
-    OverrideSuperclassType<float, float>(std::integer_sequence<unsigned int, 4, 3, 2, 1>{});
+    OverrideSuperclassType<VkMultiResolutionPyramidImageFilter, float, float>(
+      "VkMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 4, 3, 2, 1>{});
 
-    OverrideSuperclassType<double, double>(std::integer_sequence<unsigned int, 4, 3, 2, 1>{});
+    OverrideSuperclassType<VkMultiResolutionPyramidImageFilter, double, double>(
+      "VkMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 4, 3, 2, 1>{});
+
+    // The recursive pyramid smooths on the device up to three dimensions only
+    OverrideSuperclassType<VkRecursiveMultiResolutionPyramidImageFilter, float, float>(
+      "VkRecursiveMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 3, 2, 1>{});
+
+    OverrideSuperclassType<VkRecursiveMultiResolutionPyramidImageFilter, double, double>(
+      "VkRecursiveMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 3, 2, 1>{});
+
+    // Integer images such as CT and MR volumes into float pyramids. The Vk smoother converts
+    // their pixels on the device instead of a cast of the whole input on the host.
+    OverrideSuperclassType<VkMultiResolutionPyramidImageFilter, unsigned char, float>(
+      "VkMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 4, 3, 2, 1>{});
+
+    OverrideSuperclassType<VkMultiResolutionPyramidImageFilter, short, float>(
+      "VkMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 4, 3, 2, 1>{});
+
+    OverrideSuperclassType<VkMultiResolutionPyramidImageFilter, unsigned short, float>(
+      "VkMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 4, 3, 2, 1>{});
+
+    OverrideSuperclassType<VkRecursiveMultiResolutionPyramidImageFilter, unsigned char, float>(
+      "VkRecursiveMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 3, 2, 1>{});
+
+    OverrideSuperclassType<VkRecursiveMultiResolutionPyramidImageFilter, short, float>(
+      "VkRecursiveMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 3, 2, 1>{});
+
+    OverrideSuperclassType<VkRecursiveMultiResolutionPyramidImageFilter, unsigned short, float>(
+      "VkRecursiveMultiResolutionPyramidImageFilter Override", std::integer_sequence<unsigned int, 3, 2, 1>{});
   }
 };
 
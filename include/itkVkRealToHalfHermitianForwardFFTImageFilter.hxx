@@ -34,6 +34,48 @@ template <typename TInputImage, typename TOutputImage>
 VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::VkRealToHalfHermitianForwardFFTImageFilter()
 {}
 
+template <typename TInputImage, typename TOutputImage>
+bool
+VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::IsPadded() const
+{
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    if (m_PadLowerBound[dim] > 0 || m_PadUpperBound[dim] > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType * const input{ this->GetInput() };
+  OutputImageType * const      output{ this->GetOutput() };
+  if (!input || !output || !this->IsPadded())
+  {
+    return;
+  }
+
+  // The transform covers the input grown by the padding on either side
+  using IndexValueType = typename OutputImageRegionType::IndexValueType;
+  const InputImageRegionType & inputRegion{ input->GetLargestPossibleRegion() };
+  OutputImageRegionType        outputRegion{ output->GetLargestPossibleRegion() };
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    outputRegion.SetIndex(dim, inputRegion.GetIndex(dim) - static_cast<IndexValueType>(m_PadLowerBound[dim]));
+    outputRegion.SetSize(dim, inputRegion.GetSize(dim) + m_PadLowerBound[dim] + m_PadUpperBound[dim]);
+  }
+  // Only the non-redundant half of the padded spectrum is stored
+  const SizeValueType paddedXSize{ outputRegion.GetSize(0) };
+  outputRegion.SetSize(0, paddedXSize / 2 + 1);
+  output->SetLargestPossibleRegion(outputRegion);
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
@@ -47,6 +89,15 @@ VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateD
     return;
   }
 
+  // Transform small images in host memory with the next registered backend unless an option
+  // of this filter is set
+  m_GeneratedDataOnHost = !this->IsPadded() && m_NonZeroInputRegion.GetNumberOfPixels() == 0 &&
+                          VkFFTBackendDispatch<Self>::GenerateDataOnHost(this, m_HostBackend, [](Superclass *) {});
+  if (m_GeneratedDataOnHost)
+  {
+    return;
+  }
+
   // we don't have a nice progress to report, but at least this simple line
   // reports the beginning and the end of the process
   const ProgressReporter progress(this, 0, 1);
@@ -56,10 +107,24 @@ VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateD
   output->Allocate();
 
   const SizeType & inputSize{ input->GetLargestPossibleRegion().GetSize() };
+  const bool       padded{ this->IsPadded() };
+  SizeType         transformSize{ inputSize };
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    transformSize[dim] += m_PadLowerBound[dim] + m_PadUpperBound[dim];
+  }
+
+  // Read an input that is held on the device from there, and leave the output on the device
+  // when it can hold it there
+  const VkCommon::DeviceBufferPointer inputGPUBuffer{ VkImageDeviceBuffer<InputImageType>::GetInputBuffer(
+    input, this->GetDeviceID()) };
+  VkCommon::DeviceBufferPointer       outputGPUBuffer;
+  const bool                          deviceOutput{ VkImageDeviceBuffer<OutputImageType>::GetOutputBuffer(
+    output, this->GetDeviceID(), outputGPUBuffer) };
 
-  const InputPixelType * const inputCPUBuffer{ input->GetBufferPointer() };
+  const InputPixelType * const inputCPUBuffer{ inputGPUBuffer ? nullptr : input->GetBufferPointer() };
   OutputPixelType * const      outputCPUBuffer{ output->GetBufferPointer() };
-  itkAssertOrThrowMacro(inputCPUBuffer != nullptr, "No CPU input buffer");
+  itkAssertOrThrowMacro(inputCPUBuffer != nullptr || inputGPUBuffer, "No input buffer");
   itkAssertOrThrowMacro(outputCPUBuffer != nullptr, "No CPU output buffer");
   const SizeValueType inBytes{ input->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(InputPixelType) };
   const SizeValueType outBytes{ output->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(OutputPixelType) };
@@ -71,11 +136,11 @@ VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateD
   // Describe this filter in VkCommon::VkParameters
   typename VkCommon::VkParameters vkParameters;
   if (ImageDimension > 0)
-    vkParameters.X = inputSize[0];
+    vkParameters.X = transformSize[0];
   if (ImageDimension > 1)
-    vkParameters.Y = inputSize[1];
+    vkParameters.Y = transformSize[1];
   if (ImageDimension > 2)
-    vkParameters.Z = inputSize[2];
+    vkParameters.Z = transformSize[2];
   if (std::is_same<RealType, float>::value)
     vkParameters.P = VkCommon::PrecisionEnum::FLOAT;
   else if (std::is_same<RealType, double>::value)
@@ -87,10 +152,52 @@ VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateD
   vkParameters.I = VkCommon::DirectionEnum::FORWARD;
   vkParameters.normalized = VkCommon::NormalizationEnum::UNNORMALIZED;
 
+  if (padded)
+  {
+    // Upload the unpadded input and generate the padding on the device
+    itkAssertOrThrowMacro(m_BoundaryCondition != BoundaryConditionEnum::NONE,
+                          "A boundary condition is required to pad the input.");
+    vkParameters.boundaryCondition = m_BoundaryCondition;
+    for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+    {
+      vkParameters.padInputSize[dim] = inputSize[dim];
+      vkParameters.padLowerBound[dim] = m_PadLowerBound[dim];
+    }
+  }
+
+  if (!padded || m_BoundaryCondition == BoundaryConditionEnum::ZERO)
+  {
+    // Zero padding leaves the input block as the only non-zero support
+    const InputImageRegionType & largestRegion{ input->GetLargestPossibleRegion() };
+    const InputImageRegionType   supportRegion{ m_NonZeroInputRegion.GetNumberOfPixels() > 0 ? m_NonZeroInputRegion
+                                                                                              : largestRegion };
+    itkAssertOrThrowMacro(largestRegion.IsInside(supportRegion),
+                          "NonZeroInputRegion must lie inside the largest possible input region.");
+    if (padded || m_NonZeroInputRegion.GetNumberOfPixels() > 0)
+    {
+      for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+      {
+        const uint64_t supportBegin{ m_PadLowerBound[dim] + static_cast<uint64_t>(supportRegion.GetIndex(dim) -
+                                                                                  largestRegion.GetIndex(dim)) };
+        VkCommon::SetSpatialSupport(
+          vkParameters, dim, transformSize[dim], supportBegin, supportBegin + supportRegion.GetSize(dim));
+      }
+    }
+  }
+
   vkParameters.inputCPUBuffer = inputCPUBuffer;
   vkParameters.inputBufferBytes = inBytes;
+  if (!inputGPUBuffer)
+  {
+    VkCommon::IdentifyInput(vkParameters, input);
+  }
+  vkParameters.inputGPUBuffer = inputGPUBuffer;
   vkParameters.outputCPUBuffer = outputCPUBuffer;
   vkParameters.outputBufferBytes = outBytes;
+  if (deviceOutput)
+  {
+    vkParameters.outputGPUBuffer = &outputGPUBuffer;
+  }
 
   const VkFFTResult resFFT{ m_VkCommon.Run(vkGPU, vkParameters) };
   if (resFFT != VKFFT_SUCCESS)
@@ -99,6 +206,10 @@ VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateD
     mesg << "VkFFT third-party library failed with error code " << resFFT << ".";
     itkAssertOrThrowMacro(false, mesg.str());
   }
+  if (deviceOutput)
+  {
+    VkImageDeviceBuffer<OutputImageType>::SetOutputBuffer(output, outputGPUBuffer);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -110,6 +221,10 @@ VkRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::PrintSelf
   os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
   os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
   os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "NonZeroInputRegion: " << m_NonZeroInputRegion << std::endl;
+  os << indent << "PadLowerBound: " << m_PadLowerBound << std::endl;
+  os << indent << "PadUpperBound: " << m_PadUpperBound << std::endl;
+  os << indent << "BoundaryCondition: " << m_BoundaryCondition << std::endl;
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkRecursiveMultiResolutionPyramidImageFilter_h
+#define itkVkRecursiveMultiResolutionPyramidImageFilter_h
+
+#include "itkRecursiveMultiResolutionPyramidImageFilter.h"
+
+#include "itkVkFFTDiscreteGaussianImageFilter.h"
+#include "itkVkImage.h"
+#include "itkMacro.h"
+#include "VkFFTBackendExport.h"
+
+#include <type_traits>
+
+namespace itk
+{
+
+/** \class VkRecursiveMultiResolutionPyramidImageFilter
+ * \brief Creates a multi-resolution pyramid recursively with FFT acceleration
+ *
+ * VkRecursiveMultiResolutionPyramidImageFilter re-implements the framework
+ * of RecursiveMultiResolutionPyramidImageFilter, in which each coarser level
+ * is computed by smoothing and shrinking the previous level rather than the
+ * input. Up to three dimensions, every level is smoothed on the device by
+ * VkFFTDiscreteGaussianImageFilter, so that each transform operates on an
+ * image that shrinks geometrically from level to level.
+ *
+ * With SpectralDecimation and UseShrinkImageFilter on, each level is shrunk
+ * in the frequency domain and held in a VkImage, whose pixels stay on the
+ * device to be smoothed into the next coarser level. The outputs receive a
+ * copy of the pixels of their level, and the levels are never uploaded again.
+ * The finest level is smoothed from the input itself, so that unsigned char,
+ * short and unsigned short pixels are converted on the device.
+ * Otherwise the smoothed levels are shrunk or resampled on the host.
+ *
+ * In four dimensions the levels are generated by the base class.
+ *
+ * See documentation of RecursiveMultiResolutionPyramidImageFilter
+ * for information on how to specify a multi-resolution schedule.
+ *
+ * \sa RecursiveMultiResolutionPyramidImageFilter
+ * \sa VkMultiResolutionPyramidImageFilter
+ * \sa VkFFTDiscreteGaussianImageFilter
+ * \sa VkImage
+ *
+ * \ingroup VkFFTBackend
+ * \ingroup PyramidImageFilter
+ * \ingroup ITKRegistrationCommon
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT VkRecursiveMultiResolutionPyramidImageFilter
+  : public RecursiveMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VkRecursiveMultiResolutionPyramidImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = VkRecursiveMultiResolutionPyramidImageFilter;
+  using Superclass = RecursiveMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VkRecursiveMultiResolutionPyramidImageFilter, RecursiveMultiResolutionPyramidImageFilter);
+
+  /** ImageDimension enumeration. */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Inherit types from Superclass. */
+  using typename Superclass::InputImageType;
+  using typename Superclass::OutputImageType;
+  using typename Superclass::InputImagePointer;
+  using typename Superclass::OutputImagePointer;
+  using typename Superclass::InputImageConstPointer;
+  using typename Superclass::ScheduleType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** Image type of the levels, whose pixels the smoother leaves on the device. */
+  using LevelImageType = VkImage<OutputPixelType, ImageDimension>;
+  using LevelImagePointer = typename LevelImageType::Pointer;
+
+  /** Shrink each level in the frequency domain and keep it on the device for the next
+   *  coarser level. Applies with UseShrinkImageFilter up to three dimensions and is
+   *  on by default. */
+  itkSetMacro(SpectralDecimation, bool);
+  itkGetConstMacro(SpectralDecimation, bool);
+  itkBooleanMacro(SpectralDecimation);
+
+protected:
+  VkRecursiveMultiResolutionPyramidImageFilter() = default;
+  ~VkRecursiveMultiResolutionPyramidImageFilter() override = default;
+
+  /** Generate the output data. */
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  using VkSmootherType = std::integral_constant<bool, (ImageDimension <= 3)>;
+
+  /** Generate the levels from the finest to the coarsest, smoothing each on the device.
+   *  Only the Vk smoother generates them; otherwise the base class does. */
+  void
+  GenerateLevels(std::true_type);
+  void
+  GenerateLevels(std::false_type)
+  {
+    Superclass::GenerateData();
+  }
+
+  /** Smooth the previous level, or the input for the finest level, with the given smoother
+   *  by the given factors relative to it, and shrink it. Returns the level, disconnected
+   *  from the pipeline. */
+  template <typename TSmoother>
+  LevelImagePointer
+  GenerateLevel(TSmoother *                                smoother,
+                const typename TSmoother::InputImageType * input,
+                const unsigned int                         factors[ImageDimension],
+                const OutputImageType *                    outputPtr,
+                bool                                       spectralDecimation);
+
+  using SmootherType =
+    typename std::conditional<ImageDimension <= 3,
+                              VkFFTDiscreteGaussianImageFilter<LevelImageType, LevelImageType>,
+                              DiscreteGaussianImageFilter<LevelImageType, LevelImageType>>::type;
+
+  /** The smoother of the finest level reads the input, whose integer pixels it converts
+   *  on the device. */
+  using InputSmootherType =
+    typename std::conditional<ImageDimension <= 3,
+                              VkFFTDiscreteGaussianImageFilter<InputImageType, LevelImageType>,
+                              DiscreteGaussianImageFilter<InputImageType, LevelImageType>>::type;
+
+  bool                                m_SpectralDecimation = true;
+  typename SmootherType::Pointer      m_Smoother = SmootherType::New();
+  typename InputSmootherType::Pointer m_InputSmoother = InputSmootherType::New();
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVkRecursiveMultiResolutionPyramidImageFilter.hxx"
+#endif
+
+#endif
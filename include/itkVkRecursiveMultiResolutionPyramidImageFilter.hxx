@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkRecursiveMultiResolutionPyramidImageFilter_hxx
+#define itkVkRecursiveMultiResolutionPyramidImageFilter_hxx
+
+#include "itkCastImageFilter.h"
+#include "itkIdentityTransform.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkMacro.h"
+#include "itkResampleImageFilter.h"
+#include "itkShrinkImageFilter.h"
+
+#include "itkMath.h"
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+void
+VkRecursiveMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->GenerateLevels(VkSmootherType{});
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VkRecursiveMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateLevels(std::true_type)
+{
+  // Mostly reimplements RecursiveMultiResolutionPyramidImageFilter::GenerateData
+
+  // Get the input and output pointers
+  InputImageConstPointer inputPtr = this->GetInput();
+
+  // The finest level is smoothed from the input, which is only cast on the host to be copied
+  using CasterType = CastImageFilter<TInputImage, LevelImageType>;
+  using CopierType = CastImageFilter<LevelImageType, LevelImageType>;
+
+  // Levels shrunk in the frequency domain stay on the device for the next coarser level
+  const bool spectralDecimation = m_SpectralDecimation && this->GetUseShrinkImageFilter();
+
+  const int         numberOfLevels = static_cast<int>(this->m_NumberOfLevels);
+  unsigned int      factors[ImageDimension];
+  LevelImagePointer previousLevel;
+
+  this->UpdateProgress(0.0f);
+  for (int ilevel = numberOfLevels - 1; ilevel > -1; --ilevel)
+  {
+    this->UpdateProgress(1.0f - static_cast<float>(1 + ilevel) / static_cast<float>(numberOfLevels));
+
+    OutputImagePointer outputPtr = this->GetOutput(ilevel);
+
+    // Shrink factors relative to the previous level
+    bool allOnes = true;
+    for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+    {
+      if (ilevel == numberOfLevels - 1)
+      {
+        factors[idim] = this->m_Schedule[ilevel][idim];
+      }
+      else
+      {
+        factors[idim] = this->m_Schedule[ilevel][idim] / this->m_Schedule[ilevel + 1][idim];
+      }
+      allOnes = allOnes && factors[idim] == 1;
+    }
+
+    LevelImagePointer level;
+    if (ilevel == numberOfLevels - 1)
+    {
+      if (allOnes)
+      {
+        auto caster = CasterType::New();
+        caster->SetInput(inputPtr);
+        caster->UpdateLargestPossibleRegion();
+        level = caster->GetOutput();
+        level->DisconnectPipeline();
+      }
+      else
+      {
+        level = this->GenerateLevel(
+          m_InputSmoother.GetPointer(), inputPtr.GetPointer(), factors, outputPtr, spectralDecimation);
+        m_InputSmoother->SetInput(nullptr);
+      }
+    }
+    else if (allOnes)
+    {
+      // just copy the data over
+      auto copier = CopierType::New();
+      copier->SetInput(previousLevel);
+      copier->InPlaceOff();
+      copier->UpdateLargestPossibleRegion();
+      level = copier->GetOutput();
+      level->DisconnectPipeline();
+    }
+    else
+    {
+      level = this->GenerateLevel(
+        m_Smoother.GetPointer(), previousLevel.GetPointer(), factors, outputPtr, spectralDecimation);
+    }
+
+    // The output receives the pixels of the level, which stay on the device for the next level
+    level->UpdateHostBuffer();
+    this->GraftNthOutput(ilevel, level);
+    previousLevel = level;
+  }
+  m_Smoother->SetInput(nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TSmoother>
+auto
+VkRecursiveMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::GenerateLevel(
+  TSmoother *                                smoother,
+  const typename TSmoother::InputImageType * input,
+  const unsigned int                         factors[ImageDimension],
+  const OutputImageType *                    outputPtr,
+  bool                                       spectralDecimation) -> LevelImagePointer
+{
+  using ImageToImageType = ImageToImageFilter<LevelImageType, LevelImageType>;
+  using ResampleShrinkerType = ResampleImageFilter<LevelImageType, LevelImageType>;
+  using ShrinkerType = ShrinkImageFilter<LevelImageType, LevelImageType>;
+
+  // Dimensions that are not shrunk are not smoothed
+  typename TSmoother::ArrayType         variance;
+  typename TSmoother::ShrinkFactorsType shrinkFactors;
+  for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+  {
+    variance[idim] = factors[idim] == 1 ? 0.0 : itk::Math::sqr(0.5 * static_cast<float>(factors[idim]));
+    shrinkFactors[idim] = spectralDecimation ? factors[idim] : 1;
+  }
+
+  // Set up smoothing filter
+  smoother->SetUseImageSpacing(false);
+  smoother->SetInput(input);
+  smoother->SetMaximumError(this->m_MaximumError);
+  smoother->SetVariance(variance);
+  smoother->SetShrinkFactors(shrinkFactors);
+
+  // The smoother shrinks the level itself in the frequency domain and leaves it on the device
+  if (spectralDecimation)
+  {
+    smoother->Modified();
+    smoother->UpdateLargestPossibleRegion();
+    LevelImagePointer level = smoother->GetOutput();
+    level->DisconnectPipeline();
+    return level;
+  }
+
+  // only one of these filters is created, depending on the
+  // value of UseShrinkImageFilter flag
+  typename ImageToImageType::Pointer shrinkerFilter;
+  if (this->GetUseShrinkImageFilter())
+  {
+    auto shrinker = ShrinkerType::New();
+    shrinker->SetShrinkFactors(factors);
+    shrinkerFilter = shrinker.GetPointer();
+  }
+  else
+  {
+    auto resampleShrinker = ResampleShrinkerType::New();
+    using LinearInterpolatorType = itk::LinearInterpolateImageFunction<LevelImageType, double>;
+    auto interpolator = LinearInterpolatorType::New();
+    resampleShrinker->SetInterpolator(interpolator);
+    resampleShrinker->SetDefaultPixelValue(0);
+    using IdentityTransformType = itk::IdentityTransform<double, ImageDimension>;
+    auto identityTransform = IdentityTransformType::New();
+    resampleShrinker->SetOutputParametersFromImage(outputPtr);
+    resampleShrinker->SetTransform(identityTransform);
+    shrinkerFilter = resampleShrinker.GetPointer();
+  }
+
+  shrinkerFilter->SetInput(smoother->GetOutput());
+
+  // force to always update in case shrink factors are the same
+  smoother->Modified();
+  shrinkerFilter->UpdateLargestPossibleRegion();
+  LevelImagePointer level = shrinkerFilter->GetOutput();
+  level->DisconnectPipeline();
+  return level;
+}
+
+/**
+ * PrintSelf method
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+VkRecursiveMultiResolutionPyramidImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os,
+                                                                                   Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "SpectralDecimation: " << m_SpectralDecimation << std::endl;
+}
+} // namespace itk
+
+#endif // itkVkRecursiveMultiResolutionPyramidImageFilter_hxx
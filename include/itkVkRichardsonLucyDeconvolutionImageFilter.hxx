@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkRichardsonLucyDeconvolutionImageFilter_hxx
+#define itkVkRichardsonLucyDeconvolutionImageFilter_hxx
+
+#include "itkVkRichardsonLucyDeconvolutionImageFilter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+VkRichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::
+  VkRichardsonLucyDeconvolutionImageFilter()
+{
+  this->SetSizeGreatestPrimeFactor(m_VkCommon.GetGreatestPrimeFactor());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkRichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
+{
+  m_DeconvolvingOnDevice = this->GetVkBoundaryCondition() != BoundaryConditionEnum::NONE;
+  if (!m_DeconvolvingOnDevice)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  // The estimate over the padded domain is only copied to the host if requested
+  const typename InputImageType::SizeType padSize{ this->GetPadSize() };
+  const typename InputImageType::SizeType padLowerBound{ this->GetPadLowerBound() };
+  this->m_CurrentEstimate = nullptr;
+  if (m_CurrentEstimateInterval > 0)
+  {
+    this->m_CurrentEstimate = InternalImageType::New();
+    this->m_CurrentEstimate->SetRegions(HelperType::GetPaddedRegion(this, padSize, padLowerBound));
+    this->m_CurrentEstimate->Allocate();
+  }
+
+  const unsigned int numberOfIterations{ this->GetNumberOfIterations() };
+  this->SetStopIteration(false);
+  m_VkIteration = 0;
+
+  typename VkCommon::VkParameters vkParameters;
+  vkParameters.deconvolution = VkCommon::DeconvolutionEnum::RICHARDSON_LUCY;
+  vkParameters.numberIterations = numberOfIterations;
+  if (this->m_CurrentEstimate)
+  {
+    vkParameters.estimateCPUBuffer = this->m_CurrentEstimate->GetBufferPointer();
+    vkParameters.estimateInterval = m_CurrentEstimateInterval;
+  }
+  vkParameters.iterationCallback = [this, numberOfIterations](uint64_t iteration) {
+    m_VkIteration = static_cast<unsigned int>(iteration);
+    this->UpdateProgress(static_cast<float>(iteration) / static_cast<float>(numberOfIterations));
+    this->InvokeEvent(IterationEvent());
+    return this->GetStopIteration();
+  };
+
+  HelperType::Deconvolve(this, padSize, padLowerBound, this->GetDeviceID(), m_VkCommon, vkParameters);
+  if (!this->GetStopIteration())
+  {
+    m_VkIteration = numberOfIterations;
+  }
+  this->UpdateProgress(1.0f);
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkRichardsonLucyDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "VkBoundaryCondition: " << this->GetVkBoundaryCondition() << std::endl;
+  os << indent << "CurrentEstimateInterval: " << m_CurrentEstimateInterval << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkRichardsonLucyDeconvolutionImageFilter_hxx
@@ -0,0 +1,79 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkWienerDeconvolutionImageFilter_hxx
+#define itkVkWienerDeconvolutionImageFilter_hxx
+
+#include "itkVkWienerDeconvolutionImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+VkWienerDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::
+  VkWienerDeconvolutionImageFilter()
+{
+  this->SetSizeGreatestPrimeFactor(m_VkCommon.GetGreatestPrimeFactor());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkWienerDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
+{
+  if (this->GetVkBoundaryCondition() == BoundaryConditionEnum::NONE)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  // The division is a single pass on the device, so only its beginning and end are reported
+  const ProgressReporter progress(this, 0, 1);
+
+  const typename InputImageType::SizeType padSize{ this->GetPadSize() };
+  typename VkCommon::VkParameters         vkParameters;
+  // As for WienerDeconvolutionImageFilter, the power spectral density of the noise is the
+  // variance scaled to the unnormalized spectra of the padded domain
+  SizeValueType numberOfPixels{ 1 };
+  for (unsigned int dim{ 0 }; dim < ImageDimension; ++dim)
+  {
+    numberOfPixels *= padSize[dim];
+  }
+  vkParameters.deconvolution = VkCommon::DeconvolutionEnum::WIENER;
+  vkParameters.regularization = this->GetNoiseVariance() * static_cast<double>(numberOfPixels);
+  vkParameters.zeroMagnitudeThreshold = this->GetKernelZeroMagnitudeThreshold();
+
+  HelperType::Deconvolve(this, padSize, this->GetPadLowerBound(), this->GetDeviceID(), m_VkCommon, vkParameters);
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+VkWienerDeconvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVkGlobalConfiguration: " << m_UseVkGlobalConfiguration << std::endl;
+  os << indent << "Local DeviceID: " << m_DeviceID << std::endl;
+  os << indent << "Global DeviceID: " << VkGlobalConfiguration::GetDeviceID() << std::endl;
+  os << indent << "Preferred DeviceID: " << this->GetDeviceID() << std::endl;
+  os << indent << "VkBoundaryCondition: " << this->GetVkBoundaryCondition() << std::endl;
+}
+
+} // end namespace itk
+
+#endif // itkVkWienerDeconvolutionImageFilter_hxx
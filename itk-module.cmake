@@ -8,6 +8,13 @@ file(READ "${MY_CURRENT_DIR}/README.rst" DOCUMENTATION)
 # By convention those modules outside of ITK are not prefixed with
 # ITK.
 
+# With ITK's GPU module, the Vk filters of the OpenCL backend read and write
+# the OpenCL buffers of GPUImages
+set(_VkFFTBackend_GPU_DEPENDS)
+if(ITK_USE_GPU)
+  set(_VkFFTBackend_GPU_DEPENDS ITKGPUCommon)
+endif()
+
 # define the dependencies of the include module and the tests
 itk_module(VkFFTBackend
   DEPENDS
@@ -16,6 +23,8 @@ itk_module(VkFFTBackend
     ITKFFT
     ITKRegistrationCommon
     ITKConvolution
+    ITKDeconvolution
+    ${_VkFFTBackend_GPU_DEPENDS}
   COMPILE_DEPENDS
     ITKImageSources
     ITKSmoothing
@@ -17,134 +17,149 @@
  *=========================================================================*/
 #include "itkVkCommon.h"
 #include "itkVkDefinitions.h"
+#include "itkVkDeviceContext.h"
+#include "itkVkGlobalConfiguration.h"
 #include "vkFFT.h"
 #include "itkMacro.h"
-#include <complex>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include <memory>
+#include <limits>
+#include <utility>
 
 namespace itk
 {
+std::ostream &
+operator<<(std::ostream & out, const VkCommon::BoundaryConditionEnum value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case VkCommon::BoundaryConditionEnum::NONE:
+        return "itk::VkCommon::BoundaryConditionEnum::NONE";
+      case VkCommon::BoundaryConditionEnum::ZERO:
+        return "itk::VkCommon::BoundaryConditionEnum::ZERO";
+      case VkCommon::BoundaryConditionEnum::PERIODIC:
+        return "itk::VkCommon::BoundaryConditionEnum::PERIODIC";
+      case VkCommon::BoundaryConditionEnum::ZERO_FLUX_NEUMANN:
+        return "itk::VkCommon::BoundaryConditionEnum::ZERO_FLUX_NEUMANN";
+      case VkCommon::BoundaryConditionEnum::MIRROR:
+        return "itk::VkCommon::BoundaryConditionEnum::MIRROR";
+      default:
+        return "INVALID VALUE FOR itk::VkCommon::BoundaryConditionEnum";
+    }
+  }();
+}
 
 VkFFTResult
 VkCommon::Run(const VkGPU & vkGPU, const VkParameters & vkParameters)
 {
   VkFFTResult resFFT{ VKFFT_SUCCESS };
 
-  m_VkGPU = vkGPU;
   m_VkParameters = vkParameters;
-  if (m_MustConfigure || m_VkGPU != m_VkGPUPrevious || m_VkParameters != m_VkParametersPrevious)
+  if (m_MustConfigure || vkGPU != m_VkGPUPrevious || vkParameters != m_VkParametersPrevious)
   {
-    resFFT = this->ReleaseBackend();
-    if (resFFT != VKFFT_SUCCESS)
-    {
-      return resFFT;
-    }
+    m_VkGPU = vkGPU;
     resFFT = this->ConfigureBackend();
     if (resFFT != VKFFT_SUCCESS)
     {
+      this->ReleaseBackend();
       return resFFT;
     }
+    m_VkGPUPrevious = vkGPU;
+    m_VkParametersPrevious = vkParameters;
+    m_VkParametersPrevious.inputGPUBuffer.reset();
+    m_VkParametersPrevious.outputGPUBuffer = nullptr;
+    m_VkParametersPrevious.kernelGPUBuffer.reset();
+    m_VkParametersPrevious.movingGPUBuffer.reset();
     this->m_MustConfigure = false;
   }
 
-  resFFT = this->PerformFFT();
+  resFFT = m_DeviceContext->MakeCurrent();
   if (resFFT != VKFFT_SUCCESS)
   {
     return resFFT;
   }
 
+  resFFT = this->PerformFFT();
+
+  // Do not hold on to the caller's device buffers between runs
+  m_VkParameters.inputGPUBuffer.reset();
+  m_VkParameters.outputGPUBuffer = nullptr;
+  m_VkParameters.kernelGPUBuffer.reset();
+  m_VkParameters.movingGPUBuffer.reset();
+
   return resFFT;
 }
 
-VkFFTResult
-VkCommon::ConfigureBackend()
+void
+VkCommon::SetSpatialSupport(VkParameters & vkParameters,
+                            unsigned int   dim,
+                            uint64_t       size,
+                            uint64_t       supportBegin,
+                            uint64_t       supportEnd)
 {
-  VkFFTResult resFFT{ VKFFT_SUCCESS };
-#if (VKFFT_BACKEND == CUDA)
-  CUresult    res{ CUDA_SUCCESS };
-  cudaError_t res2{ cudaSuccess };
-  res = cuInit(0);
-  if (res != CUDA_SUCCESS)
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_INITIALIZE };
-  res2 = cudaSetDevice((int)m_VkGPU.device_id);
-  if (res2 != cudaSuccess)
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SET_DEVICE_ID };
-  res = cuDeviceGet(&m_VkGPU.device, (int)m_VkGPU.device_id);
-  if (res != CUDA_SUCCESS)
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_GET_DEVICE };
-  res = cuCtxCreate(&m_VkGPU.context, 0, (int)m_VkGPU.device);
-  if (res != CUDA_SUCCESS)
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_CONTEXT };
-
-#elif (VKFFT_BACKEND == OPENCL)
-  cl_int resCL{ CL_SUCCESS };
-
-  // Begin code that mimics launchVkFFT from VkFFT/Vulkan_FFT.cpp, though just the OpenCL part.
-  cl_uint numPlatforms;
-  resCL = clGetPlatformIDs(0, nullptr, &numPlatforms);
-  if (resCL != CL_SUCCESS)
+  itkAssertOrThrowMacro(dim < 3, "VkFFT supports at most three dimensions.");
+  supportEnd = std::min(supportEnd, size);
+  const uint64_t lowerBlock{ std::min(supportBegin, supportEnd) };
+  const uint64_t upperBlock{ size - supportEnd };
+  if (supportBegin >= supportEnd || (lowerBlock == 0 && upperBlock == 0))
   {
-    std::cerr << __FILE__ "(" << __LINE__ << "): clGetPlatformIDs returned " << resCL << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_INITIALIZE };
+    // Nothing to skip: transform the full extent of this dimension.
+    vkParameters.performZeropadding[dim] = 0;
+    vkParameters.zeropadLeft[dim] = 0;
+    vkParameters.zeropadRight[dim] = 0;
+    return;
   }
-  std::unique_ptr<cl_platform_id[]> platformsArray{ std::make_unique<cl_platform_id[]>(numPlatforms) };
-  cl_platform_id *                  platforms{ &platformsArray[0] };
-  if (!platforms)
-    return VkFFTResult{ VKFFT_ERROR_MALLOC_FAILED };
-  resCL = clGetPlatformIDs(numPlatforms, platforms, nullptr);
-  if (resCL != CL_SUCCESS)
+  vkParameters.performZeropadding[dim] = 1;
+  if (upperBlock >= lowerBlock)
   {
-    std::cerr << __FILE__ "(" << __LINE__ << "): clGetPlatformIDs returned " << resCL << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_INITIALIZE };
+    vkParameters.zeropadLeft[dim] = supportEnd;
+    vkParameters.zeropadRight[dim] = size;
   }
-  uint64_t k{ 0 };
-  for (uint64_t j{ 0 }; j < numPlatforms; j++)
+  else
   {
-    cl_uint numDevices;
-    resCL = clGetDeviceIDs(platforms[j], CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices);
-    std::unique_ptr<cl_device_id[]> deviceListArray{ std::make_unique<cl_device_id[]>(numDevices) };
-    cl_device_id *                  deviceList{ &deviceListArray[0] };
-    if (!deviceList)
-      return VkFFTResult{ VKFFT_ERROR_MALLOC_FAILED };
-    resCL = clGetDeviceIDs(platforms[j], CL_DEVICE_TYPE_ALL, numDevices, deviceList, nullptr);
-    if (resCL != CL_SUCCESS)
-    {
-      std::cerr << __FILE__ "(" << __LINE__ << "): clGetDeviceIDs returned " << resCL << std::endl;
-      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_GET_DEVICE };
-    }
-    for (uint64_t i{ 0 }; i < numDevices; i++)
-    {
-      if (k == m_VkGPU.device_id)
-      {
-        m_VkGPU.platform = platforms[j];
-        m_VkGPU.device = deviceList[i];
-        m_VkGPU.context = clCreateContext(NULL, 1, &m_VkGPU.device, NULL, NULL, &resCL);
-        if (resCL != CL_SUCCESS)
-        {
-          std::cerr << __FILE__ "(" << __LINE__ << "): clCreateContext returned " << resCL << std::endl;
-          return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_CONTEXT };
-        }
-        m_VkGPU.commandQueue = clCreateCommandQueue(m_VkGPU.context, m_VkGPU.device, 0, &resCL);
-        if (resCL != CL_SUCCESS)
-        {
-          std::cerr << __FILE__ "(" << __LINE__ << "): clCreateCommandQueue returned " << resCL << std::endl;
-          return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_COMMAND_QUEUE };
-        }
-        k++;
-      }
-      else
-      {
-        k++;
-      }
-    }
+    vkParameters.zeropadLeft[dim] = 0;
+    vkParameters.zeropadRight[dim] = supportBegin;
   }
-#endif
+}
+
+void
+VkCommon::IdentifyInput(VkParameters & vkParameters, const DataObject * input)
+{
+  vkParameters.inputDataObject = input;
+  // Pipeline outputs are stamped when they are generated, other images when they are modified
+  vkParameters.inputTimeStamp = input ? std::max(input->GetMTime(), input->GetUpdateMTime()) : ModifiedTimeType{ 0 };
+}
+
+void
+VkCommon::IdentifyKernel(VkParameters & vkParameters, const DataObject * kernel)
+{
+  vkParameters.kernelDataObject = kernel;
+  vkParameters.kernelTimeStamp =
+    kernel ? std::max(kernel->GetMTime(), kernel->GetUpdateMTime()) : ModifiedTimeType{ 0 };
+}
+
+VkFFTResult
+VkCommon::ConfigureBackend()
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // Use the context of the device that is shared by all Vk filters
+  resFFT = VkDeviceContext::GetInstance(m_VkGPU.device_id, m_DeviceContext);
+  if (resFFT != VKFFT_SUCCESS)
+  {
+    return resFFT;
+  }
+  m_VkGPU = m_DeviceContext->GetVkGPU();
 
   // Proceed by doing something similar to user_benchmark_VkFFT from
   // VkFFT/benchmark_scripts/vkFFT_scripts/src/user_benchmark_VkFFT.cpp, but without file_output and
   // output.
 
+  // Start from defaults so that no setting lingers from a previous configuration.
+  m_VkFFTConfiguration = VkFFTConfiguration{};
+
   m_VkFFTConfiguration.size[0] = std::max(m_VkParameters.X, (decltype(m_VkParameters.X))1);
   m_VkFFTConfiguration.size[1] = std::max(m_VkParameters.Y, (decltype(m_VkParameters.Y))1);
   m_VkFFTConfiguration.size[2] = std::max(m_VkParameters.Z, (decltype(m_VkParameters.Z))1);
@@ -166,7 +181,11 @@ VkCommon::ConfigureBackend()
   for (size_t dim{ 0 }; dim < 3; ++dim)
   {
     m_VkFFTConfiguration.omitDimension[dim] = m_VkParameters.omitDimension[dim];
+    m_VkFFTConfiguration.performZeropadding[dim] = m_VkParameters.performZeropadding[dim];
+    m_VkFFTConfiguration.fft_zeropad_left[dim] = m_VkParameters.zeropadLeft[dim];
+    m_VkFFTConfiguration.fft_zeropad_right[dim] = m_VkParameters.zeropadRight[dim];
   }
+  m_VkFFTConfiguration.frequencyZeroPadding = m_VkParameters.frequencyZeropadding;
   // if (m_VkParameters.P == HALF)
   //   m_VkFFTConfiguration.halfPrecision = 1;
   m_VkFFTConfiguration.normalize = m_VkParameters.normalized == NormalizationEnum::NORMALIZED ? 1 : 0;
@@ -185,6 +204,286 @@ VkCommon::ConfigureBackend()
   m_VkFFTConfiguration.makeInversePlanOnly = (m_VkParameters.I == DirectionEnum::INVERSE);
   m_VkFFTConfiguration.makeForwardPlanOnly = (m_VkParameters.I == DirectionEnum::FORWARD);
 
+  // VkFFT cannot omit dimension 0 of a real-to-complex transform, so an R2FullH transform along
+  // a single other dimension is computed as a batch of contiguous 1D lines instead.
+  m_LineLayout = LineLayout{};
+  if (m_VkParameters.fft == FFTEnum::R2FullH && m_VkParameters.boundaryCondition == BoundaryConditionEnum::NONE &&
+      !m_VkParameters.performZeropadding[0] && !m_VkParameters.performZeropadding[1] &&
+      !m_VkParameters.performZeropadding[2])
+  {
+    unsigned int transformedDimensions{ 0 };
+    unsigned int lineDimension{ 0 };
+    for (unsigned int dim{ 0 }; dim < 3; ++dim)
+    {
+      if (m_VkFFTConfiguration.size[dim] > 1 && !m_VkParameters.omitDimension[dim])
+      {
+        ++transformedDimensions;
+        lineDimension = dim;
+      }
+    }
+    if (transformedDimensions == 1 && lineDimension > 0)
+    {
+      m_LineLayout.length = m_VkFFTConfiguration.size[lineDimension];
+      m_LineLayout.stride = lineDimension == 1 ? m_VkFFTConfiguration.size[0]
+                                               : m_VkFFTConfiguration.size[0] * m_VkFFTConfiguration.size[1];
+      m_LineLayout.count = m_VkFFTConfiguration.size[0] * m_VkFFTConfiguration.size[1] *
+                           m_VkFFTConfiguration.size[2] / m_LineLayout.length;
+    }
+  }
+
+  if (m_LineLayout.count > 0)
+  {
+    m_LineLayout.realBufferSize = m_LineLayout.length * m_LineLayout.count;
+    m_LineLayout.complexBufferSize = (m_LineLayout.length / 2 + 1) * m_LineLayout.count;
+
+    m_VkFFTConfiguration.size[0] = m_LineLayout.length;
+    m_VkFFTConfiguration.size[1] = 1;
+    m_VkFFTConfiguration.size[2] = 1;
+    m_VkFFTConfiguration.FFTdim = 1;
+    m_VkFFTConfiguration.numberBatches = m_LineLayout.count * m_VkParameters.B;
+    for (size_t dim{ 0 }; dim < 3; ++dim)
+    {
+      m_VkFFTConfiguration.omitDimension[dim] = 0;
+    }
+
+    // Half spectra of the lines in the in-place-computation buffer
+    m_VkFFTConfiguration.bufferNum = 1;
+    m_VkFFTConfiguration.bufferStride[0] = m_LineLayout.length / 2 + 1;
+    m_VkFFTConfiguration.bufferStride[1] = m_VkFFTConfiguration.bufferStride[0];
+    m_VkFFTConfiguration.bufferStride[2] = m_VkFFTConfiguration.bufferStride[1];
+    m_VkFFTConfiguration.bufferSize = &m_LineLayout.complexBufferSize;
+
+    // Real lines in a separate input (forward) or output (inverse) buffer
+    if (m_VkParameters.I == DirectionEnum::FORWARD)
+    {
+      m_VkFFTConfiguration.isInputFormatted = 1;
+      m_VkFFTConfiguration.inputBufferNum = 1;
+      m_VkFFTConfiguration.inputBufferStride[0] = m_LineLayout.length;
+      m_VkFFTConfiguration.inputBufferStride[1] = m_LineLayout.length;
+      m_VkFFTConfiguration.inputBufferStride[2] = m_LineLayout.length;
+      m_VkFFTConfiguration.inputBufferSize = &m_LineLayout.realBufferSize;
+      itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * m_LineLayout.realBufferSize ==
+                              m_VkParameters.inputBufferBytes,
+                            "CPU and GPU input buffers are of different sizes.");
+      itkAssertOrThrowMacro(2UL * m_VkParameters.PSize * m_LineLayout.realBufferSize ==
+                              m_VkParameters.outputBufferBytes,
+                            "CPU and GPU output buffers are of different sizes.");
+    }
+    else
+    {
+      m_VkFFTConfiguration.isOutputFormatted = 1;
+      m_VkFFTConfiguration.outputBufferNum = 1;
+      m_VkFFTConfiguration.outputBufferStride[0] = m_LineLayout.length;
+      m_VkFFTConfiguration.outputBufferStride[1] = m_LineLayout.length;
+      m_VkFFTConfiguration.outputBufferStride[2] = m_LineLayout.length;
+      m_VkFFTConfiguration.outputBufferSize = &m_LineLayout.realBufferSize;
+      itkAssertOrThrowMacro(2UL * m_VkParameters.PSize * m_LineLayout.realBufferSize ==
+                              m_VkParameters.inputBufferBytes,
+                            "CPU and GPU input buffers are of different sizes.");
+      itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * m_LineLayout.realBufferSize ==
+                              m_VkParameters.outputBufferBytes,
+                            "CPU and GPU output buffers are of different sizes.");
+    }
+
+    return resFFT;
+  }
+
+  // With device-side padding the CPU input buffer only holds the unpadded samples.
+  const bool padOnDevice{ m_VkParameters.boundaryCondition != BoundaryConditionEnum::NONE };
+  itkAssertOrThrowMacro(!padOnDevice || m_VkParameters.I == DirectionEnum::FORWARD,
+                        "Device-side padding requires a forward transformation.");
+  const uint64_t unpaddedSamples{ m_VkParameters.padInputSize[0] * m_VkParameters.padInputSize[1] *
+                                  m_VkParameters.padInputSize[2] };
+  itkAssertOrThrowMacro(m_VkParameters.inputPixelType == InputPixelEnum::REAL ||
+                          (padOnDevice && m_VkParameters.performGaussianSmoothing),
+                        "Only the input of a Gaussian smoothing is converted on the device.");
+
+  if (m_VkParameters.deconvolution != DeconvolutionEnum::NONE)
+  {
+    itkAssertOrThrowMacro(padOnDevice && m_VkParameters.fft == FFTEnum::R2HalfH,
+                          "Deconvolution requires a padded R2HalfH transformation.");
+
+    // The padded input, the placed kernel, the estimate and the intermediate images of the
+    // iterations are real images of the domain, transformed with one plan in both directions
+    this->ConfigureCorrelationLayout(1);
+
+    const uint64_t kernelSamples{ m_VkParameters.kernelSize[0] * m_VkParameters.kernelSize[1] *
+                                  m_VkParameters.kernelSize[2] };
+    const uint64_t cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                                m_VkParameters.cropSize[2] };
+    itkAssertOrThrowMacro(m_VkParameters.numberKernels == 1, "Deconvolution requires a single kernel.");
+    for (size_t dim{ 0 }; dim < 3; ++dim)
+    {
+      itkAssertOrThrowMacro(m_VkParameters.kernelSize[dim] <= m_VkFFTConfiguration.size[dim] &&
+                              m_VkParameters.kernelCenter[dim] < m_VkParameters.kernelSize[dim] &&
+                              m_VkParameters.cropLowerBound[dim] + m_VkParameters.cropSize[dim] <=
+                                m_VkFFTConfiguration.size[dim],
+                            "Kernel or output region does not fit into the deconvolution domain.");
+    }
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * unpaddedSamples == m_VkParameters.inputBufferBytes,
+                          "CPU and GPU input buffers are of different sizes.");
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * kernelSamples == m_VkParameters.kernelBufferBytes,
+                          "CPU and GPU kernel buffers are of different sizes.");
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * cropSamples == m_VkParameters.outputBufferBytes,
+                          "CPU and GPU output buffers are of different sizes.");
+
+    return resFFT;
+  }
+
+  if (m_VkParameters.performGaussianSmoothing)
+  {
+    itkAssertOrThrowMacro(padOnDevice && m_VkParameters.fft == FFTEnum::R2HalfH,
+                          "Gaussian smoothing requires a padded R2HalfH transformation.");
+
+    // The padded input is transformed forward and its smoothed spectrum back with one plan
+    this->ConfigureCorrelationLayout(1);
+
+    const uint64_t cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                                m_VkParameters.cropSize[2] };
+    for (size_t dim{ 0 }; dim < 3; ++dim)
+    {
+      const uint64_t factor{ m_VkParameters.gaussianShrinkFactor[dim] };
+      itkAssertOrThrowMacro(factor > 0 && m_VkFFTConfiguration.size[dim] % factor == 0,
+                            "Shrink factors must divide the smoothing domain.");
+      itkAssertOrThrowMacro(m_VkParameters.gaussianVariance[dim] >= 0.0 && m_VkParameters.cropSize[dim] > 0 &&
+                              m_VkParameters.cropLowerBound[dim] + (m_VkParameters.cropSize[dim] - 1) * factor <
+                                m_VkFFTConfiguration.size[dim],
+                            "Output region does not fit into the smoothing domain.");
+    }
+    itkAssertOrThrowMacro(this->GetInputPixelBytes() * unpaddedSamples == m_VkParameters.inputBufferBytes,
+                          "CPU and GPU input buffers are of different sizes.");
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * cropSamples == m_VkParameters.outputBufferBytes,
+                          "CPU and GPU output buffers are of different sizes.");
+
+    return resFFT;
+  }
+
+  if (m_VkParameters.performPhaseCorrelation)
+  {
+    itkAssertOrThrowMacro(padOnDevice && m_VkParameters.fft == FFTEnum::R2HalfH,
+                          "Phase correlation requires a padded R2HalfH transformation.");
+
+    // The padded input and moving image are transformed one after the other with the same plan,
+    // and their normalized cross-power spectrum is transformed back into the real correlation
+    // surface
+    this->ConfigureCorrelationLayout(1);
+
+    for (size_t dim{ 0 }; dim < 3; ++dim)
+    {
+      itkAssertOrThrowMacro(m_VkParameters.movingSize[dim] == m_VkParameters.padInputSize[dim] &&
+                              m_VkParameters.padLowerBound[dim] + m_VkParameters.padInputSize[dim] <=
+                                m_VkFFTConfiguration.size[dim],
+                            "Images do not fit into the phase correlation domain.");
+    }
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * unpaddedSamples == m_VkParameters.inputBufferBytes,
+                          "CPU and GPU input buffers are of different sizes.");
+    itkAssertOrThrowMacro(m_VkParameters.movingBufferBytes == m_VkParameters.inputBufferBytes,
+                          "CPU and GPU moving image buffers are of different sizes.");
+
+    return resFFT;
+  }
+
+  if (m_VkParameters.performNormalizedCorrelation)
+  {
+    itkAssertOrThrowMacro(!padOnDevice && m_VkParameters.fft == FFTEnum::R2HalfH,
+                          "Normalized correlation requires an unpadded R2HalfH transformation.");
+
+    // The six zero-padded real images of the correlation follow one another in the input
+    // buffer, as do the six real correlation terms in the output buffer. One plan transforms
+    // the batch in both directions.
+    this->ConfigureCorrelationLayout(6);
+
+    const uint64_t movingSamples{ m_VkParameters.movingSize[0] * m_VkParameters.movingSize[1] *
+                                  m_VkParameters.movingSize[2] };
+    const uint64_t cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                                m_VkParameters.cropSize[2] };
+    for (size_t dim{ 0 }; dim < 3; ++dim)
+    {
+      itkAssertOrThrowMacro(m_VkParameters.cropSize[dim] ==
+                                m_VkParameters.padInputSize[dim] + m_VkParameters.movingSize[dim] - 1 &&
+                              m_VkParameters.cropSize[dim] <= m_VkFFTConfiguration.size[dim],
+                            "Correlation output does not fit into the correlation domain.");
+    }
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * unpaddedSamples == m_VkParameters.inputBufferBytes,
+                          "CPU and GPU input buffers are of different sizes.");
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * movingSamples == m_VkParameters.movingBufferBytes,
+                          "CPU and GPU moving image buffers are of different sizes.");
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * cropSamples == m_VkParameters.outputBufferBytes,
+                          "CPU and GPU output buffers are of different sizes.");
+
+    return resFFT;
+  }
+
+  if (m_VkParameters.performConvolution)
+  {
+    itkAssertOrThrowMacro(padOnDevice && m_VkParameters.fft == FFTEnum::R2HalfH,
+                          "Convolution requires a padded R2HalfH transformation.");
+
+    // The padded real input and the real output are contiguous, and the half spectra of the
+    // input and the kernel are in the in-place-computation and kernel buffers. VkFFT plans
+    // both directions and multiplies by the kernel spectrum in between. With several kernels,
+    // their spectra and the outputs follow one another, and VkFFT multiplies the spectrum of
+    // the input by all kernel spectra in one launch.
+    const uint64_t numberKernels{ m_VkParameters.numberKernels };
+    itkAssertOrThrowMacro(numberKernels >= 1, "Convolution requires at least one kernel.");
+    m_VkFFTConfiguration.makeInversePlanOnly = 0;
+    m_VkFFTConfiguration.makeForwardPlanOnly = 0;
+    m_VkFFTConfiguration.normalize = 1;
+    m_VkFFTConfiguration.performConvolution = 1;
+    m_VkFFTConfiguration.numberKernels = numberKernels;
+    m_VkFFTConfiguration.bufferNum = 1;
+    m_VkFFTConfiguration.bufferStride[0] = m_VkFFTConfiguration.size[0] / 2 + 1;
+    m_VkFFTConfiguration.bufferStride[1] = m_VkFFTConfiguration.bufferStride[0] * m_VkFFTConfiguration.size[1];
+    m_VkFFTConfiguration.bufferStride[2] = m_VkFFTConfiguration.bufferStride[1] * m_VkFFTConfiguration.size[2];
+    m_VkFFTConfiguration.bufferSize = &m_VkFFTConfiguration.bufferStride[2];
+    m_VkFFTConfiguration.isInputFormatted = 1;
+    m_VkFFTConfiguration.inputBufferNum = 1;
+    m_VkFFTConfiguration.isOutputFormatted = 1;
+    m_VkFFTConfiguration.outputBufferNum = 1;
+    for (size_t dim{ 0 }; dim < 3; ++dim)
+    {
+      const uint64_t stride{ dim == 0 ? m_VkFFTConfiguration.size[0]
+                                      : m_VkFFTConfiguration.inputBufferStride[dim - 1] *
+                                          m_VkFFTConfiguration.size[dim] };
+      m_VkFFTConfiguration.inputBufferStride[dim] = stride;
+      m_VkFFTConfiguration.outputBufferStride[dim] = stride;
+    }
+    m_VkFFTConfiguration.inputBufferSize = &m_VkFFTConfiguration.inputBufferStride[2];
+    m_ConvolutionOutputSize = numberKernels * m_VkFFTConfiguration.outputBufferStride[2];
+    m_VkFFTConfiguration.outputBufferSize = &m_ConvolutionOutputSize;
+    m_ConvolutionKernelSize = numberKernels * m_VkFFTConfiguration.bufferStride[2];
+    m_VkFFTConfiguration.kernelSize = &m_ConvolutionKernelSize;
+
+    const uint64_t kernelSamples{ numberKernels * m_VkParameters.kernelSize[0] * m_VkParameters.kernelSize[1] *
+                                  m_VkParameters.kernelSize[2] };
+    const uint64_t cropSamples{ numberKernels * m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                                m_VkParameters.cropSize[2] };
+    for (size_t dim{ 0 }; dim < 3; ++dim)
+    {
+      itkAssertOrThrowMacro(m_VkParameters.kernelSize[dim] <= m_VkFFTConfiguration.size[dim] &&
+                              m_VkParameters.kernelCenter[dim] < m_VkParameters.kernelSize[dim] &&
+                              m_VkParameters.cropLowerBound[dim] + m_VkParameters.cropSize[dim] <=
+                                m_VkFFTConfiguration.size[dim],
+                            "Kernel or output region does not fit into the convolution domain.");
+    }
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * unpaddedSamples == m_VkParameters.inputBufferBytes,
+                          "CPU and GPU input buffers are of different sizes.");
+    itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * kernelSamples == m_VkParameters.kernelBufferBytes,
+                          "CPU and GPU kernel buffers are of different sizes.");
+    if (m_VkParameters.outputCPUBuffer != nullptr || m_VkParameters.outputGPUBuffer != nullptr)
+    {
+      itkAssertOrThrowMacro(1UL * m_VkParameters.PSize * cropSamples == m_VkParameters.outputBufferBytes,
+                            "CPU and GPU output buffers are of different sizes.");
+    }
+    else
+    {
+      itkAssertOrThrowMacro(m_VkParameters.peakIndices != nullptr || m_VkParameters.peakValues != nullptr,
+                            "Convolution requires an output buffer or peaks.");
+    }
+
+    return resFFT;
+  }
+
   if (m_VkParameters.fft == FFTEnum::C2C)
   {
     // For C2C computation we can do everything in the in-place-computation buffer.
@@ -194,7 +493,8 @@ VkCommon::ConfigureBackend()
     m_VkFFTConfiguration.bufferStride[2] = m_VkFFTConfiguration.bufferStride[1] * m_VkFFTConfiguration.size[2];
     m_VkFFTConfiguration.bufferSize = &m_VkFFTConfiguration.bufferStride[2];
     const uint64_t bufferBytes{ 2UL * m_VkParameters.PSize * *m_VkFFTConfiguration.bufferSize };
-    itkAssertOrThrowMacro(bufferBytes == m_VkParameters.inputBufferBytes,
+    itkAssertOrThrowMacro((padOnDevice ? 2UL * m_VkParameters.PSize * unpaddedSamples : bufferBytes) ==
+                            m_VkParameters.inputBufferBytes,
                           "CPU and GPU input buffers are of different sizes.");
     itkAssertOrThrowMacro(bufferBytes == m_VkParameters.outputBufferBytes,
                           "CPU and GPU output buffers are of different sizes.");
@@ -230,7 +530,8 @@ VkCommon::ConfigureBackend()
         m_VkFFTConfiguration.inputBufferStride[1] * m_VkFFTConfiguration.size[2];
       m_VkFFTConfiguration.inputBufferSize = &m_VkFFTConfiguration.inputBufferStride[2];
       const uint64_t inputBufferBytes{ 1UL * m_VkParameters.PSize * *m_VkFFTConfiguration.inputBufferSize };
-      itkAssertOrThrowMacro(inputBufferBytes == m_VkParameters.inputBufferBytes,
+      itkAssertOrThrowMacro((padOnDevice ? 1UL * m_VkParameters.PSize * unpaddedSamples : inputBufferBytes) ==
+                              m_VkParameters.inputBufferBytes,
                             "CPU and GPU input buffers are of different sizes.");
       itkAssertOrThrowMacro(bufferBytes == m_VkParameters.outputBufferBytes,
                             "CPU and GPU output buffers are of different sizes.");
@@ -257,157 +558,123 @@ VkCommon::ConfigureBackend()
   return resFFT;
 }
 
+void
+VkCommon::ConfigureCorrelationLayout(uint64_t numberBatches)
+{
+  // Contiguous real images in the input and output buffers and their half spectra in the
+  // in-place-computation buffer, with plans for both directions
+  m_VkFFTConfiguration.makeInversePlanOnly = 0;
+  m_VkFFTConfiguration.makeForwardPlanOnly = 0;
+  m_VkFFTConfiguration.normalize = 1;
+  m_VkFFTConfiguration.numberBatches = numberBatches;
+  m_VkFFTConfiguration.bufferNum = 1;
+  m_VkFFTConfiguration.bufferStride[0] = m_VkFFTConfiguration.size[0] / 2 + 1;
+  m_VkFFTConfiguration.bufferStride[1] = m_VkFFTConfiguration.bufferStride[0] * m_VkFFTConfiguration.size[1];
+  m_VkFFTConfiguration.bufferStride[2] = m_VkFFTConfiguration.bufferStride[1] * m_VkFFTConfiguration.size[2];
+  m_CorrelationSpectrumSize = numberBatches * m_VkFFTConfiguration.bufferStride[2];
+  m_VkFFTConfiguration.bufferSize = &m_CorrelationSpectrumSize;
+  m_VkFFTConfiguration.isInputFormatted = 1;
+  m_VkFFTConfiguration.inputBufferNum = 1;
+  m_VkFFTConfiguration.isOutputFormatted = 1;
+  m_VkFFTConfiguration.outputBufferNum = 1;
+  for (size_t dim{ 0 }; dim < 3; ++dim)
+  {
+    const uint64_t stride{ dim == 0 ? m_VkFFTConfiguration.size[0]
+                                    : m_VkFFTConfiguration.inputBufferStride[dim - 1] *
+                                        m_VkFFTConfiguration.size[dim] };
+    m_VkFFTConfiguration.inputBufferStride[dim] = stride;
+    m_VkFFTConfiguration.outputBufferStride[dim] = stride;
+  }
+  m_CorrelationDomainSize = numberBatches * m_VkFFTConfiguration.inputBufferStride[2];
+  m_VkFFTConfiguration.inputBufferSize = &m_CorrelationDomainSize;
+  m_VkFFTConfiguration.outputBufferSize = &m_CorrelationDomainSize;
+}
+
 VkFFTResult
 VkCommon::PerformFFT()
 {
-  VkFFTResult resFFT{ VKFFT_SUCCESS };
-
-#if (VKFFT_BACKEND == CUDA)
-  cudaError resCu{ cudaSuccess };
-
-  cuFloatComplex * inputGPUBuffer{ nullptr };
-  cuFloatComplex * GPUBuffer{ nullptr };
-  cuFloatComplex * outputGPUBuffer{ nullptr };
-
-  // Allocate the in-place-computation buffer
-  const uint64_t bufferBytes{ 2UL * m_VkParameters.PSize * *m_VkFFTConfiguration.bufferSize };
-  resCu = cudaMalloc((void **)&GPUBuffer, bufferBytes);
-
-  if (resCu != cudaSuccess)
+  if (m_LineLayout.count > 0)
   {
-    std::cerr << __FILE__ "(" << __LINE__ << "): cudaMalloc returned " << resCu << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
+    return this->PerformLineFFT();
   }
-
-  m_VkFFTConfiguration.buffer = reinterpret_cast<void **>(&GPUBuffer);
-
-  if (m_VkParameters.fft == FFTEnum::C2C)
+  if (m_VkParameters.performConvolution)
   {
-    // For C2C computation we can do everything in the in-place-computation buffer.
-    inputGPUBuffer = GPUBuffer;
-    outputGPUBuffer = GPUBuffer;
+    return this->PerformConvolution();
   }
-  else
+  if (m_VkParameters.performNormalizedCorrelation)
   {
-    if (m_VkParameters.I == DirectionEnum::FORWARD)
-    {
-      outputGPUBuffer = GPUBuffer;
-
-      // Either R2FullH or R2HalfH.  For forward computation, we have a smaller input buffer.
-      const uint64_t inputBufferBytes{ 1UL * m_VkParameters.PSize * *m_VkFFTConfiguration.inputBufferSize };
-      resCu = cudaMalloc((void **)&inputGPUBuffer, inputBufferBytes);
-      if (resCu != cudaSuccess)
-      {
-        std::cerr << __FILE__ "(" << __LINE__ << "): cudaMalloc returned " << resCu << std::endl;
-        return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
-      }
-
-      m_VkFFTConfiguration.inputBuffer = reinterpret_cast<void **>(&inputGPUBuffer);
-    }
-    else
-    {
-      inputGPUBuffer = GPUBuffer;
-
-      // Either R2FullH or R2HalfH.  For inverse computation, we have a smaller output buffer.
-      uint64_t outputBufferBytes{ 1UL * m_VkParameters.PSize * *m_VkFFTConfiguration.outputBufferSize };
-      resCu = cudaMalloc((void **)&outputGPUBuffer, outputBufferBytes);
-      if (resCu != cudaSuccess)
-      {
-        std::cerr << __FILE__ "(" << __LINE__ << "): cudaMalloc returned " << resCu << std::endl;
-        return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
-      }
-      m_VkFFTConfiguration.outputBuffer = reinterpret_cast<void **>(&outputGPUBuffer);
-    }
+    return this->PerformNormalizedCorrelation();
   }
-
-  // Copy input from CPU to GPU
-  resCu =
-    cudaMemcpy(inputGPUBuffer, m_VkParameters.inputCPUBuffer, m_VkParameters.inputBufferBytes, cudaMemcpyHostToDevice);
-  if (resCu != cudaSuccess)
+  if (m_VkParameters.performPhaseCorrelation)
   {
-    std::cerr << __FILE__ "(" << __LINE__ << "): cudaMemcpy returned " << resCu << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+    return this->PerformPhaseCorrelation();
   }
-
-#elif (VKFFT_BACKEND == OPENCL)
-  cl_int resCL{ CL_SUCCESS };
-
-  // Configure the buffers.  Some of these three pointers will be nullptr or be duplicates of each
-  // other, so don't release all of them at the end.  All re-striding of data (for R2HalfH or R2FullH,
-  // regardless of forward vs. inverse) is done by VkFFT between the two GPU buffers it uses.
-  cl_mem inputGPUBuffer{ nullptr };  // Copy from CPU input buffer to this GPU buffer
-  cl_mem GPUBuffer{ nullptr };       // GPU buffer where main computation occurs
-  cl_mem outputGPUBuffer{ nullptr }; // Copy from this GPU buffer to CPU output buffer
-  if (m_VkParameters.fft == FFTEnum::C2C)
+  if (m_VkParameters.deconvolution != DeconvolutionEnum::NONE)
   {
-    // For C2C computation we can do everything in the in-place-computation buffer.
-    const uint64_t bufferBytes{ 2UL * m_VkParameters.PSize * *m_VkFFTConfiguration.bufferSize };
-    GPUBuffer = clCreateBuffer(m_VkGPU.context, CL_MEM_READ_WRITE, bufferBytes, nullptr, &resCL);
-    inputGPUBuffer = GPUBuffer;
-    outputGPUBuffer = GPUBuffer;
-    if (resCL != CL_SUCCESS)
-    {
-      std::cerr << __FILE__ "(" << __LINE__ << "): clCreateBuffer returned " << resCL << std::endl;
-      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
-    }
-    m_VkFFTConfiguration.buffer = &GPUBuffer;
+    return this->PerformDeconvolution();
   }
-  else
+  if (m_VkParameters.performGaussianSmoothing)
   {
-    // Either R2HalfH or R2FullH computation. Either forward or inverse.
-    const uint64_t bufferBytes{ 2UL * m_VkParameters.PSize * *m_VkFFTConfiguration.bufferSize };
-    GPUBuffer = clCreateBuffer(m_VkGPU.context, CL_MEM_READ_WRITE, bufferBytes, nullptr, &resCL);
-    if (resCL != CL_SUCCESS)
-    {
-      std::cerr << __FILE__ "(" << __LINE__ << "): clCreateBuffer returned " << resCL << std::endl;
-      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
-    }
-    m_VkFFTConfiguration.buffer = &GPUBuffer;
+    return this->PerformGaussianSmoothing();
+  }
 
-    if (m_VkParameters.I == DirectionEnum::FORWARD)
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // Configure the buffers.  The input and output buffers are separate from the in-place-computation
+  // buffer only where VkFFT re-strides the data between them, that is, for the real input of a
+  // forward transform and the real output of an inverse transform.
+  DeviceBufferPointer buffer;
+  resFFT = this->AllocateDeviceBuffer(2UL * m_VkParameters.PSize * *m_VkFFTConfiguration.bufferSize, buffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType GPUBuffer{ buffer->GetMemory() }; // GPU buffer where main computation occurs
+  m_VkFFTConfiguration.buffer = &GPUBuffer;
+
+  // Copy input from CPU to GPU, padding it on the device if requested
+  DeviceBufferPointer inputBuffer{ buffer };
+  if (m_VkFFTConfiguration.isInputFormatted)
+  {
+    if (m_VkParameters.boundaryCondition != BoundaryConditionEnum::NONE)
     {
-      // Either R2FullH or R2HalfH.  For forward computation, we have a smaller input buffer.
-      const uint64_t inputBufferBytes{ 1UL * m_VkParameters.PSize * *m_VkFFTConfiguration.inputBufferSize };
-      inputGPUBuffer = clCreateBuffer(m_VkGPU.context, CL_MEM_READ_WRITE, inputBufferBytes, nullptr, &resCL);
-      outputGPUBuffer = GPUBuffer;
-      if (resCL != CL_SUCCESS)
-      {
-        std::cerr << __FILE__ "(" << __LINE__ << "): clCreateBuffer returned " << resCL << std::endl;
-        return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
-      }
-      m_VkFFTConfiguration.inputBuffer = &inputGPUBuffer;
+      resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * *m_VkFFTConfiguration.inputBufferSize,
+                                          inputBuffer);
+      if (resFFT == VKFFT_SUCCESS)
+        resFFT = this->PadOnDevice(inputBuffer);
     }
     else
     {
-      // Either R2FullH or R2HalfH.  For inverse computation, we have a smaller output buffer.
-      uint64_t outputBufferBytes{ 1UL * m_VkParameters.PSize * *m_VkFFTConfiguration.outputBufferSize };
-      inputGPUBuffer = GPUBuffer;
-      outputGPUBuffer = clCreateBuffer(m_VkGPU.context, CL_MEM_READ_WRITE, outputBufferBytes, nullptr, &resCL);
-      if (resCL != CL_SUCCESS)
-      {
-        std::cerr << __FILE__ "(" << __LINE__ << "): clCreateBuffer returned " << resCL << std::endl;
-        return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
-      }
-      m_VkFFTConfiguration.outputBuffer = &outputGPUBuffer;
+      // The input buffer is only read, so a resident copy can be used as is
+      resFFT = this->AcquireInputBuffer(inputBuffer);
     }
   }
+  else if (m_VkParameters.boundaryCondition != BoundaryConditionEnum::NONE)
+  {
+    resFFT = this->PadOnDevice(buffer);
+  }
+  else
+  {
+    resFFT = this->UploadInput(buffer);
+  }
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType inputGPUBuffer{ inputBuffer->GetMemory() }; // Copy from CPU input buffer to this GPU buffer
+  if (m_VkFFTConfiguration.isInputFormatted)
+  {
+    m_VkFFTConfiguration.inputBuffer = &inputGPUBuffer;
+  }
 
-  // Copy input from CPU to GPU
-  resCL = clEnqueueWriteBuffer(m_VkGPU.commandQueue,
-                               inputGPUBuffer,
-                               CL_TRUE,
-                               0,
-                               m_VkParameters.inputBufferBytes,
-                               m_VkParameters.inputCPUBuffer,
-                               0,
-                               nullptr,
-                               nullptr);
-  if (resCL != CL_SUCCESS)
+  DeviceBufferPointer outputBuffer{ buffer };
+  if (m_VkFFTConfiguration.isOutputFormatted)
   {
-    std::cerr << __FILE__ "(" << __LINE__ << "): clEnqueueWriteBuffer returned " << resCL << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+    resFFT = this->AcquireOutputBuffer(outputBuffer);
+    if (resFFT != VKFFT_SUCCESS)
+      return resFFT;
+  }
+  DeviceMemoryType outputGPUBuffer{ outputBuffer->GetMemory() }; // Copy from this GPU buffer to CPU output buffer
+  if (m_VkFFTConfiguration.isOutputFormatted)
+  {
+    m_VkFFTConfiguration.outputBuffer = &outputGPUBuffer;
   }
-#endif
 
   // Initialize applications. This function loads shaders, creates pipeline and configures FFT based on configuration
   // file. No buffer allocations inside VkFFT library.
@@ -428,153 +695,1569 @@ VkCommon::PerformFFT()
 #endif
 
   resFFT = VkFFTAppend(&app, m_VkParameters.I == DirectionEnum::INVERSE ? 1 : -1, &launchParams);
-  if (resFFT != VKFFT_SUCCESS)
-    return resFFT;
-
-#if (VKFFT_BACKEND == CUDA)
-  resCu = cudaDeviceSynchronize();
-  if (resCu != cudaSuccess)
-  {
-    std::cerr << __FILE__ "(" << __LINE__ << "): cudaDeviceSynchronize returned " << resCu << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SYNCHRONIZE };
-  }
-
-  // Copy result from GPU to CPU
-  resCu = cudaMemcpy(
-    m_VkParameters.outputCPUBuffer, outputGPUBuffer, m_VkParameters.outputBufferBytes, cudaMemcpyDeviceToHost);
-  if (resCu != cudaSuccess)
-  {
-    std::cerr << __FILE__ "(" << __LINE__ << "): cudaMemcpy returned " << resCu << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
-  }
-
-  // Release mem buffers
-  cudaFree(inputGPUBuffer);
-  if (m_VkParameters.fft != FFTEnum::C2C)
-  {
-    cudaFree(outputGPUBuffer);
-  }
-
-#elif (VKFFT_BACKEND == OPENCL)
-  resCL = clFinish(m_VkGPU.commandQueue);
-  if (resCL != CL_SUCCESS)
-  {
-    std::cerr << __FILE__ "(" << __LINE__ << "): clFinish returned " << resCL << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SYNCHRONIZE };
-  }
 
-  // Copy result from GPU to CPU
-  resCL = clEnqueueReadBuffer(m_VkGPU.commandQueue,
-                              outputGPUBuffer,
-                              CL_TRUE,
-                              0,
-                              m_VkParameters.outputBufferBytes,
-                              m_VkParameters.outputCPUBuffer,
-                              0,
-                              nullptr,
-                              nullptr);
-  if (resCL != CL_SUCCESS)
+  if (resFFT == VKFFT_SUCCESS && m_VkParameters.fft == FFTEnum::R2FullH &&
+      m_VkParameters.I == DirectionEnum::FORWARD)
   {
-    std::cerr << __FILE__ "(" << __LINE__ << "): clEnqueueReadBuffer returned " << resCL << std::endl;
-    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+    // Compute complex conjugates for the R2FullH forward computation before downloading
+    resFFT = this->CompleteHermitianOnDevice(outputGPUBuffer);
   }
 
-  clReleaseMemObject(inputGPUBuffer);
-  if (m_VkParameters.fft != FFTEnum::C2C)
-  {
-    // Release other buffer too
-    clReleaseMemObject(outputGPUBuffer);
-  }
-#endif
+  // Copy result from GPU to CPU, unless it is to stay on the device
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->ReturnOutput(outputBuffer);
 
-  if (m_VkParameters.fft == FFTEnum::R2FullH && m_VkParameters.I == DirectionEnum::FORWARD)
-  {
-    // Compute complex conjugates for the R2FullH forward computation
-    switch (m_VkParameters.P)
-    {
-      case PrecisionEnum::FLOAT:
-      {
-        using ComplexType = std::complex<float>;
-        ComplexType * const outputCPUFloat{ reinterpret_cast<ComplexType *>(m_VkParameters.outputCPUBuffer) };
-        for (uint64_t z{ 0 }; z < m_VkFFTConfiguration.size[2]; ++z)
-        {
-          for (uint64_t y{ 0 }; y < m_VkFFTConfiguration.size[1]; ++y)
-          {
-            const uint64_t offsetStart{ z * m_VkFFTConfiguration.bufferStride[1] +
-                                        y * m_VkFFTConfiguration.bufferStride[0] };
-            const uint64_t offsetEnd{ offsetStart + m_VkFFTConfiguration.bufferStride[0] };
-            for (uint64_t x = (m_VkFFTConfiguration.size[0] - 1) / 2; x >= 1; --x)
-            {
-              outputCPUFloat[offsetEnd - x] = std::conj(outputCPUFloat[offsetStart + x]);
-            }
-          }
-        }
-      }
-      break;
-      case PrecisionEnum::DOUBLE:
-      {
-        using ComplexType = std::complex<double>;
-        ComplexType * const outputCPUDouble{ reinterpret_cast<ComplexType *>(m_VkParameters.outputCPUBuffer) };
-        for (uint64_t z{ 0 }; z < m_VkFFTConfiguration.size[2]; ++z)
-        {
-          for (uint64_t y{ 0 }; y < m_VkFFTConfiguration.size[1]; ++y)
-          {
-            const uint64_t offsetStart{ z * m_VkFFTConfiguration.bufferStride[1] +
-                                        y * m_VkFFTConfiguration.bufferStride[0] };
-            const uint64_t offsetEnd{ offsetStart + m_VkFFTConfiguration.bufferStride[0] };
-            for (uint64_t x = (m_VkFFTConfiguration.size[0] - 1) / 2; x >= 1; --x)
-            {
-              outputCPUDouble[offsetEnd - x] = std::conj(outputCPUDouble[offsetStart + x]);
-            }
-          }
-        }
-      }
-      break;
-    } // end switch (m_VkParameters.P)
-  }   // end if(m_VkParameters.fft == R2FullH && m_VkParameters.I == DirectionEnum::FORWARD)
   deleteVkFFT(&app);
 
   return resFFT;
 }
 
 VkFFTResult
-VkCommon::ReleaseBackend()
+VkCommon::PadOnDevice(const DeviceBufferPointer & paddedBuffer)
 {
-  VkFFTResult resFFT{ VKFFT_SUCCESS };
+  // Bring the unpadded input to the device
+  DeviceBufferPointer unpaddedBuffer;
+  VkFFTResult         resFFT{ this->AcquireInputBuffer(unpaddedBuffer) };
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  if (m_VkParameters.inputPixelType == InputPixelEnum::REAL)
+    return this->PadOnDevice(unpaddedBuffer, paddedBuffer);
+
+  // Convert an input of another pixel type to reals, so that only its pixels were uploaded
+  const uint64_t      unpaddedSamples{ m_VkParameters.padInputSize[0] * m_VkParameters.padInputSize[1] *
+                                  m_VkParameters.padInputSize[2] };
+  const uint64_t      pixelType{ static_cast<uint64_t>(m_VkParameters.inputPixelType) };
+  DeviceBufferPointer realBuffer;
+  resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * unpaddedSamples, realBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    const DeviceMemoryType unpaddedGPUBuffer{ unpaddedBuffer->GetMemory() };
+    const DeviceMemoryType realGPUBuffer{ realBuffer->GetMemory() };
+    resFFT = this->LaunchKernel("VkConvertInput",
+                                unpaddedSamples,
+                                { { &unpaddedGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &realGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &pixelType, sizeof(uint64_t) },
+                                  { &unpaddedSamples, sizeof(uint64_t) } });
+  }
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  return this->PadOnDevice(realBuffer, paddedBuffer);
+}
+
+VkFFTResult
+VkCommon::PadOnDevice(const DeviceBufferPointer & unpaddedBuffer, const DeviceBufferPointer & paddedBuffer)
+{
+  // Generate the padded samples of the transform domain from the unpadded input
+  const DeviceMemoryType unpaddedGPUBuffer{ unpaddedBuffer->GetMemory() };
+  const DeviceMemoryType paddedGPUBuffer{ paddedBuffer->GetMemory() };
+  const uint64_t         components{ m_VkParameters.fft == FFTEnum::C2C ? 2UL : 1UL };
+  const uint64_t         condition{ static_cast<uint64_t>(m_VkParameters.boundaryCondition) };
+  const uint64_t         paddedSamples{ m_VkFFTConfiguration.size[0] * m_VkFFTConfiguration.size[1] *
+                                m_VkFFTConfiguration.size[2] };
+  return this->LaunchKernel("VkPad",
+                            paddedSamples,
+                            { { &unpaddedGPUBuffer, sizeof(DeviceMemoryType) },
+                              { &paddedGPUBuffer, sizeof(DeviceMemoryType) },
+                              { &components, sizeof(uint64_t) },
+                              { &m_VkParameters.padInputSize[0], sizeof(uint64_t) },
+                              { &m_VkParameters.padInputSize[1], sizeof(uint64_t) },
+                              { &m_VkParameters.padInputSize[2], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                              { &m_VkParameters.padLowerBound[0], sizeof(uint64_t) },
+                              { &m_VkParameters.padLowerBound[1], sizeof(uint64_t) },
+                              { &m_VkParameters.padLowerBound[2], sizeof(uint64_t) },
+                              { &condition, sizeof(uint64_t) } });
+}
+
+VkFFTResult
+VkCommon::PerformLineFFT()
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  const bool     forward{ m_VkParameters.I == DirectionEnum::FORWARD };
+  const uint64_t one{ 1 };
+
+  // Input and output in the image layout, contiguous real lines, and contiguous half spectra
+  // where the main computation occurs
+  DeviceBufferPointer inputBuffer;
+  DeviceBufferPointer outputBuffer;
+  DeviceBufferPointer realBuffer;
+  DeviceBufferPointer buffer;
+  resFFT = this->AcquireInputBuffer(inputBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AcquireOutputBuffer(outputBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * m_LineLayout.realBufferSize, realBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(2UL * m_VkParameters.PSize * m_LineLayout.complexBufferSize, buffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType inputGPUBuffer{ inputBuffer->GetMemory() };
+  DeviceMemoryType outputGPUBuffer{ outputBuffer->GetMemory() };
+  DeviceMemoryType realGPUBuffer{ realBuffer->GetMemory() };
+  DeviceMemoryType GPUBuffer{ buffer->GetMemory() };
+  m_VkFFTConfiguration.buffer = &GPUBuffer;
+  if (forward)
+  {
+    m_VkFFTConfiguration.inputBuffer = &realGPUBuffer;
+  }
+  else
+  {
+    m_VkFFTConfiguration.outputBuffer = &realGPUBuffer;
+  }
+
+  // Make the lines contiguous. The inverse transform only needs the non-redundant half of
+  // the full spectrum.
+  resFFT = forward ? this->LaunchKernel("VkGatherLines",
+                                        m_LineLayout.realBufferSize,
+                                        { { &inputGPUBuffer, sizeof(DeviceMemoryType) },
+                                          { &realGPUBuffer, sizeof(DeviceMemoryType) },
+                                          { &one, sizeof(uint64_t) },
+                                          { &m_LineLayout.length, sizeof(uint64_t) },
+                                          { &m_LineLayout.stride, sizeof(uint64_t) },
+                                          { &m_LineLayout.count, sizeof(uint64_t) } })
+                   : this->LaunchKernel("VkGatherHalfLines",
+                                        m_LineLayout.complexBufferSize,
+                                        { { &inputGPUBuffer, sizeof(DeviceMemoryType) },
+                                          { &GPUBuffer, sizeof(DeviceMemoryType) },
+                                          { &m_LineLayout.length, sizeof(uint64_t) },
+                                          { &m_LineLayout.stride, sizeof(uint64_t) },
+                                          { &m_LineLayout.count, sizeof(uint64_t) } });
+
+  // Transform all lines as one batch
+  VkFFTApplication app{};
+  bool             initialized{ false };
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    resFFT = initializeVkFFT(&app, m_VkFFTConfiguration);
+    initialized = (resFFT == VKFFT_SUCCESS);
+  }
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    VkFFTLaunchParams launchParams{};
+    launchParams.inputBuffer = m_VkFFTConfiguration.inputBuffer;
+    launchParams.buffer = m_VkFFTConfiguration.buffer;
+    launchParams.outputBuffer = m_VkFFTConfiguration.outputBuffer;
+#if (VKFFT_BACKEND == CUDA)
+    // pass
+#elif (VKFFT_BACKEND == OPENCL)
+    launchParams.commandQueue = &m_VkGPU.commandQueue;
+#endif
+    resFFT = VkFFTAppend(&app, forward ? -1 : 1, &launchParams);
+  }
+
+  // Return the lines to the image layout, expanding the forward result to the full spectrum
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    resFFT = forward ? this->LaunchKernel("VkExpandHalfLines",
+                                          m_LineLayout.realBufferSize,
+                                          { { &GPUBuffer, sizeof(DeviceMemoryType) },
+                                            { &outputGPUBuffer, sizeof(DeviceMemoryType) },
+                                            { &m_LineLayout.length, sizeof(uint64_t) },
+                                            { &m_LineLayout.stride, sizeof(uint64_t) },
+                                            { &m_LineLayout.count, sizeof(uint64_t) } })
+                     : this->LaunchKernel("VkScatterLines",
+                                          m_LineLayout.realBufferSize,
+                                          { { &realGPUBuffer, sizeof(DeviceMemoryType) },
+                                            { &outputGPUBuffer, sizeof(DeviceMemoryType) },
+                                            { &one, sizeof(uint64_t) },
+                                            { &m_LineLayout.length, sizeof(uint64_t) },
+                                            { &m_LineLayout.stride, sizeof(uint64_t) },
+                                            { &m_LineLayout.count, sizeof(uint64_t) } });
+  }
+
+  // Copy result from GPU to CPU, unless it is to stay on the device
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->ReturnOutput(outputBuffer);
+
+  if (initialized)
+  {
+    deleteVkFFT(&app);
+  }
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::PerformConvolution()
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // The padded input, the in-place-computation buffer, the kernel spectra, and the outputs of
+  // the convolution domain, which are cropped into the output buffer unless they coincide
+  const uint64_t      numberKernels{ m_VkParameters.numberKernels };
+  const uint64_t      domainSamples{ *m_VkFFTConfiguration.inputBufferSize };
+  const uint64_t      cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                              m_VkParameters.cropSize[2] };
+  const uint64_t      spectrumBytes{ 2UL * m_VkParameters.PSize * *m_VkFFTConfiguration.bufferSize };
+  const bool          cropped{ domainSamples != cropSamples };
+  const bool          returnOutput{ m_VkParameters.outputCPUBuffer != nullptr ||
+                           m_VkParameters.outputGPUBuffer != nullptr };
+  DeviceBufferPointer paddedBuffer;
+  DeviceBufferPointer buffer;
+  DeviceBufferPointer kernelBuffer;
+  DeviceBufferPointer outputBuffer;
+  DeviceBufferPointer domainBuffer;
+  resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * domainSamples, paddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(spectrumBytes, buffer);
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    if (returnOutput)
+      resFFT = this->AcquireOutputBuffer(outputBuffer);
+    else
+      resFFT = this->AllocateDeviceBuffer(numberKernels * m_VkParameters.PSize * cropSamples, outputBuffer);
+  }
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    domainBuffer = outputBuffer;
+    if (cropped)
+      resFFT = this->AllocateDeviceBuffer(numberKernels * m_VkParameters.PSize * domainSamples, domainBuffer);
+  }
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->PadOnDevice(paddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AcquireKernelSpectrum(kernelBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType inputGPUBuffer{ paddedBuffer->GetMemory() };
+  DeviceMemoryType GPUBuffer{ buffer->GetMemory() };
+  DeviceMemoryType kernelGPUBuffer{ kernelBuffer->GetMemory() };
+  DeviceMemoryType domainGPUBuffer{ domainBuffer->GetMemory() };
+  m_VkFFTConfiguration.inputBuffer = &inputGPUBuffer;
+  m_VkFFTConfiguration.buffer = &GPUBuffer;
+  m_VkFFTConfiguration.kernel = &kernelGPUBuffer;
+  m_VkFFTConfiguration.outputBuffer = &domainGPUBuffer;
+
+  // Forward transform, multiplication by the kernel spectra and inverse transforms in one pass
+  VkFFTApplication app{};
+  resFFT = initializeVkFFT(&app, m_VkFFTConfiguration);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  VkFFTLaunchParams launchParams{};
+  launchParams.inputBuffer = m_VkFFTConfiguration.inputBuffer;
+  launchParams.buffer = m_VkFFTConfiguration.buffer;
+  launchParams.kernel = m_VkFFTConfiguration.kernel;
+  launchParams.outputBuffer = m_VkFFTConfiguration.outputBuffer;
+#if (VKFFT_BACKEND == CUDA)
+  // pass
+#elif (VKFFT_BACKEND == OPENCL)
+  launchParams.commandQueue = &m_VkGPU.commandQueue;
+#endif
+  resFFT = VkFFTAppend(&app, -1, &launchParams);
+
+  if (resFFT == VKFFT_SUCCESS && cropped)
+  {
+    const DeviceMemoryType outputGPUBuffer{ outputBuffer->GetMemory() };
+    const uint64_t         one{ 1 };
+    resFFT = this->LaunchKernel("VkCrop",
+                                numberKernels * cropSamples,
+                                { { &domainGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &outputGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &one, sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[0], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[1], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[2], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropLowerBound[0], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropLowerBound[1], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropLowerBound[2], sizeof(uint64_t) },
+                                  { &numberKernels, sizeof(uint64_t) } });
+  }
+
+  if (resFFT == VKFFT_SUCCESS && m_VkParameters.normalizeCorrelation)
+    resFFT = this->NormalizeCorrelation(paddedBuffer, outputBuffer);
+
+  // Copy result from GPU to CPU, unless it is to stay on the device
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  if (resFFT == VKFFT_SUCCESS && (m_VkParameters.peakIndices != nullptr || m_VkParameters.peakValues != nullptr))
+    resFFT = this->FindMaxima(
+      outputBuffer, cropSamples, numberKernels, m_VkParameters.peakIndices, m_VkParameters.peakValues);
+  if (resFFT == VKFFT_SUCCESS && returnOutput)
+    resFFT = this->ReturnOutput(outputBuffer);
+
+  deleteVkFFT(&app);
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::NormalizeCorrelation(const DeviceBufferPointer & paddedBuffer, const DeviceBufferPointer & mapBuffer)
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // The sums of the padded input and of its squares over the kernel window that starts at each
+  // sample of the domain, in two domains that follow one another. They are summed along one
+  // dimension after the other, alternating between two buffers.
+  const uint64_t      domainSamples{ *m_VkFFTConfiguration.inputBufferSize };
+  const uint64_t      sumSamples{ 2 * domainSamples };
+  DeviceBufferPointer sumBuffer;
+  DeviceBufferPointer swapBuffer;
+  resFFT = this->AllocateDeviceBuffer(sumSamples * m_VkParameters.PSize, sumBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(sumSamples * m_VkParameters.PSize, swapBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType inputGPUBuffer{ paddedBuffer->GetMemory() };
+  DeviceMemoryType sumGPUBuffer{ sumBuffer->GetMemory() };
+  DeviceMemoryType swapGPUBuffer{ swapBuffer->GetMemory() };
+  uint64_t         stride{ 1 };
+  for (unsigned int dim{ 0 }; dim < 3 && resFFT == VKFFT_SUCCESS; ++dim)
+  {
+    const uint64_t square{ dim == 0 ? 1UL : 0UL };
+    if (square || m_VkParameters.kernelSize[dim] > 1)
+    {
+      resFFT = this->LaunchKernel("VkWindowSums",
+                                  sumSamples,
+                                  { { &inputGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &swapGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &square, sizeof(uint64_t) },
+                                    { &m_VkParameters.kernelSize[dim], sizeof(uint64_t) },
+                                    { &stride, sizeof(uint64_t) },
+                                    { &m_VkFFTConfiguration.size[dim], sizeof(uint64_t) },
+                                    { &sumSamples, sizeof(uint64_t) } });
+      std::swap(sumGPUBuffer, swapGPUBuffer);
+      inputGPUBuffer = sumGPUBuffer;
+    }
+    stride *= m_VkFFTConfiguration.size[dim];
+  }
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  // The kernels were given zero mean and unit norm, so that dividing the maps by the norm of the
+  // zero-mean input under the window yields the normalized cross-correlation
+  const uint64_t         numberKernels{ m_VkParameters.numberKernels };
+  const uint64_t         cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                              m_VkParameters.cropSize[2] };
+  const DeviceMemoryType mapGPUBuffer{ mapBuffer->GetMemory() };
+  const bool             doublePrecision{ m_VkParameters.P == PrecisionEnum::DOUBLE };
+  const double           window{ static_cast<double>(m_VkParameters.kernelSize[0] * m_VkParameters.kernelSize[1] *
+                                               m_VkParameters.kernelSize[2]) };
+  const double           epsilon{ 1000.0 * (doublePrecision ? std::numeric_limits<double>::epsilon()
+                                                            : std::numeric_limits<float>::epsilon()) };
+  const float            floatWindow{ static_cast<float>(window) };
+  const float            floatEpsilon{ static_cast<float>(epsilon) };
+  return this->LaunchKernel("VkNormalizeMatches",
+                            numberKernels * cropSamples,
+                            { { &mapGPUBuffer, sizeof(DeviceMemoryType) },
+                              { &inputGPUBuffer, sizeof(DeviceMemoryType) },
+                              { &domainSamples, sizeof(uint64_t) },
+                              doublePrecision ? KernelArgument{ &window, sizeof(double) }
+                                              : KernelArgument{ &floatWindow, sizeof(float) },
+                              doublePrecision ? KernelArgument{ &epsilon, sizeof(double) }
+                                              : KernelArgument{ &floatEpsilon, sizeof(float) },
+                              { &m_VkParameters.cropSize[0], sizeof(uint64_t) },
+                              { &m_VkParameters.cropSize[1], sizeof(uint64_t) },
+                              { &m_VkParameters.cropSize[2], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                              { &numberKernels, sizeof(uint64_t) } });
+}
+
+VkFFTResult
+VkCommon::PlaceKernel(const DeviceBufferPointer & placedBuffer)
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // Bring the kernels to the device
+  DeviceBufferPointer kernelInputBuffer{ m_VkParameters.kernelGPUBuffer };
+  if (kernelInputBuffer)
+  {
+    itkAssertOrThrowMacro(kernelInputBuffer->GetBytes() == m_VkParameters.kernelBufferBytes,
+                          "Kernel device buffer is of a different size.");
+  }
+  else
+  {
+    resFFT = this->AllocateDeviceBuffer(m_VkParameters.kernelBufferBytes, kernelInputBuffer);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = this->CopyHostToDevice(
+        kernelInputBuffer->GetMemory(), m_VkParameters.kernelCPUBuffer, m_VkParameters.kernelBufferBytes);
+  }
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  // Move the kernel centers to the origin of the zero-padded domain, mirrored for a correlation
+  const uint64_t       numberKernels{ m_VkParameters.numberKernels };
+  DeviceMemoryType     kernelInputGPUBuffer{ kernelInputBuffer->GetMemory() };
+  DeviceMemoryType     placedGPUBuffer{ placedBuffer->GetMemory() };
+  const float          floatScale{ static_cast<float>(m_VkParameters.kernelScale) };
+  const KernelArgument scale{ m_VkParameters.P == PrecisionEnum::DOUBLE
+                                ? KernelArgument{ &m_VkParameters.kernelScale, sizeof(double) }
+                                : KernelArgument{ &floatScale, sizeof(float) } };
+  return this->LaunchKernel("VkPlaceKernel",
+                            numberKernels * *m_VkFFTConfiguration.inputBufferSize,
+                            { { &kernelInputGPUBuffer, sizeof(DeviceMemoryType) },
+                              { &placedGPUBuffer, sizeof(DeviceMemoryType) },
+                              scale,
+                              { &m_VkParameters.kernelSize[0], sizeof(uint64_t) },
+                              { &m_VkParameters.kernelSize[1], sizeof(uint64_t) },
+                              { &m_VkParameters.kernelSize[2], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                              { &m_VkParameters.kernelCenter[0], sizeof(uint64_t) },
+                              { &m_VkParameters.kernelCenter[1], sizeof(uint64_t) },
+                              { &m_VkParameters.kernelCenter[2], sizeof(uint64_t) },
+                              { &m_VkParameters.correlation, sizeof(uint64_t) },
+                              { &numberKernels, sizeof(uint64_t) } });
+}
+
+VkFFTResult
+VkCommon::TransformKernel(const DeviceBufferPointer & kernelBuffer)
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // Place the kernels in the zero-padded domain
+  const uint64_t      numberKernels{ m_VkParameters.numberKernels };
+  DeviceBufferPointer placedBuffer;
+  resFFT = this->AllocateDeviceBuffer(numberKernels * m_VkParameters.PSize * *m_VkFFTConfiguration.inputBufferSize,
+                                      placedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->PlaceKernel(placedBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType placedGPUBuffer{ placedBuffer->GetMemory() };
+  DeviceMemoryType kernelGPUBuffer{ kernelBuffer->GetMemory() };
+
+  // Transform them as a batch with a forward plan of the same layout as the convolution, marked
+  // for kernel creation so that VkFFT stores the spectra the way the convolution reads them
+  VkFFTConfiguration kernelConfiguration{ m_VkFFTConfiguration };
+  kernelConfiguration.performConvolution = 0;
+  kernelConfiguration.kernelConvolution = 1;
+  kernelConfiguration.numberKernels = 1;
+  kernelConfiguration.numberBatches = numberKernels;
+  kernelConfiguration.makeForwardPlanOnly = 1;
+  kernelConfiguration.isOutputFormatted = 0;
+  kernelConfiguration.kernel = nullptr;
+  kernelConfiguration.kernelSize = nullptr;
+  kernelConfiguration.inputBuffer = &placedGPUBuffer;
+  kernelConfiguration.buffer = &kernelGPUBuffer;
+  kernelConfiguration.outputBuffer = nullptr;
+
+  VkFFTApplication app{};
+  resFFT = initializeVkFFT(&app, kernelConfiguration);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  VkFFTLaunchParams launchParams{};
+  launchParams.inputBuffer = kernelConfiguration.inputBuffer;
+  launchParams.buffer = kernelConfiguration.buffer;
+#if (VKFFT_BACKEND == CUDA)
+  // pass
+#elif (VKFFT_BACKEND == OPENCL)
+  launchParams.commandQueue = &m_VkGPU.commandQueue;
+#endif
+  resFFT = VkFFTAppend(&app, -1, &launchParams);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+
+  deleteVkFFT(&app);
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::AcquireKernelSpectrum(DeviceBufferPointer & kernelBuffer)
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  VkDeviceContext::KernelSpectrumKey key;
+  key.dataObject = m_VkParameters.kernelDataObject;
+  key.timeStamp = m_VkParameters.kernelTimeStamp;
+  key.precision = m_VkParameters.P;
+  for (size_t dim{ 0 }; dim < 3; ++dim)
+  {
+    key.size[dim] = m_VkFFTConfiguration.size[dim];
+    key.center[dim] = m_VkParameters.kernelCenter[dim];
+  }
+  key.scale = m_VkParameters.kernelScale;
+  key.numberKernels = m_VkParameters.numberKernels;
+  key.correlation = m_VkParameters.correlation;
+  const uint64_t budget{ VkGlobalConfiguration::GetKernelSpectrumCacheBudget() };
+  const bool     caching{ key.dataObject != nullptr && budget > 0 };
+  if (caching)
+  {
+    kernelBuffer = m_DeviceContext->FindKernelSpectrum(key);
+    if (kernelBuffer)
+    {
+      return resFFT;
+    }
+  }
+
+  // The convolution only reads the kernel spectra, so cached ones are used as is
+  resFFT = this->AllocateDeviceBuffer(2UL * m_VkParameters.PSize * m_ConvolutionKernelSize, kernelBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->TransformKernel(kernelBuffer);
+  if (resFFT == VKFFT_SUCCESS && caching)
+  {
+    m_DeviceContext->KeepKernelSpectrum(key, kernelBuffer, budget);
+  }
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::FindMaxima(const DeviceBufferPointer & buffer,
+                     uint64_t                    samples,
+                     uint64_t                    count,
+                     uint64_t *                  indices,
+                     double *                    values)
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // Each array is split into at most peakChunks chunks that are searched in parallel
+  constexpr uint64_t  peakChunks{ 1024 };
+  const uint64_t      chunkLength{ (samples + peakChunks - 1) / peakChunks };
+  const uint64_t      chunks{ (samples + chunkLength - 1) / chunkLength };
+  DeviceBufferPointer valueBuffer;
+  DeviceBufferPointer indexBuffer;
+  resFFT = this->AllocateDeviceBuffer(count * chunks * m_VkParameters.PSize, valueBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(count * chunks * sizeof(uint64_t), indexBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  const DeviceMemoryType inputGPUBuffer{ buffer->GetMemory() };
+  const DeviceMemoryType valueGPUBuffer{ valueBuffer->GetMemory() };
+  const DeviceMemoryType indexGPUBuffer{ indexBuffer->GetMemory() };
+  resFFT = this->LaunchKernel("VkPeakSearch",
+                              count * chunks,
+                              { { &inputGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &valueGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &indexGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &samples, sizeof(uint64_t) },
+                                { &chunkLength, sizeof(uint64_t) },
+                                { &chunks, sizeof(uint64_t) },
+                                { &count, sizeof(uint64_t) } });
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+
+  // Compare the maxima of the chunks of each array
+  std::vector<double>   chunkValues(count * chunks);
+  std::vector<uint64_t> chunkIndices(count * chunks);
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    if (m_VkParameters.P == PrecisionEnum::DOUBLE)
+    {
+      resFFT = this->CopyDeviceToHost(chunkValues.data(), valueGPUBuffer, chunkValues.size() * sizeof(double));
+    }
+    else
+    {
+      std::vector<float> floatValues(chunkValues.size());
+      resFFT = this->CopyDeviceToHost(floatValues.data(), valueGPUBuffer, floatValues.size() * sizeof(float));
+      std::copy(floatValues.cbegin(), floatValues.cend(), chunkValues.begin());
+    }
+  }
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->CopyDeviceToHost(chunkIndices.data(), indexGPUBuffer, chunkIndices.size() * sizeof(uint64_t));
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  for (uint64_t array{ 0 }; array < count; ++array)
+  {
+    uint64_t peak{ array * chunks };
+    for (uint64_t chunk{ peak + 1 }; chunk < (array + 1) * chunks; ++chunk)
+    {
+      if (chunkValues[chunk] > chunkValues[peak])
+      {
+        peak = chunk;
+      }
+    }
+    if (indices != nullptr)
+      indices[array] = chunkIndices[peak];
+    if (values != nullptr)
+      values[array] = chunkValues[peak];
+  }
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::PerformNormalizedCorrelation()
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // The fixed and moving images and masks, the six padded images, their half spectra and the
+  // six correlation terms, and the output
+  const uint64_t      domainSamples{ m_VkFFTConfiguration.inputBufferStride[2] };
+  const uint64_t      spectrumSamples{ m_VkFFTConfiguration.bufferStride[2] };
+  const uint64_t      cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                              m_VkParameters.cropSize[2] };
+  DeviceBufferPointer fixedBuffer;
+  DeviceBufferPointer movingBuffer;
+  DeviceBufferPointer fixedMaskBuffer;
+  DeviceBufferPointer movingMaskBuffer;
+  DeviceBufferPointer paddedBuffer;
+  DeviceBufferPointer buffer;
+  DeviceBufferPointer termBuffer;
+  DeviceBufferPointer outputBuffer;
+  resFFT = this->AcquireInputBuffer(fixedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AcquireMovingBuffer(movingBuffer);
+  if (resFFT == VKFFT_SUCCESS && m_VkParameters.inputMaskCPUBuffer != nullptr)
+  {
+    resFFT = this->AllocateDeviceBuffer(m_VkParameters.inputBufferBytes, fixedMaskBuffer);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = this->CopyHostToDevice(
+        fixedMaskBuffer->GetMemory(), m_VkParameters.inputMaskCPUBuffer, m_VkParameters.inputBufferBytes);
+  }
+  if (resFFT == VKFFT_SUCCESS && m_VkParameters.movingMaskCPUBuffer != nullptr)
+  {
+    resFFT = this->AllocateDeviceBuffer(m_VkParameters.movingBufferBytes, movingMaskBuffer);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = this->CopyHostToDevice(
+        movingMaskBuffer->GetMemory(), m_VkParameters.movingMaskCPUBuffer, m_VkParameters.movingBufferBytes);
+  }
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * m_CorrelationDomainSize, paddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(2UL * m_VkParameters.PSize * m_CorrelationSpectrumSize, buffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * m_CorrelationDomainSize, termBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AcquireOutputBuffer(outputBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  // Pad the masked fixed image, its square and its mask, followed by the same for the moving
+  // image, rotated by 180 degrees. A missing mask selects all pixels.
+  DeviceMemoryType paddedGPUBuffer{ paddedBuffer->GetMemory() };
+  for (uint64_t moving{ 0 }; moving < 2; ++moving)
+  {
+    const DeviceBufferPointer & imageBuffer{ moving ? movingBuffer : fixedBuffer };
+    const DeviceBufferPointer & maskBuffer{ moving ? movingMaskBuffer : fixedMaskBuffer };
+    const uint64_t *            size{ moving ? m_VkParameters.movingSize : m_VkParameters.padInputSize };
+    const DeviceMemoryType      imageGPUBuffer{ imageBuffer->GetMemory() };
+    const DeviceMemoryType      maskGPUBuffer{ maskBuffer ? maskBuffer->GetMemory() : imageGPUBuffer };
+    const uint64_t              hasMask{ maskBuffer ? 1UL : 0UL };
+    const uint64_t              offset{ 3 * moving * domainSamples };
+    resFFT = this->LaunchKernel("VkPlaceMaskedImage",
+                                domainSamples,
+                                { { &imageGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &maskGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &paddedGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &offset, sizeof(uint64_t) },
+                                  { &hasMask, sizeof(uint64_t) },
+                                  { &moving, sizeof(uint64_t) },
+                                  { &size[0], sizeof(uint64_t) },
+                                  { &size[1], sizeof(uint64_t) },
+                                  { &size[2], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) } });
+    if (resFFT != VKFFT_SUCCESS)
+      return resFFT;
+  }
+
+  DeviceMemoryType GPUBuffer{ buffer->GetMemory() };
+  DeviceMemoryType termGPUBuffer{ termBuffer->GetMemory() };
+  m_VkFFTConfiguration.inputBuffer = &paddedGPUBuffer;
+  m_VkFFTConfiguration.buffer = &GPUBuffer;
+  m_VkFFTConfiguration.outputBuffer = &termGPUBuffer;
+
+  VkFFTApplication app{};
+  resFFT = initializeVkFFT(&app, m_VkFFTConfiguration);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  // Forward transform of the six images, multiplication of their spectra in place, and inverse
+  // transform of the six products with the same plan
+  VkFFTLaunchParams launchParams{};
+  launchParams.inputBuffer = m_VkFFTConfiguration.inputBuffer;
+  launchParams.buffer = m_VkFFTConfiguration.buffer;
+  launchParams.outputBuffer = m_VkFFTConfiguration.outputBuffer;
+#if (VKFFT_BACKEND == CUDA)
+  // pass
+#elif (VKFFT_BACKEND == OPENCL)
+  launchParams.commandQueue = &m_VkGPU.commandQueue;
+#endif
+  resFFT = VkFFTAppend(&app, -1, &launchParams);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->LaunchKernel("VkCorrelationProducts",
+                                spectrumSamples,
+                                { { &GPUBuffer, sizeof(DeviceMemoryType) }, { &spectrumSamples, sizeof(uint64_t) } });
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = VkFFTAppend(&app, 1, &launchParams);
+
+  // Combine the terms over the output region into the denominator, the number of overlapping
+  // pixels and the numerator, in the padded buffer that is no longer needed
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->LaunchKernel("VkCorrelationTerms",
+                                cropSamples,
+                                { { &termGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &paddedGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &domainSamples, sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[0], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[1], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[2], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) } });
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  deleteVkFFT(&app);
+
+  // The largest denominator sets the precision tolerance below which the correlation is zero,
+  // and the largest overlap the required overlap, as in MaskedFFTNormalizedCorrelationImageFilter
+  double maxima[2]{ 0.0, 0.0 };
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->FindMaxima(paddedBuffer, cropSamples, 2, nullptr, maxima);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  const double epsilon{ m_VkParameters.P == PrecisionEnum::DOUBLE ? std::numeric_limits<double>::epsilon()
+                                                                   : std::numeric_limits<float>::epsilon() };
+  const double tolerance{ maxima[0] > 0.0 ? 1000.0 * epsilon * std::pow(2.0, std::floor(std::log2(maxima[0])))
+                                          : 0.0 };
+  const double requiredOverlap{ std::max(m_VkParameters.requiredOverlapFraction * maxima[1],
+                                         static_cast<double>(m_VkParameters.requiredOverlap)) };
+
+  const DeviceMemoryType outputGPUBuffer{ outputBuffer->GetMemory() };
+  const float            floatTolerance{ static_cast<float>(tolerance) };
+  const float            floatRequiredOverlap{ static_cast<float>(requiredOverlap) };
+  const bool             doublePrecision{ m_VkParameters.P == PrecisionEnum::DOUBLE };
+  resFFT = this->LaunchKernel("VkNormalizedCorrelation",
+                              cropSamples,
+                              { { &paddedGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &outputGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &cropSamples, sizeof(uint64_t) },
+                                doublePrecision ? KernelArgument{ &tolerance, sizeof(double) }
+                                                : KernelArgument{ &floatTolerance, sizeof(float) },
+                                doublePrecision ? KernelArgument{ &requiredOverlap, sizeof(double) }
+                                                : KernelArgument{ &floatRequiredOverlap, sizeof(float) } });
+
+  // Copy result from GPU to CPU, unless it is to stay on the device
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->ReturnOutput(outputBuffer);
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::PerformPhaseCorrelation()
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
 
-  // Return to launchVkFFT code
+  // The padded input and moving image and their half spectra. The correlation surface replaces
+  // the padded input.
+  const uint64_t      domainSamples{ m_VkFFTConfiguration.inputBufferStride[2] };
+  const uint64_t      spectrumSamples{ m_VkFFTConfiguration.bufferStride[2] };
+  DeviceBufferPointer movingBuffer;
+  DeviceBufferPointer fixedPaddedBuffer;
+  DeviceBufferPointer movingPaddedBuffer;
+  DeviceBufferPointer fixedSpectrumBuffer;
+  DeviceBufferPointer movingSpectrumBuffer;
+  resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * domainSamples, fixedPaddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * domainSamples, movingPaddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(2UL * m_VkParameters.PSize * spectrumSamples, fixedSpectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(2UL * m_VkParameters.PSize * spectrumSamples, movingSpectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->PadOnDevice(fixedPaddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AcquireMovingBuffer(movingBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->PadOnDevice(movingBuffer, movingPaddedBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType fixedPaddedGPUBuffer{ fixedPaddedBuffer->GetMemory() };
+  DeviceMemoryType movingPaddedGPUBuffer{ movingPaddedBuffer->GetMemory() };
+  DeviceMemoryType fixedSpectrumGPUBuffer{ fixedSpectrumBuffer->GetMemory() };
+  DeviceMemoryType movingSpectrumGPUBuffer{ movingSpectrumBuffer->GetMemory() };
+  m_VkFFTConfiguration.inputBuffer = &fixedPaddedGPUBuffer;
+  m_VkFFTConfiguration.buffer = &fixedSpectrumGPUBuffer;
+  m_VkFFTConfiguration.outputBuffer = &fixedPaddedGPUBuffer;
+
+  VkFFTApplication app{};
+  resFFT = initializeVkFFT(&app, m_VkFFTConfiguration);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  // Forward transforms of both images, normalization of the cross-power spectrum in place of the
+  // spectrum of the input, and inverse transform into the correlation surface
+  VkFFTLaunchParams fixedLaunchParams{};
+  fixedLaunchParams.inputBuffer = &fixedPaddedGPUBuffer;
+  fixedLaunchParams.buffer = &fixedSpectrumGPUBuffer;
+  fixedLaunchParams.outputBuffer = &fixedPaddedGPUBuffer;
 #if (VKFFT_BACKEND == CUDA)
-  if (m_VkGPU.context)
+  // pass
+#elif (VKFFT_BACKEND == OPENCL)
+  fixedLaunchParams.commandQueue = &m_VkGPU.commandQueue;
+#endif
+  VkFFTLaunchParams movingLaunchParams{ fixedLaunchParams };
+  movingLaunchParams.inputBuffer = &movingPaddedGPUBuffer;
+  movingLaunchParams.buffer = &movingSpectrumGPUBuffer;
+  resFFT = VkFFTAppend(&app, -1, &fixedLaunchParams);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = VkFFTAppend(&app, -1, &movingLaunchParams);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->LaunchKernel("VkCrossPowerSpectrum",
+                                spectrumSamples,
+                                { { &fixedSpectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &movingSpectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &spectrumSamples, sizeof(uint64_t) } });
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = VkFFTAppend(&app, 1, &fixedLaunchParams);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  deleteVkFFT(&app);
+
+  // Only the maxima of the chunks of the surface and the refined position of its peak are
+  // downloaded
+  uint64_t peak{ 0 };
+  double   peakValue{ 0.0 };
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->FindMaxima(fixedPaddedBuffer, domainSamples, 1, &peak, &peakValue);
+  DeviceBufferPointer shiftBuffer;
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(3UL * m_VkParameters.PSize, shiftBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  const DeviceMemoryType shiftGPUBuffer{ shiftBuffer->GetMemory() };
+  resFFT = this->LaunchKernel("VkRefinePeak",
+                              3,
+                              { { &fixedPaddedGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &shiftGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &peak, sizeof(uint64_t) },
+                                { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                                { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) } });
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  double shift[3]{ 0.0, 0.0, 0.0 };
+  if (resFFT == VKFFT_SUCCESS)
   {
-    cuCtxDestroy(m_VkGPU.context);
+    if (m_VkParameters.P == PrecisionEnum::DOUBLE)
+    {
+      resFFT = this->CopyDeviceToHost(shift, shiftGPUBuffer, sizeof(shift));
+    }
+    else
+    {
+      float floatShift[3];
+      resFFT = this->CopyDeviceToHost(floatShift, shiftGPUBuffer, sizeof(floatShift));
+      std::copy(floatShift, floatShift + 3, shift);
+    }
   }
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  if (m_VkParameters.phaseShift != nullptr)
+    std::copy(shift, shift + 3, m_VkParameters.phaseShift);
+  if (m_VkParameters.peakIndices != nullptr)
+    m_VkParameters.peakIndices[0] = peak;
+  if (m_VkParameters.peakValues != nullptr)
+    m_VkParameters.peakValues[0] = peakValue;
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::PerformDeconvolution()
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // The padded input, the estimate and an intermediate image of the domain, and the transfer
+  // function and an intermediate spectrum. The Landweber iteration runs on the spectrum of the
+  // estimate, from the spectrum of the input, and transforms it back only when the estimate is
+  // downloaded. A direct deconvolution divides the spectrum of the input once, without iterations.
+  const bool          landweber{ m_VkParameters.deconvolution == DeconvolutionEnum::LANDWEBER };
+  const bool          direct{ m_VkParameters.deconvolution == DeconvolutionEnum::INVERSE ||
+                              m_VkParameters.deconvolution == DeconvolutionEnum::TIKHONOV ||
+                              m_VkParameters.deconvolution == DeconvolutionEnum::WIENER };
+  const uint64_t      numberIterations{ direct ? 0UL : m_VkParameters.numberIterations };
+  const uint64_t      domainSamples{ m_VkFFTConfiguration.inputBufferStride[2] };
+  const uint64_t      spectrumSamples{ m_VkFFTConfiguration.bufferStride[2] };
+  const uint64_t      cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                              m_VkParameters.cropSize[2] };
+  const uint64_t      domainBytes{ 1UL * m_VkParameters.PSize * domainSamples };
+  const uint64_t      spectrumBytes{ 2UL * m_VkParameters.PSize * spectrumSamples };
+  DeviceBufferPointer paddedBuffer;
+  DeviceBufferPointer estimateBuffer;
+  DeviceBufferPointer workBuffer;
+  DeviceBufferPointer transferBuffer;
+  DeviceBufferPointer spectrumBuffer;
+  DeviceBufferPointer inputSpectrumBuffer;
+  DeviceBufferPointer estimateSpectrumBuffer;
+  DeviceBufferPointer outputBuffer;
+  resFFT = this->AllocateDeviceBuffer(domainBytes, paddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(domainBytes, estimateBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(domainBytes, workBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(spectrumBytes, transferBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(spectrumBytes, spectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS && landweber)
+    resFFT = this->AllocateDeviceBuffer(spectrumBytes, inputSpectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS && landweber)
+    resFFT = this->AllocateDeviceBuffer(spectrumBytes, estimateSpectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AcquireOutputBuffer(outputBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->PadOnDevice(paddedBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->PlaceKernel(workBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType paddedGPUBuffer{ paddedBuffer->GetMemory() };
+  DeviceMemoryType estimateGPUBuffer{ estimateBuffer->GetMemory() };
+  DeviceMemoryType workGPUBuffer{ workBuffer->GetMemory() };
+  DeviceMemoryType transferGPUBuffer{ transferBuffer->GetMemory() };
+  DeviceMemoryType spectrumGPUBuffer{ spectrumBuffer->GetMemory() };
+  DeviceMemoryType inputSpectrumGPUBuffer{ landweber ? inputSpectrumBuffer->GetMemory() : DeviceMemoryType{} };
+  DeviceMemoryType estimateSpectrumGPUBuffer{ landweber ? estimateSpectrumBuffer->GetMemory() : DeviceMemoryType{} };
+  m_VkFFTConfiguration.inputBuffer = &workGPUBuffer;
+  m_VkFFTConfiguration.buffer = &transferGPUBuffer;
+  m_VkFFTConfiguration.outputBuffer = &workGPUBuffer;
+
+  VkFFTApplication app{};
+  resFFT = initializeVkFFT(&app, m_VkFFTConfiguration);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  // Transform between a real image of the domain and a half spectrum with the one plan
+  const auto transform = [this, &app](int direction, DeviceMemoryType * image, DeviceMemoryType * spectrum) {
+    VkFFTLaunchParams launchParams{};
+    launchParams.inputBuffer = image;
+    launchParams.buffer = spectrum;
+    launchParams.outputBuffer = image;
+#if (VKFFT_BACKEND == CUDA)
+    // pass
 #elif (VKFFT_BACKEND == OPENCL)
-  cl_int resCL{ CL_SUCCESS };
+    launchParams.commandQueue = &m_VkGPU.commandQueue;
+#endif
+    return VkFFTAppend(&app, direction, &launchParams);
+  };
+  const uint64_t one{ 1 };
+  const uint64_t zero{ 0 };
+  const auto     multiplySpectrum = [&](const uint64_t & conjugate) {
+    return this->LaunchKernel("VkMultiplySpectrum",
+                              spectrumSamples,
+                              { { &spectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &transferGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &conjugate, sizeof(uint64_t) },
+                                { &spectrumSamples, sizeof(uint64_t) } });
+  };
+
+  // The transfer function is the spectrum of the placed kernel, and the initial estimate is the
+  // padded input
+  resFFT = transform(-1, &workGPUBuffer, &transferGPUBuffer);
+  if (resFFT == VKFFT_SUCCESS && !direct)
+    resFFT = this->CopyDeviceToDevice(estimateGPUBuffer, paddedGPUBuffer, domainBytes);
+  if (resFFT == VKFFT_SUCCESS && landweber)
+    resFFT = transform(-1, &paddedGPUBuffer, &inputSpectrumGPUBuffer);
+  if (resFFT == VKFFT_SUCCESS && landweber)
+    resFFT = this->CopyDeviceToDevice(estimateSpectrumGPUBuffer, inputSpectrumGPUBuffer, spectrumBytes);
+
+  // Bring the estimate of the Landweber iteration back into the spatial domain
+  const auto synthesizeEstimate = [&]() {
+    VkFFTResult result{ this->CopyDeviceToDevice(spectrumGPUBuffer, estimateSpectrumGPUBuffer, spectrumBytes) };
+    if (result == VKFFT_SUCCESS)
+      result = transform(1, &estimateGPUBuffer, &spectrumGPUBuffer);
+    return result;
+  };
 
-  if (m_VkGPU.commandQueue)
+  const float          floatRelaxation{ static_cast<float>(m_VkParameters.relaxation) };
+  const KernelArgument relaxation{ m_VkParameters.P == PrecisionEnum::DOUBLE
+                                     ? KernelArgument{ &m_VkParameters.relaxation, sizeof(double) }
+                                     : KernelArgument{ &floatRelaxation, sizeof(float) } };
+  // The direct estimate is the quotient of the input spectrum by the transfer function, regularized
+  // in half-Hermitian space
+  const float          floatRegularization{ static_cast<float>(m_VkParameters.regularization) };
+  const KernelArgument regularization{ m_VkParameters.P == PrecisionEnum::DOUBLE
+                                         ? KernelArgument{ &m_VkParameters.regularization, sizeof(double) }
+                                         : KernelArgument{ &floatRegularization, sizeof(float) } };
+  const float          floatThreshold{ static_cast<float>(m_VkParameters.zeroMagnitudeThreshold) };
+  const KernelArgument threshold{ m_VkParameters.P == PrecisionEnum::DOUBLE
+                                    ? KernelArgument{ &m_VkParameters.zeroMagnitudeThreshold, sizeof(double) }
+                                    : KernelArgument{ &floatThreshold, sizeof(float) } };
+  const uint64_t       method{ static_cast<uint64_t>(m_VkParameters.deconvolution) };
+  if (resFFT == VKFFT_SUCCESS && direct)
+    resFFT = transform(-1, &paddedGPUBuffer, &spectrumGPUBuffer);
+  if (resFFT == VKFFT_SUCCESS && direct)
+    resFFT = this->LaunchKernel("VkRegularizedDivide",
+                                spectrumSamples,
+                                { { &spectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &transferGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &method, sizeof(uint64_t) },
+                                  regularization,
+                                  threshold,
+                                  { &spectrumSamples, sizeof(uint64_t) } });
+  if (resFFT == VKFFT_SUCCESS && direct)
+    resFFT = transform(1, &estimateGPUBuffer, &spectrumGPUBuffer);
+
+  for (uint64_t iteration{ 0 }; resFFT == VKFFT_SUCCESS && iteration < numberIterations; ++iteration)
   {
-    resCL = clReleaseCommandQueue(m_VkGPU.commandQueue);
-    if (resCL != CL_SUCCESS)
+    // Only the requested estimates cross the bus, and the caller may stop the iterations
+    if (m_VkParameters.estimateCPUBuffer != nullptr && m_VkParameters.estimateInterval > 0 &&
+        iteration % m_VkParameters.estimateInterval == 0)
+    {
+      if (landweber)
+        resFFT = synthesizeEstimate();
+      if (resFFT == VKFFT_SUCCESS)
+        resFFT = this->SynchronizeDevice();
+      if (resFFT == VKFFT_SUCCESS)
+        resFFT = this->CopyDeviceToHost(m_VkParameters.estimateCPUBuffer, estimateGPUBuffer, domainBytes);
+      if (resFFT != VKFFT_SUCCESS)
+        break;
+    }
+    if (m_VkParameters.iterationCallback && m_VkParameters.iterationCallback(iteration))
+    {
+      break;
+    }
+
+    if (landweber)
     {
-      std::cerr << __FILE__ "(" << __LINE__ << "): clReleaseCommandQueue returned " << resCL << std::endl;
-      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_RELEASE_COMMAND_QUEUE };
+      resFFT = this->LaunchKernel("VkLandweberUpdate",
+                                  spectrumSamples,
+                                  { { &estimateSpectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &inputSpectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &transferGPUBuffer, sizeof(DeviceMemoryType) },
+                                    relaxation,
+                                    { &spectrumSamples, sizeof(uint64_t) } });
+      continue;
     }
+
+    // Richardson-Lucy: blur the estimate, divide the input by it, and correct the estimate by the
+    // quotient correlated with the kernel
+    resFFT = transform(-1, &estimateGPUBuffer, &spectrumGPUBuffer);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = multiplySpectrum(zero);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = transform(1, &workGPUBuffer, &spectrumGPUBuffer);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = this->LaunchKernel("VkDivideOrZero",
+                                  domainSamples,
+                                  { { &paddedGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &workGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &domainSamples, sizeof(uint64_t) } });
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = transform(-1, &workGPUBuffer, &spectrumGPUBuffer);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = multiplySpectrum(one);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = transform(1, &workGPUBuffer, &spectrumGPUBuffer);
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = this->LaunchKernel("VkMultiplyImages",
+                                  domainSamples,
+                                  { { &estimateGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &workGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &domainSamples, sizeof(uint64_t) } });
+  }
+
+  // Crop the final estimate into the output
+  if (resFFT == VKFFT_SUCCESS && landweber)
+    resFFT = synthesizeEstimate();
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    const DeviceMemoryType outputGPUBuffer{ outputBuffer->GetMemory() };
+    resFFT = this->LaunchKernel("VkCrop",
+                                cropSamples,
+                                { { &estimateGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &outputGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &one, sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[0], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[1], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[2], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                                  { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropLowerBound[0], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropLowerBound[1], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropLowerBound[2], sizeof(uint64_t) },
+                                  { &one, sizeof(uint64_t) } });
+  }
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->ReturnOutput(outputBuffer);
+
+  deleteVkFFT(&app);
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::PerformGaussianSmoothing()
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // The spectrum of the padded input can be kept for, and reused by, smoothings of the same
+  // identified input into the same domain
+  InputSpectrumKey key;
+  key.dataObject = m_VkParameters.inputGPUBuffer ? nullptr : m_VkParameters.inputDataObject;
+  key.timeStamp = m_VkParameters.inputTimeStamp;
+  key.hostBuffer = m_VkParameters.inputCPUBuffer;
+  key.precision = m_VkParameters.P;
+  key.boundaryCondition = m_VkParameters.boundaryCondition;
+  bool decimate{ false };
+  for (size_t dim{ 0 }; dim < 3; ++dim)
+  {
+    key.size[dim] = m_VkFFTConfiguration.size[dim];
+    key.padInputSize[dim] = m_VkParameters.padInputSize[dim];
+    key.padLowerBound[dim] = m_VkParameters.padLowerBound[dim];
+    decimate = decimate || m_VkParameters.gaussianShrinkFactor[dim] != 1;
+  }
+  const bool keep{ m_VkParameters.keepInputSpectrum != 0 && key.dataObject != nullptr };
+  const bool reuse{ keep && m_InputSpectrum && key == m_InputSpectrumKey };
+  if (!reuse)
+  {
+    m_InputSpectrum.reset();
   }
 
-  if (m_VkGPU.context)
+  // The padded input is transformed through a half spectrum, and the output is cropped out of
+  // the smoothed domain or, with shrink factors, out of the decimated domain
+  const uint64_t      spectrumSamples{ m_VkFFTConfiguration.bufferStride[2] };
+  const uint64_t      spectrumBytes{ 2UL * m_VkParameters.PSize * spectrumSamples };
+  const uint64_t      cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                              m_VkParameters.cropSize[2] };
+  DeviceBufferPointer paddedBuffer;
+  DeviceBufferPointer spectrumBuffer;
+  DeviceBufferPointer inputSpectrumBuffer{ m_InputSpectrum };
+  DeviceBufferPointer outputBuffer;
+  if (!reuse || !decimate)
+    resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * *m_VkFFTConfiguration.inputBufferSize,
+                                        paddedBuffer);
+  if (resFFT == VKFFT_SUCCESS && (!reuse || !decimate))
+    resFFT = this->AllocateDeviceBuffer(spectrumBytes, spectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS && keep && !reuse)
+    resFFT = this->AllocateDeviceBuffer(spectrumBytes, inputSpectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AcquireOutputBuffer(outputBuffer);
+  if (resFFT == VKFFT_SUCCESS && !reuse)
+    resFFT = this->PadOnDevice(paddedBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  // The smoothed domain is only transformed forward, unless the kept spectrum is reused, and back,
+  // unless the output is decimated
+  VkFFTApplication  app{};
+  VkFFTLaunchParams launchParams{};
+  DeviceMemoryType  paddedGPUBuffer{};
+  DeviceMemoryType  spectrumGPUBuffer{};
+  const bool        transform{ !reuse || !decimate };
+  if (transform)
+  {
+    paddedGPUBuffer = paddedBuffer->GetMemory();
+    spectrumGPUBuffer = spectrumBuffer->GetMemory();
+    m_VkFFTConfiguration.inputBuffer = &paddedGPUBuffer;
+    m_VkFFTConfiguration.buffer = &spectrumGPUBuffer;
+    m_VkFFTConfiguration.outputBuffer = &paddedGPUBuffer;
+    resFFT = initializeVkFFT(&app, m_VkFFTConfiguration);
+    if (resFFT != VKFFT_SUCCESS)
+      return resFFT;
+
+    launchParams.inputBuffer = &paddedGPUBuffer;
+    launchParams.buffer = &spectrumGPUBuffer;
+    launchParams.outputBuffer = &paddedGPUBuffer;
+#if (VKFFT_BACKEND == CUDA)
+    // pass
+#elif (VKFFT_BACKEND == OPENCL)
+    launchParams.commandQueue = &m_VkGPU.commandQueue;
+#endif
+  }
+
+  // Transform the padded input, or start from its kept spectrum
+  if (!reuse)
   {
-    resCL = clReleaseContext(m_VkGPU.context);
-    if (resCL != CL_SUCCESS)
+    resFFT = VkFFTAppend(&app, -1, &launchParams);
+    if (resFFT == VKFFT_SUCCESS && keep)
+      resFFT = this->CopyDeviceToDevice(inputSpectrumBuffer->GetMemory(), spectrumGPUBuffer, spectrumBytes);
+  }
+  else if (!decimate)
+  {
+    resFFT = this->CopyDeviceToDevice(spectrumGPUBuffer, inputSpectrumBuffer->GetMemory(), spectrumBytes);
+  }
+
+  float                       floatVariance[3];
+  std::vector<KernelArgument> variances;
+  for (size_t dim{ 0 }; dim < 3; ++dim)
+  {
+    floatVariance[dim] = static_cast<float>(m_VkParameters.gaussianVariance[dim]);
+    variances.push_back(m_VkParameters.P == PrecisionEnum::DOUBLE
+                          ? KernelArgument{ &m_VkParameters.gaussianVariance[dim], sizeof(double) }
+                          : KernelArgument{ &floatVariance[dim], sizeof(float) });
+  }
+  const uint64_t one{ 1 };
+  if (decimate)
+  {
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = this->PerformGaussianDecimation(reuse ? inputSpectrumBuffer->GetMemory() : spectrumGPUBuffer,
+                                               variances,
+                                               outputBuffer);
+  }
+  else
+  {
+    // Multiply the spectrum by the transfer function of the Gaussian and transform it back
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = this->LaunchKernel("VkGaussianTransfer",
+                                  spectrumSamples,
+                                  { { &spectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                    { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                                    { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                                    variances[0],
+                                    variances[1],
+                                    variances[2],
+                                    { &spectrumSamples, sizeof(uint64_t) } });
+    if (resFFT == VKFFT_SUCCESS)
+      resFFT = VkFFTAppend(&app, 1, &launchParams);
+    if (resFFT == VKFFT_SUCCESS)
     {
-      std::cerr << __FILE__ "(" << __LINE__ << "): clReleaseContext returned " << resCL << std::endl;
-      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_RELEASE_COMMAND_QUEUE };
+      const DeviceMemoryType outputGPUBuffer{ outputBuffer->GetMemory() };
+      resFFT = this->LaunchKernel("VkCrop",
+                                  cropSamples,
+                                  { { &paddedGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &outputGPUBuffer, sizeof(DeviceMemoryType) },
+                                    { &one, sizeof(uint64_t) },
+                                    { &m_VkParameters.cropSize[0], sizeof(uint64_t) },
+                                    { &m_VkParameters.cropSize[1], sizeof(uint64_t) },
+                                    { &m_VkParameters.cropSize[2], sizeof(uint64_t) },
+                                    { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                    { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                                    { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                                    { &m_VkParameters.cropLowerBound[0], sizeof(uint64_t) },
+                                    { &m_VkParameters.cropLowerBound[1], sizeof(uint64_t) },
+                                    { &m_VkParameters.cropLowerBound[2], sizeof(uint64_t) },
+                                    { &one, sizeof(uint64_t) } });
     }
   }
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->ReturnOutput(outputBuffer);
+  if (resFFT == VKFFT_SUCCESS && keep && !reuse)
+  {
+    m_InputSpectrum = inputSpectrumBuffer;
+    m_InputSpectrumKey = key;
+  }
+
+  if (transform)
+    deleteVkFFT(&app);
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::PerformGaussianDecimation(DeviceMemoryType                    spectrumGPUBuffer,
+                                    const std::vector<KernelArgument> & variances,
+                                    const DeviceBufferPointer &         outputBuffer)
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  // Lay out the decimated domain and its half spectrum like the smoothed domain, and plan it
+  VkFFTConfiguration decimatedConfiguration{ m_VkFFTConfiguration };
+  for (size_t dim{ 0 }; dim < 3; ++dim)
+  {
+    decimatedConfiguration.size[dim] = m_VkFFTConfiguration.size[dim] / m_VkParameters.gaussianShrinkFactor[dim];
+  }
+  decimatedConfiguration.bufferStride[0] = decimatedConfiguration.size[0] / 2 + 1;
+  decimatedConfiguration.bufferStride[1] = decimatedConfiguration.bufferStride[0] * decimatedConfiguration.size[1];
+  decimatedConfiguration.bufferStride[2] = decimatedConfiguration.bufferStride[1] * decimatedConfiguration.size[2];
+  decimatedConfiguration.inputBufferStride[0] = decimatedConfiguration.size[0];
+  decimatedConfiguration.inputBufferStride[1] = decimatedConfiguration.size[0] * decimatedConfiguration.size[1];
+  decimatedConfiguration.inputBufferStride[2] = decimatedConfiguration.inputBufferStride[1] *
+                                                decimatedConfiguration.size[2];
+  for (size_t dim{ 0 }; dim < 3; ++dim)
+  {
+    decimatedConfiguration.outputBufferStride[dim] = decimatedConfiguration.inputBufferStride[dim];
+  }
+  uint64_t decimatedSpectrumSize{ decimatedConfiguration.bufferStride[2] };
+  uint64_t decimatedDomainSize{ decimatedConfiguration.inputBufferStride[2] };
+  decimatedConfiguration.bufferSize = &decimatedSpectrumSize;
+  decimatedConfiguration.inputBufferSize = &decimatedDomainSize;
+  decimatedConfiguration.outputBufferSize = &decimatedDomainSize;
+
+  DeviceBufferPointer decimatedSpectrumBuffer;
+  DeviceBufferPointer decimatedBuffer;
+  resFFT = this->AllocateDeviceBuffer(2UL * m_VkParameters.PSize * decimatedSpectrumSize, decimatedSpectrumBuffer);
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->AllocateDeviceBuffer(1UL * m_VkParameters.PSize * decimatedDomainSize, decimatedBuffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  DeviceMemoryType decimatedSpectrumGPUBuffer{ decimatedSpectrumBuffer->GetMemory() };
+  DeviceMemoryType decimatedGPUBuffer{ decimatedBuffer->GetMemory() };
+  decimatedConfiguration.makeInversePlanOnly = 1;
+  decimatedConfiguration.inputBuffer = &decimatedGPUBuffer;
+  decimatedConfiguration.buffer = &decimatedSpectrumGPUBuffer;
+  decimatedConfiguration.outputBuffer = &decimatedGPUBuffer;
+
+  VkFFTApplication app{};
+  resFFT = initializeVkFFT(&app, decimatedConfiguration);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+
+  VkFFTLaunchParams launchParams{};
+  launchParams.inputBuffer = &decimatedGPUBuffer;
+  launchParams.buffer = &decimatedSpectrumGPUBuffer;
+  launchParams.outputBuffer = &decimatedGPUBuffer;
+#if (VKFFT_BACKEND == CUDA)
+  // pass
+#elif (VKFFT_BACKEND == OPENCL)
+  launchParams.commandQueue = &m_VkGPU.commandQueue;
 #endif
 
-  // Invalidate cache description!!!
+  // Sum the shifted aliases of the smoothed spectrum into the decimated spectrum, transform it
+  // back, and crop the output from the first samples of the decimated domain
+  const uint64_t zero{ 0 };
+  const uint64_t one{ 1 };
+  const uint64_t cropSamples{ m_VkParameters.cropSize[0] * m_VkParameters.cropSize[1] *
+                              m_VkParameters.cropSize[2] };
+  resFFT = this->LaunchKernel("VkGaussianDecimate",
+                              decimatedSpectrumSize,
+                              { { &spectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &decimatedSpectrumGPUBuffer, sizeof(DeviceMemoryType) },
+                                { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                                { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                                { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                                { &decimatedConfiguration.size[0], sizeof(uint64_t) },
+                                { &decimatedConfiguration.size[1], sizeof(uint64_t) },
+                                { &decimatedConfiguration.size[2], sizeof(uint64_t) },
+                                variances[0],
+                                variances[1],
+                                variances[2],
+                                { &m_VkParameters.cropLowerBound[0], sizeof(uint64_t) },
+                                { &m_VkParameters.cropLowerBound[1], sizeof(uint64_t) },
+                                { &m_VkParameters.cropLowerBound[2], sizeof(uint64_t) },
+                                { &decimatedSpectrumSize, sizeof(uint64_t) } });
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = VkFFTAppend(&app, 1, &launchParams);
+  if (resFFT == VKFFT_SUCCESS)
+  {
+    const DeviceMemoryType outputGPUBuffer{ outputBuffer->GetMemory() };
+    resFFT = this->LaunchKernel("VkCrop",
+                                cropSamples,
+                                { { &decimatedGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &outputGPUBuffer, sizeof(DeviceMemoryType) },
+                                  { &one, sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[0], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[1], sizeof(uint64_t) },
+                                  { &m_VkParameters.cropSize[2], sizeof(uint64_t) },
+                                  { &decimatedConfiguration.size[0], sizeof(uint64_t) },
+                                  { &decimatedConfiguration.size[1], sizeof(uint64_t) },
+                                  { &decimatedConfiguration.size[2], sizeof(uint64_t) },
+                                  { &zero, sizeof(uint64_t) },
+                                  { &zero, sizeof(uint64_t) },
+                                  { &zero, sizeof(uint64_t) },
+                                  { &one, sizeof(uint64_t) } });
+  }
+  if (resFFT == VKFFT_SUCCESS)
+    resFFT = this->SynchronizeDevice();
+
+  deleteVkFFT(&app);
 
   return resFFT;
 }
 
+VkFFTResult
+VkCommon::CompleteHermitianOnDevice(DeviceMemoryType buffer)
+{
+  const uint64_t redundantSamples{ m_VkFFTConfiguration.size[0] - (m_VkFFTConfiguration.size[0] / 2 + 1) };
+  const uint64_t transformY{ m_VkFFTConfiguration.omitDimension[1] ? 0UL : 1UL };
+  const uint64_t transformZ{ m_VkFFTConfiguration.omitDimension[2] ? 0UL : 1UL };
+  return this->LaunchKernel("VkCompleteHermitian",
+                            redundantSamples * m_VkFFTConfiguration.size[1] * m_VkFFTConfiguration.size[2],
+                            { { &buffer, sizeof(DeviceMemoryType) },
+                              { &m_VkFFTConfiguration.size[0], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[1], sizeof(uint64_t) },
+                              { &m_VkFFTConfiguration.size[2], sizeof(uint64_t) },
+                              { &transformY, sizeof(uint64_t) },
+                              { &transformZ, sizeof(uint64_t) } });
+}
+
+VkFFTResult
+VkCommon::AllocateDeviceBuffer(uint64_t bytes, DeviceBufferPointer & buffer)
+{
+  return m_DeviceContext->Allocate(bytes, buffer);
+}
+
+VkFFTResult
+VkCommon::CopyHostToDevice(DeviceMemoryType buffer, const void * hostBuffer, uint64_t bytes)
+{
+  return m_DeviceContext->CopyHostToDevice(buffer, hostBuffer, bytes);
+}
+
+VkFFTResult
+VkCommon::CopyDeviceToHost(void * hostBuffer, DeviceMemoryType buffer, uint64_t bytes)
+{
+  return m_DeviceContext->CopyDeviceToHost(hostBuffer, buffer, bytes);
+}
+
+VkFFTResult
+VkCommon::CopyDeviceToDevice(DeviceMemoryType destination, DeviceMemoryType source, uint64_t bytes)
+{
+  return m_DeviceContext->CopyDeviceToDevice(destination, source, bytes);
+}
+
+VkFFTResult
+VkCommon::SynchronizeDevice()
+{
+  return m_DeviceContext->Synchronize();
+}
+
+uint64_t
+VkCommon::GetInputPixelBytes() const
+{
+  switch (m_VkParameters.inputPixelType)
+  {
+    case InputPixelEnum::UINT8:
+      return sizeof(uint8_t);
+    case InputPixelEnum::INT16:
+      return sizeof(int16_t);
+    case InputPixelEnum::UINT16:
+      return sizeof(uint16_t);
+    default:
+      return m_VkParameters.PSize;
+  }
+}
+
+VkFFTResult
+VkCommon::LaunchKernel(const char * kernelName, uint64_t globalSize, const std::vector<KernelArgument> & arguments)
+{
+  return m_DeviceContext->LaunchKernel(m_VkParameters.P, kernelName, globalSize, arguments);
+}
+
+VkFFTResult
+VkCommon::AcquireInputBuffer(DeviceBufferPointer & buffer)
+{
+  VkFFTResult resFFT{ VKFFT_SUCCESS };
+
+  if (m_VkParameters.inputGPUBuffer)
+  {
+    itkAssertOrThrowMacro(m_VkParameters.inputGPUBuffer->GetBytes() == m_VkParameters.inputBufferBytes,
+                          "Input device buffer is of a different size.");
+    buffer = m_VkParameters.inputGPUBuffer;
+    return resFFT;
+  }
+
+  const VkDeviceContext::ResidencyKey key{ m_VkParameters.inputDataObject,
+                                           m_VkParameters.inputTimeStamp,
+                                           m_VkParameters.inputCPUBuffer,
+                                           m_VkParameters.inputBufferBytes };
+  const uint64_t                      budget{ VkGlobalConfiguration::GetDeviceResidencyBudget() };
+  const bool                          residency{ key.dataObject != nullptr && budget > 0 };
+  if (residency)
+  {
+    buffer = m_DeviceContext->FindResident(key);
+    if (buffer)
+    {
+      return resFFT;
+    }
+  }
+
+  resFFT = this->AllocateDeviceBuffer(m_VkParameters.inputBufferBytes, buffer);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  resFFT = this->CopyHostToDevice(buffer->GetMemory(), m_VkParameters.inputCPUBuffer, m_VkParameters.inputBufferBytes);
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  if (residency)
+  {
+    m_DeviceContext->MakeResident(key, buffer, budget);
+  }
+
+  return resFFT;
+}
+
+VkFFTResult
+VkCommon::AcquireMovingBuffer(DeviceBufferPointer & buffer)
+{
+  if (m_VkParameters.movingGPUBuffer)
+  {
+    itkAssertOrThrowMacro(m_VkParameters.movingGPUBuffer->GetBytes() == m_VkParameters.movingBufferBytes,
+                          "Moving image device buffer is of a different size.");
+    buffer = m_VkParameters.movingGPUBuffer;
+    return VkFFTResult{ VKFFT_SUCCESS };
+  }
+
+  const VkFFTResult resFFT{ this->AllocateDeviceBuffer(m_VkParameters.movingBufferBytes, buffer) };
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  return this->CopyHostToDevice(buffer->GetMemory(), m_VkParameters.movingCPUBuffer, m_VkParameters.movingBufferBytes);
+}
+
+VkFFTResult
+VkCommon::UploadInput(const DeviceBufferPointer & buffer)
+{
+  if (!m_VkParameters.inputGPUBuffer &&
+      (m_VkParameters.inputDataObject == nullptr || VkGlobalConfiguration::GetDeviceResidencyBudget() == 0))
+  {
+    return this->CopyHostToDevice(buffer->GetMemory(), m_VkParameters.inputCPUBuffer, m_VkParameters.inputBufferBytes);
+  }
+
+  // The transform overwrites its input, so it works on a device-side copy of an input that is
+  // already on the device
+  DeviceBufferPointer inputBuffer;
+  const VkFFTResult   resFFT{ this->AcquireInputBuffer(inputBuffer) };
+  if (resFFT != VKFFT_SUCCESS)
+    return resFFT;
+  return this->CopyDeviceToDevice(buffer->GetMemory(), inputBuffer->GetMemory(), m_VkParameters.inputBufferBytes);
+}
+
+VkFFTResult
+VkCommon::AcquireOutputBuffer(DeviceBufferPointer & buffer)
+{
+  if (m_VkParameters.outputGPUBuffer && *m_VkParameters.outputGPUBuffer)
+  {
+    itkAssertOrThrowMacro((*m_VkParameters.outputGPUBuffer)->GetBytes() == m_VkParameters.outputBufferBytes,
+                          "Output device buffer is of a different size.");
+    buffer = *m_VkParameters.outputGPUBuffer;
+    return VkFFTResult{ VKFFT_SUCCESS };
+  }
+  return this->AllocateDeviceBuffer(m_VkParameters.outputBufferBytes, buffer);
+}
+
+VkFFTResult
+VkCommon::ReturnOutput(const DeviceBufferPointer & buffer)
+{
+  if (m_VkParameters.outputGPUBuffer)
+  {
+    DeviceBufferPointer & outputBuffer{ *m_VkParameters.outputGPUBuffer };
+    if (!outputBuffer)
+    {
+      outputBuffer = buffer;
+      return VkFFTResult{ VKFFT_SUCCESS };
+    }
+    if (outputBuffer == buffer)
+    {
+      return VkFFTResult{ VKFFT_SUCCESS };
+    }
+
+    // The result was computed in place, in a buffer other than the requested one
+    const VkFFTResult resFFT{ this->CopyDeviceToDevice(
+      outputBuffer->GetMemory(), buffer->GetMemory(), m_VkParameters.outputBufferBytes) };
+    if (resFFT != VKFFT_SUCCESS)
+      return resFFT;
+    return this->SynchronizeDevice();
+  }
+  return this->CopyDeviceToHost(m_VkParameters.outputCPUBuffer, buffer->GetMemory(), m_VkParameters.outputBufferBytes);
+}
+
+VkFFTResult
+VkCommon::ReleaseBackend()
+{
+  // The device context is shared with other filters and outlives this one, together with
+  // its kernels and resident buffers.
+  m_InputSpectrum.reset();
+  m_DeviceContext.reset();
+  m_VkGPU = VkGPU{};
+  m_VkParameters = VkParameters{};
+  m_MustConfigure = true;
+
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
 } // end namespace itk
@@ -0,0 +1,1536 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkVkDeviceContext.h"
+#include "itkMacro.h"
+#ifdef VKFFT_USE_ITK_GPU
+#  include "itkGPUContextManager.h"
+#endif
+
+#include <algorithm>
+#include <iostream>
+
+namespace itk
+{
+namespace
+{
+// Evict the least recently used entries of a device buffer cache until `bytes` more fit into
+// `budget`, and return the number of evicted entries
+template <typename TEntry>
+uint64_t
+EvictLeastRecentlyUsed(std::vector<TEntry> & entries, uint64_t bytes, uint64_t budget)
+{
+  uint64_t cachedBytes{ 0 };
+  for (const auto & entry : entries)
+  {
+    cachedBytes += entry.buffer->GetBytes();
+  }
+  std::sort(entries.begin(), entries.end(), [](const TEntry & a, const TEntry & b) { return a.lastUse > b.lastUse; });
+  uint64_t evicted{ 0 };
+  while (!entries.empty() && cachedBytes + bytes > budget)
+  {
+    cachedBytes -= entries.back().buffer->GetBytes();
+    entries.pop_back();
+    ++evicted;
+  }
+  return evicted;
+}
+
+// Backend-neutral preamble of the kernel library. OpenCL C and CUDA (through NVRTC) both
+// compile the library; complex samples are stored as interleaved pairs of VkReal.
+constexpr const char * VkKernelPreamble = R"(
+#if defined(__OPENCL_VERSION__)
+#  define VK_KERNEL __kernel
+#  define VK_DEVICE
+#  define VK_GLOBAL __global
+#  define VK_GLOBAL_ID ((VkIndex)get_global_id(0))
+typedef ulong VkIndex;
+typedef long  VkOffset;
+typedef uchar  VkUInt8;
+typedef short  VkInt16;
+typedef ushort VkUInt16;
+#  if defined(VK_DOUBLE_PRECISION)
+#    pragma OPENCL EXTENSION cl_khr_fp64 : enable
+#  endif
+#else
+#  define VK_KERNEL extern "C" __global__
+#  define VK_DEVICE __device__
+#  define VK_GLOBAL
+#  define VK_GLOBAL_ID ((VkIndex)blockIdx.x * blockDim.x + threadIdx.x)
+typedef unsigned long long VkIndex;
+typedef long long          VkOffset;
+typedef unsigned char      VkUInt8;
+typedef short              VkInt16;
+typedef unsigned short     VkUInt16;
+#endif
+#if defined(VK_DOUBLE_PRECISION)
+typedef double VkReal;
+#else
+typedef float VkReal;
+#endif
+)";
+
+constexpr const char * VkKernelLibrary = R"(
+// Map an index of the padded domain onto the unpadded input of extent n,
+// or return -1 where the boundary condition yields zero.
+VK_DEVICE VkOffset
+VkBoundaryIndex(VkOffset s, VkOffset n, VkIndex condition)
+{
+  if (s >= 0 && s < n)
+  {
+    return s;
+  }
+  switch (condition)
+  {
+    case 2: // PERIODIC
+      s %= n;
+      return s < 0 ? s + n : s;
+    case 3: // ZERO_FLUX_NEUMANN
+      return s < 0 ? 0 : n - 1;
+    case 4: // MIRROR
+    {
+      const VkOffset period = 2 * n;
+      s %= period;
+      if (s < 0)
+      {
+        s += period;
+      }
+      return s < n ? s : period - 1 - s;
+    }
+    default: // ZERO
+      return -1;
+  }
+}
+
+// Pad an input of size (nx, ny, nz) into the domain (px, py, pz), where the input
+// starts at (lx, ly, lz). Samples have `components` reals: 1 for real, 2 for complex.
+VK_KERNEL void
+VkPad(VK_GLOBAL const VkReal * input,
+      VK_GLOBAL VkReal *       output,
+      VkIndex                  components,
+      VkIndex                  nx,
+      VkIndex                  ny,
+      VkIndex                  nz,
+      VkIndex                  px,
+      VkIndex                  py,
+      VkIndex                  pz,
+      VkIndex                  lx,
+      VkIndex                  ly,
+      VkIndex                  lz,
+      VkIndex                  condition)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= px * py * pz)
+  {
+    return;
+  }
+  const VkOffset x = VkBoundaryIndex((VkOffset)(i % px) - (VkOffset)lx, (VkOffset)nx, condition);
+  const VkOffset y = VkBoundaryIndex((VkOffset)((i / px) % py) - (VkOffset)ly, (VkOffset)ny, condition);
+  const VkOffset z = VkBoundaryIndex((VkOffset)(i / (px * py)) - (VkOffset)lz, (VkOffset)nz, condition);
+  const VkIndex  j = (x < 0 || y < 0 || z < 0) ? 0 : (((VkIndex)z * ny + (VkIndex)y) * nx + (VkIndex)x);
+  for (VkIndex c = 0; c < components; ++c)
+  {
+    output[i * components + c] = (x < 0 || y < 0 || z < 0) ? (VkReal)0 : input[j * components + c];
+  }
+}
+
+// Convert `count` input pixels of the type `pixelType` of VkCommon::InputPixelEnum to reals.
+VK_KERNEL void
+VkConvertInput(VK_GLOBAL const VkUInt8 * input, VK_GLOBAL VkReal * output, VkIndex pixelType, VkIndex count)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= count)
+  {
+    return;
+  }
+  switch (pixelType)
+  {
+    case 2: // INT16
+      output[i] = (VkReal)((VK_GLOBAL const VkInt16 *)input)[i];
+      break;
+    case 3: // UINT16
+      output[i] = (VkReal)((VK_GLOBAL const VkUInt16 *)input)[i];
+      break;
+    default: // UINT8
+      output[i] = (VkReal)input[i];
+  }
+}
+
+// Move `count` kernels of size (kx, ky, kz), one after another, into as many zero-padded
+// domains (px, py, pz), scaled, so that their samples (cx, cy, cz) lie at the origin and the
+// samples below wrap around. With `mirror`, the kernels are mirrored about that sample, so that
+// a convolution with them is a correlation with the original kernels.
+VK_KERNEL void
+VkPlaceKernel(VK_GLOBAL const VkReal * kernel,
+              VK_GLOBAL VkReal *       output,
+              VkReal                   scale,
+              VkIndex                  kx,
+              VkIndex                  ky,
+              VkIndex                  kz,
+              VkIndex                  px,
+              VkIndex                  py,
+              VkIndex                  pz,
+              VkIndex                  cx,
+              VkIndex                  cy,
+              VkIndex                  cz,
+              VkIndex                  mirror,
+              VkIndex                  count)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  const VkIndex n = px * py * pz;
+  if (i >= count * n)
+  {
+    return;
+  }
+  const VkIndex d = i % n;
+  const VkIndex x = mirror ? (cx + px - d % px) % px : (d % px + cx) % px;
+  const VkIndex y = mirror ? (cy + py - (d / px) % py) % py : ((d / px) % py + cy) % py;
+  const VkIndex z = mirror ? (cz + pz - d / (px * py)) % pz : (d / (px * py) + cz) % pz;
+  output[i] = (x < kx && y < ky && z < kz) ? scale * kernel[((i / n * kz + z) * ky + y) * kx + x] : (VkReal)0;
+}
+
+// Crop the region of size (nx, ny, nz) that starts at (lx, ly, lz) out of each of `count`
+// domains (px, py, pz) that follow one another. Samples have `components` reals: 1 for real,
+// 2 for complex.
+VK_KERNEL void
+VkCrop(VK_GLOBAL const VkReal * input,
+       VK_GLOBAL VkReal *       output,
+       VkIndex                  components,
+       VkIndex                  nx,
+       VkIndex                  ny,
+       VkIndex                  nz,
+       VkIndex                  px,
+       VkIndex                  py,
+       VkIndex                  pz,
+       VkIndex                  lx,
+       VkIndex                  ly,
+       VkIndex                  lz,
+       VkIndex                  count)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  const VkIndex n = nx * ny * nz;
+  if (i >= count * n)
+  {
+    return;
+  }
+  const VkIndex c = i % n;
+  const VkIndex x = c % nx + lx;
+  const VkIndex y = (c / nx) % ny + ly;
+  const VkIndex z = c / (nx * ny) + lz;
+  const VkIndex j = ((i / n * pz + z) * py + y) * px + x;
+  for (VkIndex k = 0; k < components; ++k)
+  {
+    output[i * components + k] = input[j * components + k];
+  }
+}
+
+// Find the largest sample of each chunk [j * length, (j + 1) * length) of `count` outputs of
+// n samples that follow one another, for the `chunks` chunks j of an output. The index of the
+// sample is relative to its output; ties go to the lowest index.
+VK_KERNEL void
+VkPeakSearch(VK_GLOBAL const VkReal * input,
+             VK_GLOBAL VkReal *       values,
+             VK_GLOBAL VkIndex *      indices,
+             VkIndex                  n,
+             VkIndex                  length,
+             VkIndex                  chunks,
+             VkIndex                  count)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= count * chunks)
+  {
+    return;
+  }
+  VK_GLOBAL const VkReal * samples = input + (i / chunks) * n;
+  const VkIndex            begin = (i % chunks) * length;
+  const VkIndex            end = begin + length < n ? begin + length : n;
+  VkIndex                  peak = begin;
+  for (VkIndex j = begin + 1; j < end; ++j)
+  {
+    if (samples[j] > samples[peak])
+    {
+      peak = j;
+    }
+  }
+  values[i] = samples[peak];
+  indices[i] = peak;
+}
+
+// Sum the `length` samples that lie `stride` apart from each sample onward, within the extent of
+// the domains (px, py, pz) of n samples along that dimension, into the output. With `square`, the
+// input is a single domain of n / 2 samples, whose samples are summed into the first half of the
+// output and their squares into the second.
+VK_KERNEL void
+VkWindowSums(VK_GLOBAL const VkReal * input,
+             VK_GLOBAL VkReal *       output,
+             VkIndex                  square,
+             VkIndex                  length,
+             VkIndex                  stride,
+             VkIndex                  extent,
+             VkIndex                  n)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= n)
+  {
+    return;
+  }
+  const VkIndex s = square ? i % (n / 2) : i;
+  const int     squared = square && i >= n / 2;
+  const VkIndex c = (s / stride) % extent;
+  const VkIndex end = c + length < extent ? length : extent - c;
+  VkReal        sum = 0;
+  for (VkIndex j = 0; j < end; ++j)
+  {
+    const VkReal v = input[s + j * stride];
+    sum += squared ? v * v : v;
+  }
+  output[i] = sum;
+}
+
+// Divide each sample of `count` correlation maps of size (nx, ny, nz), with kernels of zero mean
+// and unit norm, by the norm of the zero-mean input under the kernel window of `window` samples,
+// from the sums of the input and of its squares over the window, two domains (px, py, pz) of n
+// samples that follow one another, at the sample of the map. The result is clamped to [-1, 1],
+// or zero where the variance of the window is below `epsilon` times its sum of squares.
+VK_KERNEL void
+VkNormalizeMatches(VK_GLOBAL VkReal *       maps,
+                   VK_GLOBAL const VkReal * sums,
+                   VkIndex                  n,
+                   VkReal                   window,
+                   VkReal                   epsilon,
+                   VkIndex                  nx,
+                   VkIndex                  ny,
+                   VkIndex                  nz,
+                   VkIndex                  px,
+                   VkIndex                  py,
+                   VkIndex                  count)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  const VkIndex m = nx * ny * nz;
+  if (i >= count * m)
+  {
+    return;
+  }
+  const VkIndex c = i % m;
+  const VkIndex j = ((c / (nx * ny)) * py + (c / nx) % ny) * px + c % nx;
+  const VkReal  sum = sums[j];
+  const VkReal  sumOfSquares = sums[n + j];
+  const VkReal  variance = sumOfSquares - sum * sum / window;
+  VkReal        correlation = 0;
+  if (variance > (VkReal)0 && variance > epsilon * sumOfSquares)
+  {
+    correlation = maps[i] / sqrt(variance);
+    correlation = correlation > (VkReal)1 ? (VkReal)1 : (correlation < (VkReal)-1 ? (VkReal)-1 : correlation);
+  }
+  maps[i] = correlation;
+}
+
+// Zero-pad an image of size (nx, ny, nz) into the domain (px, py, pz), rotated by 180 degrees
+// about the origin with `rotate`, and write its samples within the mask, their squares and the
+// mask itself, with ones for nonzero mask samples, into three domains that follow one another
+// from output + offset. Without `hasMask`, the mask is all ones.
+VK_KERNEL void
+VkPlaceMaskedImage(VK_GLOBAL const VkReal * image,
+                   VK_GLOBAL const VkReal * mask,
+                   VK_GLOBAL VkReal *       output,
+                   VkIndex                  offset,
+                   VkIndex                  hasMask,
+                   VkIndex                  rotate,
+                   VkIndex                  nx,
+                   VkIndex                  ny,
+                   VkIndex                  nz,
+                   VkIndex                  px,
+                   VkIndex                  py,
+                   VkIndex                  pz)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  const VkIndex n = px * py * pz;
+  if (i >= n)
+  {
+    return;
+  }
+  const VkIndex x = rotate ? (nx - 1 + px - i % px) % px : i % px;
+  const VkIndex y = rotate ? (ny - 1 + py - (i / px) % py) % py : (i / px) % py;
+  const VkIndex z = rotate ? (nz - 1 + pz - i / (px * py)) % pz : i / (px * py);
+  VkReal        value = 0;
+  VkReal        inside = 0;
+  if (x < nx && y < ny && z < nz)
+  {
+    const VkIndex j = (z * ny + y) * nx + x;
+    if (!hasMask || mask[j] != (VkReal)0)
+    {
+      value = image[j];
+      inside = 1;
+    }
+  }
+  output[offset + i] = value;
+  output[offset + n + i] = value * value;
+  output[offset + 2 * n + i] = inside;
+}
+
+// Multiply the half spectra of h samples of the fixed image F, its square F2 and its mask Mf and
+// of the rotated moving image M, its square M2 and its mask Mm, which follow one another in this
+// order, in place into the spectra of the correlation terms Mf Mm, F Mm, Mf M, F M, F2 Mm, Mf M2.
+VK_KERNEL void
+VkCorrelationProducts(VK_GLOBAL VkReal * spectra, VkIndex h)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= h)
+  {
+    return;
+  }
+  VkReal re[6];
+  VkReal im[6];
+  for (VkIndex t = 0; t < 6; ++t)
+  {
+    re[t] = spectra[2 * (t * h + i)];
+    im[t] = spectra[2 * (t * h + i) + 1];
+  }
+  const int a[6] = { 2, 0, 2, 0, 1, 2 };
+  const int b[6] = { 5, 5, 3, 3, 5, 4 };
+  for (VkIndex t = 0; t < 6; ++t)
+  {
+    spectra[2 * (t * h + i)] = re[a[t]] * re[b[t]] - im[a[t]] * im[b[t]];
+    spectra[2 * (t * h + i) + 1] = re[a[t]] * im[b[t]] + im[a[t]] * re[b[t]];
+  }
+}
+
+// Combine the six correlation terms, domains (px, py, pz) of n samples that follow one another,
+// over the output region of size (nx, ny, nz) at the origin into the denominator, the number of
+// overlapping pixels and the numerator of the normalized correlation, which follow one another.
+VK_KERNEL void
+VkCorrelationTerms(VK_GLOBAL const VkReal * terms,
+                   VK_GLOBAL VkReal *       output,
+                   VkIndex                  n,
+                   VkIndex                  nx,
+                   VkIndex                  ny,
+                   VkIndex                  nz,
+                   VkIndex                  px,
+                   VkIndex                  py)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  const VkIndex m = nx * ny * nz;
+  if (i >= m)
+  {
+    return;
+  }
+  const VkIndex j = ((i / (nx * ny)) * py + (i / nx) % ny) * px + i % nx;
+  VkReal        overlap = floor(terms[j] + (VkReal)0.5);
+  VkReal        numerator = 0;
+  VkReal        denominator = 0;
+  if (overlap >= (VkReal)1)
+  {
+    const VkReal fixedSum = terms[n + j];
+    const VkReal movingSum = terms[2 * n + j];
+    numerator = terms[3 * n + j] - fixedSum * movingSum / overlap;
+    const VkReal fixedDenominator = terms[4 * n + j] - fixedSum * fixedSum / overlap;
+    const VkReal movingDenominator = terms[5 * n + j] - movingSum * movingSum / overlap;
+    denominator = (fixedDenominator > (VkReal)0 && movingDenominator > (VkReal)0)
+                    ? sqrt(fixedDenominator * movingDenominator)
+                    : (VkReal)0;
+  }
+  else
+  {
+    overlap = 0;
+  }
+  output[i] = denominator;
+  output[m + i] = overlap;
+  output[2 * m + i] = numerator;
+}
+
+// Divide the numerator by the denominator of the normalized correlation, both of n samples,
+// clamped to [-1, 1], or zero where the denominator is below `tolerance` or fewer than
+// `requiredOverlap` pixels overlap.
+VK_KERNEL void
+VkNormalizedCorrelation(VK_GLOBAL const VkReal * terms,
+                        VK_GLOBAL VkReal *       output,
+                        VkIndex                  n,
+                        VkReal                   tolerance,
+                        VkReal                   requiredOverlap)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= n)
+  {
+    return;
+  }
+  const VkReal denominator = terms[i];
+  const VkReal overlap = terms[n + i];
+  VkReal       correlation = 0;
+  if (denominator > (VkReal)0 && denominator >= tolerance && overlap >= requiredOverlap)
+  {
+    correlation = terms[2 * n + i] / denominator;
+    correlation = correlation > (VkReal)1 ? (VkReal)1 : (correlation < (VkReal)-1 ? (VkReal)-1 : correlation);
+  }
+  output[i] = correlation;
+}
+
+// Replace the half spectrum F of h samples of the fixed image by the normalized cross-power
+// spectrum M conj(F) / |M conj(F)| with the half spectrum M of the moving image, or by zero
+// where it vanishes.
+VK_KERNEL void
+VkCrossPowerSpectrum(VK_GLOBAL VkReal * fixed, VK_GLOBAL const VkReal * moving, VkIndex h)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= h)
+  {
+    return;
+  }
+  const VkReal fr = fixed[2 * i];
+  const VkReal fi = fixed[2 * i + 1];
+  const VkReal mr = moving[2 * i];
+  const VkReal mi = moving[2 * i + 1];
+  const VkReal re = mr * fr + mi * fi;
+  const VkReal im = mi * fr - mr * fi;
+  const VkReal magnitude = sqrt(re * re + im * im);
+  fixed[2 * i] = magnitude > (VkReal)0 ? re / magnitude : (VkReal)0;
+  fixed[2 * i + 1] = magnitude > (VkReal)0 ? im / magnitude : (VkReal)0;
+}
+
+// Refine the position of the peak at sample `peak` of the real domain (px, py, pz) along each
+// dimension by the vertex of the parabola through the peak and its neighbors, which wrap around
+// the domain, and write it as a shift wrapped into [-p / 2, p / 2) into shift[0], [1] and [2].
+VK_KERNEL void
+VkRefinePeak(VK_GLOBAL const VkReal * surface,
+             VK_GLOBAL VkReal *       shift,
+             VkIndex                  peak,
+             VkIndex                  px,
+             VkIndex                  py,
+             VkIndex                  pz)
+{
+  const VkIndex d = VK_GLOBAL_ID;
+  if (d >= 3)
+  {
+    return;
+  }
+  const VkIndex p = d == 0 ? px : (d == 1 ? py : pz);
+  const VkIndex stride = d == 0 ? 1 : (d == 1 ? px : px * py);
+  const VkIndex c = (peak / stride) % p;
+  VkReal        offset = 0;
+  if (p > 2)
+  {
+    const VkIndex base = peak - c * stride;
+    const VkReal  lower = surface[base + ((c + p - 1) % p) * stride];
+    const VkReal  upper = surface[base + ((c + 1) % p) * stride];
+    const VkReal  curvature = lower - 2 * surface[peak] + upper;
+    if (curvature < (VkReal)0)
+    {
+      offset = (lower - upper) / (2 * curvature);
+    }
+  }
+  shift[d] = (VkReal)c + offset - (c >= (p + 1) / 2 ? (VkReal)p : (VkReal)0);
+}
+
+// Multiply each of the h complex samples of a half spectrum in place by the transfer function,
+// or by its complex conjugate if `conjugate` is set.
+VK_KERNEL void
+VkMultiplySpectrum(VK_GLOBAL VkReal * spectrum, VK_GLOBAL const VkReal * transfer, VkIndex conjugate, VkIndex h)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= h)
+  {
+    return;
+  }
+  const VkReal sr = spectrum[2 * i];
+  const VkReal si = spectrum[2 * i + 1];
+  const VkReal tr = transfer[2 * i];
+  const VkReal ti = conjugate ? -transfer[2 * i + 1] : transfer[2 * i + 1];
+  spectrum[2 * i] = sr * tr - si * ti;
+  spectrum[2 * i + 1] = sr * ti + si * tr;
+}
+
+// Replace each of the n samples of the blurred estimate by the quotient of the input and it,
+// or by zero where it is smaller in magnitude than the threshold of DivideOrZeroOutImageFilter.
+VK_KERNEL void
+VkDivideOrZero(VK_GLOBAL const VkReal * input, VK_GLOBAL VkReal * blurred, VkIndex n)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= n)
+  {
+    return;
+  }
+  const VkReal threshold = (VkReal)1e-5;
+  const VkReal b = blurred[i];
+  blurred[i] = (b < threshold && b > -threshold) ? (VkReal)0 : input[i] / b;
+}
+
+// Multiply each of the n samples of the estimate in place by the correction.
+VK_KERNEL void
+VkMultiplyImages(VK_GLOBAL VkReal * estimate, VK_GLOBAL const VkReal * correction, VkIndex n)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= n)
+  {
+    return;
+  }
+  estimate[i] *= correction[i];
+}
+
+// Multiply each of the h complex samples of the half spectrum of an x by y by z domain by the
+// transfer function of the discrete Gaussian of variances vx, vy and vz, that is of the kernel
+// of GaussianOperator without truncation: exp(v * (cos(w) - 1)) along each dimension, at the
+// angular frequency w of the sample.
+VK_KERNEL void
+VkGaussianTransfer(VK_GLOBAL VkReal * spectrum,
+                   VkIndex            x,
+                   VkIndex            y,
+                   VkIndex            z,
+                   VkReal             vx,
+                   VkReal             vy,
+                   VkReal             vz,
+                   VkIndex            h)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= h)
+  {
+    return;
+  }
+  const VkReal  twoPi = (VkReal)6.283185307179586;
+  const VkIndex hx = x / 2 + 1;
+  const VkIndex kx = i % hx;
+  const VkIndex ky = (i / hx) % y;
+  const VkIndex kz = i / (hx * y) % z;
+  const VkReal  exponent = vx * (cos(twoPi * (VkReal)kx / (VkReal)x) - (VkReal)1) +
+                          vy * (cos(twoPi * (VkReal)ky / (VkReal)y) - (VkReal)1) +
+                          vz * (cos(twoPi * (VkReal)kz / (VkReal)z) - (VkReal)1);
+  const VkReal  transfer = exp(exponent);
+  spectrum[2 * i] *= transfer;
+  spectrum[2 * i + 1] *= transfer;
+}
+
+// Half spectrum of the samples c + j * x / dx of the Gaussian smoothing of the padded domain whose
+// half spectrum is given, for the decimated domain of size dx * dy * dz that divides it: the smoothed
+// spectrum is shifted by c and its aliases are summed into each of the h decimated samples, so
+// that a normalized inverse transform of the decimated domain yields the subsampled smoothing.
+VK_KERNEL void
+VkGaussianDecimate(VK_GLOBAL const VkReal * spectrum,
+                   VK_GLOBAL VkReal *       decimated,
+                   VkIndex                  x,
+                   VkIndex                  y,
+                   VkIndex                  z,
+                   VkIndex                  dx,
+                   VkIndex                  dy,
+                   VkIndex                  dz,
+                   VkReal                   vx,
+                   VkReal                   vy,
+                   VkReal                   vz,
+                   VkIndex                  cx,
+                   VkIndex                  cy,
+                   VkIndex                  cz,
+                   VkIndex                  h)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= h)
+  {
+    return;
+  }
+  const VkReal  twoPi = (VkReal)6.283185307179586;
+  const VkIndex hx = x / 2 + 1;
+  const VkIndex hdx = dx / 2 + 1;
+  const VkIndex jx = i % hdx;
+  const VkIndex jy = (i / hdx) % dy;
+  const VkIndex jz = i / (hdx * dy) % dz;
+  VkReal        re = (VkReal)0;
+  VkReal        im = (VkReal)0;
+  for (VkIndex kz = jz; kz < z; kz += dz)
+  {
+    for (VkIndex ky = jy; ky < y; ky += dy)
+    {
+      for (VkIndex kx = jx; kx < x; kx += dx)
+      {
+        // Samples beyond the half spectrum are the conjugates of their mirrors
+        const int     mirrored = kx >= hx;
+        const VkIndex sx = mirrored ? x - kx : kx;
+        const VkIndex sy = mirrored ? (y - ky) % y : ky;
+        const VkIndex sz = mirrored ? (z - kz) % z : kz;
+        const VkIndex s = sx + hx * (sy + y * sz);
+        const VkReal  sre = spectrum[2 * s];
+        const VkReal  sim = mirrored ? -spectrum[2 * s + 1] : spectrum[2 * s + 1];
+        const VkReal  exponent = vx * (cos(twoPi * (VkReal)kx / (VkReal)x) - (VkReal)1) +
+                                vy * (cos(twoPi * (VkReal)ky / (VkReal)y) - (VkReal)1) +
+                                vz * (cos(twoPi * (VkReal)kz / (VkReal)z) - (VkReal)1);
+        const VkReal  transfer = exp(exponent);
+        const VkReal  phase = twoPi * ((VkReal)(kx * cx % x) / (VkReal)x + (VkReal)(ky * cy % y) / (VkReal)y +
+                                      (VkReal)(kz * cz % z) / (VkReal)z);
+        const VkReal  c = cos(phase);
+        const VkReal  t = sin(phase);
+        re += transfer * (sre * c - sim * t);
+        im += transfer * (sre * t + sim * c);
+      }
+    }
+  }
+  const VkReal scale = (VkReal)(dx * dy * dz) / (VkReal)(x * y * z);
+  decimated[2 * i] = scale * re;
+  decimated[2 * i + 1] = scale * im;
+}
+
+// Divide each of the h complex samples of the input spectrum G in place by the transfer function H
+// as InverseDeconvolutionImageFilter (method 3), TikhonovDeconvolutionImageFilter (4) and
+// WienerDeconvolutionImageFilter (5) do: G / H, G * conj(H) / (|H|^2 + c) and
+// G * conj(H) / (|H|^2 + c / (|G|^2 - c)), or zero where |H| or the denominator is below the threshold.
+VK_KERNEL void
+VkRegularizedDivide(VK_GLOBAL VkReal *       spectrum,
+                    VK_GLOBAL const VkReal * transfer,
+                    VkIndex                  method,
+                    VkReal                   constant,
+                    VkReal                   threshold,
+                    VkIndex                  h)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= h)
+  {
+    return;
+  }
+  const VkReal gr = spectrum[2 * i];
+  const VkReal gi = spectrum[2 * i + 1];
+  const VkReal hr = transfer[2 * i];
+  const VkReal hi = transfer[2 * i + 1];
+  const VkReal normH = hr * hr + hi * hi;
+  VkReal       denominator = normH;
+  bool         zero = false;
+  switch (method)
+  {
+    case 4: // TIKHONOV
+      denominator += constant;
+      zero = denominator < threshold;
+      break;
+    case 5: // WIENER
+      denominator += constant / (gr * gr + gi * gi - constant);
+      zero = denominator < threshold && denominator > -threshold;
+      break;
+    default: // INVERSE
+      zero = sqrt(normH) < threshold;
+      break;
+  }
+  spectrum[2 * i] = zero ? (VkReal)0 : (gr * hr + gi * hi) / denominator;
+  spectrum[2 * i + 1] = zero ? (VkReal)0 : (gi * hr - gr * hi) / denominator;
+}
+
+// Advance each of the h complex samples of the spectrum F of a Landweber estimate in place by
+// one iteration, from the spectra G of the input and H of the kernel:
+// F <- alpha * conj(H) * G + (1 - alpha * |H|^2) * F.
+VK_KERNEL void
+VkLandweberUpdate(VK_GLOBAL VkReal *       estimate,
+                  VK_GLOBAL const VkReal * input,
+                  VK_GLOBAL const VkReal * transfer,
+                  VkReal                   alpha,
+                  VkIndex                  h)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= h)
+  {
+    return;
+  }
+  const VkReal hr = transfer[2 * i];
+  const VkReal hi = transfer[2 * i + 1];
+  const VkReal gr = input[2 * i];
+  const VkReal gi = input[2 * i + 1];
+  const VkReal damping = 1 - alpha * (hr * hr + hi * hi);
+  estimate[2 * i] = alpha * (hr * gr + hi * gi) + damping * estimate[2 * i];
+  estimate[2 * i + 1] = alpha * (hr * gi - hi * gr) + damping * estimate[2 * i + 1];
+}
+
+// Lines of length n whose samples lie `stride` apart in the image are numbered
+// line = (i / (stride * n)) * stride + i % stride, for an image sample i.
+
+// Gather `count` lines from the image into contiguous lines.
+VK_KERNEL void
+VkGatherLines(VK_GLOBAL const VkReal * input,
+              VK_GLOBAL VkReal *       output,
+              VkIndex                  components,
+              VkIndex                  n,
+              VkIndex                  stride,
+              VkIndex                  count)
+{
+  const VkIndex j = VK_GLOBAL_ID;
+  if (j >= n * count)
+  {
+    return;
+  }
+  const VkIndex line = j / n;
+  const VkIndex i = ((line / stride) * n + j % n) * stride + line % stride;
+  for (VkIndex c = 0; c < components; ++c)
+  {
+    output[j * components + c] = input[i * components + c];
+  }
+}
+
+// Scatter contiguous lines back into the image.
+VK_KERNEL void
+VkScatterLines(VK_GLOBAL const VkReal * input,
+               VK_GLOBAL VkReal *       output,
+               VkIndex                  components,
+               VkIndex                  n,
+               VkIndex                  stride,
+               VkIndex                  count)
+{
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= n * count)
+  {
+    return;
+  }
+  const VkIndex line = (i / (stride * n)) * stride + i % stride;
+  const VkIndex j = line * n + (i / stride) % n;
+  for (VkIndex c = 0; c < components; ++c)
+  {
+    output[i * components + c] = input[j * components + c];
+  }
+}
+
+// Gather the non-redundant half of the complex lines of a full spectrum in the image
+// into contiguous half spectra of n / 2 + 1 samples.
+VK_KERNEL void
+VkGatherHalfLines(VK_GLOBAL const VkReal * full, VK_GLOBAL VkReal * half, VkIndex n, VkIndex stride, VkIndex count)
+{
+  const VkIndex h = n / 2 + 1;
+  const VkIndex j = VK_GLOBAL_ID;
+  if (j >= h * count)
+  {
+    return;
+  }
+  const VkIndex line = j / h;
+  const VkIndex i = ((line / stride) * n + j % h) * stride + line % stride;
+  half[2 * j] = full[2 * i];
+  half[2 * j + 1] = full[2 * i + 1];
+}
+
+// Expand contiguous half spectra into full spectra in the image, from X[n - k] = conj(X[k]).
+VK_KERNEL void
+VkExpandHalfLines(VK_GLOBAL const VkReal * half, VK_GLOBAL VkReal * full, VkIndex n, VkIndex stride, VkIndex count)
+{
+  const VkIndex h = n / 2 + 1;
+  const VkIndex i = VK_GLOBAL_ID;
+  if (i >= n * count)
+  {
+    return;
+  }
+  const VkIndex k = (i / stride) % n;
+  const VkIndex line = (i / (stride * n)) * stride + i % stride;
+  const VkIndex j = line * h + (k < h ? k : n - k);
+  full[2 * i] = half[2 * j];
+  full[2 * i + 1] = k < h ? half[2 * j + 1] : -half[2 * j + 1];
+}
+
+// Complete a forward real-to-complex spectrum of size (nx, ny, nz) whose rows hold the
+// non-redundant half, from X[x, y, z] = conj(X[nx - x, ny - y, nz - z]). The mirror is
+// skipped along y (ty == 0) or z (tz == 0) when that dimension was not transformed.
+VK_KERNEL void
+VkCompleteHermitian(VK_GLOBAL VkReal * buffer, VkIndex nx, VkIndex ny, VkIndex nz, VkIndex ty, VkIndex tz)
+{
+  const VkIndex h = nx / 2 + 1;
+  const VkIndex m = nx - h;
+  const VkIndex j = VK_GLOBAL_ID;
+  if (j >= m * ny * nz)
+  {
+    return;
+  }
+  const VkIndex x = h + j % m;
+  const VkIndex y = (j / m) % ny;
+  const VkIndex z = j / (m * ny);
+  const VkIndex my = (ty && y > 0) ? ny - y : y;
+  const VkIndex mz = (tz && z > 0) ? nz - z : z;
+  const VkIndex i = (z * ny + y) * nx + x;
+  const VkIndex s = (mz * ny + my) * nx + nx - x;
+  buffer[2 * i] = buffer[2 * s];
+  buffer[2 * i + 1] = -buffer[2 * s + 1];
+}
+)";
+
+std::string
+MakeKernelSource(const VkCommon::PrecisionEnum precision)
+{
+  std::string source{ precision == VkCommon::PrecisionEnum::DOUBLE ? "#define VK_DOUBLE_PRECISION\n" : "" };
+  return source + VkKernelPreamble + VkKernelLibrary;
+}
+} // namespace
+
+
+VkDeviceBuffer::~VkDeviceBuffer()
+{
+  if (m_Memory)
+  {
+#if (VKFFT_BACKEND == CUDA)
+    cudaFree(m_Memory);
+#elif (VKFFT_BACKEND == OPENCL)
+    clReleaseMemObject(m_Memory);
+#endif
+  }
+}
+
+namespace
+{
+// Contexts of the devices that were used. The registry is never destroyed: a context releases
+// driver resources, which may already be torn down when static objects are destroyed at exit,
+// so contexts that are still registered then are leaked instead.
+struct VkDeviceContextRegistry
+{
+  std::mutex                                   mutex;
+  std::map<uint64_t, VkDeviceContext::Pointer> contexts;
+};
+
+VkDeviceContextRegistry &
+GetDeviceContextRegistry()
+{
+  static auto * const registry{ new VkDeviceContextRegistry{} };
+  return *registry;
+}
+} // namespace
+
+VkFFTResult
+VkDeviceContext::GetInstance(uint64_t deviceID, Pointer & context)
+{
+  VkDeviceContextRegistry &         registry{ GetDeviceContextRegistry() };
+  const std::lock_guard<std::mutex> lock{ registry.mutex };
+  Pointer &                         registered{ registry.contexts[deviceID] };
+  if (!registered)
+  {
+    Pointer           created{ new VkDeviceContext{ deviceID } };
+    const VkFFTResult resFFT{ created->Initialize() };
+    if (resFFT != VKFFT_SUCCESS)
+    {
+      return resFFT;
+    }
+    registered = created;
+  }
+  context = registered;
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+void
+VkDeviceContext::ReleaseInstances()
+{
+  std::map<uint64_t, Pointer> released;
+  {
+    VkDeviceContextRegistry &         registry{ GetDeviceContextRegistry() };
+    const std::lock_guard<std::mutex> lock{ registry.mutex };
+    released.swap(registry.contexts);
+  }
+  // The contexts are destroyed here unless a filter still holds them
+}
+
+VkDeviceContext::VkDeviceContext(uint64_t deviceID)
+{
+  m_VkGPU.device_id = deviceID;
+}
+
+VkDeviceContext::~VkDeviceContext()
+{
+  m_Resident.clear();
+  m_KernelSpectra.clear();
+
+#if (VKFFT_BACKEND == CUDA)
+  m_Kernels.clear();
+  for (CUmodule & module : m_KernelModules)
+  {
+    if (module)
+    {
+      cuModuleUnload(module);
+    }
+  }
+  if (m_VkGPU.context)
+  {
+    cuDevicePrimaryCtxRelease(m_VkGPU.device);
+  }
+#elif (VKFFT_BACKEND == OPENCL)
+  for (auto & kernel : m_Kernels)
+  {
+    if (kernel.second)
+    {
+      clReleaseKernel(kernel.second);
+    }
+  }
+  m_Kernels.clear();
+  for (cl_program & program : m_KernelPrograms)
+  {
+    if (program)
+    {
+      clReleaseProgram(program);
+    }
+  }
+  if (m_VkGPU.commandQueue)
+  {
+    clReleaseCommandQueue(m_VkGPU.commandQueue);
+  }
+  if (m_VkGPU.context)
+  {
+    clReleaseContext(m_VkGPU.context);
+  }
+#endif
+}
+
+VkFFTResult
+VkDeviceContext::Initialize()
+{
+#if (VKFFT_BACKEND == CUDA)
+  CUresult    res{ CUDA_SUCCESS };
+  cudaError_t res2{ cudaSuccess };
+  res = cuInit(0);
+  if (res != CUDA_SUCCESS)
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_INITIALIZE };
+  res2 = cudaSetDevice((int)m_VkGPU.device_id);
+  if (res2 != cudaSuccess)
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SET_DEVICE_ID };
+  res = cuDeviceGet(&m_VkGPU.device, (int)m_VkGPU.device_id);
+  if (res != CUDA_SUCCESS)
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_GET_DEVICE };
+  res = cuDevicePrimaryCtxRetain(&m_VkGPU.context, m_VkGPU.device);
+  if (res != CUDA_SUCCESS)
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_CONTEXT };
+  res = cuCtxSetCurrent(m_VkGPU.context);
+  if (res != CUDA_SUCCESS)
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_CONTEXT };
+
+#elif (VKFFT_BACKEND == OPENCL)
+  cl_int resCL{ CL_SUCCESS };
+
+  // Begin code that mimics launchVkFFT from VkFFT/Vulkan_FFT.cpp, though just the OpenCL part.
+  cl_uint numPlatforms;
+  resCL = clGetPlatformIDs(0, nullptr, &numPlatforms);
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clGetPlatformIDs returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_INITIALIZE };
+  }
+  std::unique_ptr<cl_platform_id[]> platformsArray{ std::make_unique<cl_platform_id[]>(numPlatforms) };
+  cl_platform_id *                  platforms{ &platformsArray[0] };
+  if (!platforms)
+    return VkFFTResult{ VKFFT_ERROR_MALLOC_FAILED };
+  resCL = clGetPlatformIDs(numPlatforms, platforms, nullptr);
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clGetPlatformIDs returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_INITIALIZE };
+  }
+  uint64_t k{ 0 };
+  for (uint64_t j{ 0 }; j < numPlatforms; j++)
+  {
+    cl_uint numDevices;
+    resCL = clGetDeviceIDs(platforms[j], CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices);
+    std::unique_ptr<cl_device_id[]> deviceListArray{ std::make_unique<cl_device_id[]>(numDevices) };
+    cl_device_id *                  deviceList{ &deviceListArray[0] };
+    if (!deviceList)
+      return VkFFTResult{ VKFFT_ERROR_MALLOC_FAILED };
+    resCL = clGetDeviceIDs(platforms[j], CL_DEVICE_TYPE_ALL, numDevices, deviceList, nullptr);
+    if (resCL != CL_SUCCESS)
+    {
+      std::cerr << __FILE__ "(" << __LINE__ << "): clGetDeviceIDs returned " << resCL << std::endl;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_GET_DEVICE };
+    }
+    for (uint64_t i{ 0 }; i < numDevices; i++)
+    {
+      if (k == m_VkGPU.device_id)
+      {
+        m_VkGPU.platform = platforms[j];
+        m_VkGPU.device = deviceList[i];
+#ifdef VKFFT_USE_ITK_GPU
+        if (this->ShareGPUContext())
+        {
+          k++;
+          continue;
+        }
+#endif
+        m_VkGPU.context = clCreateContext(NULL, 1, &m_VkGPU.device, NULL, NULL, &resCL);
+        if (resCL != CL_SUCCESS)
+        {
+          std::cerr << __FILE__ "(" << __LINE__ << "): clCreateContext returned " << resCL << std::endl;
+          return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_CONTEXT };
+        }
+        m_VkGPU.commandQueue = clCreateCommandQueue(m_VkGPU.context, m_VkGPU.device, 0, &resCL);
+        if (resCL != CL_SUCCESS)
+        {
+          std::cerr << __FILE__ "(" << __LINE__ << "): clCreateCommandQueue returned " << resCL << std::endl;
+          return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_COMMAND_QUEUE };
+        }
+        k++;
+      }
+      else
+      {
+        k++;
+      }
+    }
+  }
+#endif
+
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+VkFFTResult
+VkDeviceContext::Allocate(uint64_t bytes, VkDeviceBuffer::Pointer & buffer)
+{
+  DeviceMemoryType memory{ nullptr };
+#if (VKFFT_BACKEND == CUDA)
+  const cudaError resCu{ cudaMalloc(&memory, bytes) };
+  if (resCu != cudaSuccess)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): cudaMalloc returned " << resCu << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
+  }
+#elif (VKFFT_BACKEND == OPENCL)
+  cl_int resCL{ CL_SUCCESS };
+  memory = clCreateBuffer(m_VkGPU.context, CL_MEM_READ_WRITE, bytes, nullptr, &resCL);
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clCreateBuffer returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_ALLOCATE };
+  }
+#endif
+  buffer = std::make_shared<VkDeviceBuffer>(memory, bytes, m_VkGPU.device_id);
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+#if (VKFFT_BACKEND == OPENCL)
+VkFFTResult
+VkDeviceContext::Share(DeviceMemoryType memory, uint64_t bytes, VkDeviceBuffer::Pointer & buffer)
+{
+  const cl_int resCL{ clRetainMemObject(memory) };
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clRetainMemObject returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_INVALID_CONTEXT };
+  }
+  buffer = std::make_shared<VkDeviceBuffer>(memory, bytes, m_VkGPU.device_id);
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+#endif
+
+#ifdef VKFFT_USE_ITK_GPU
+bool
+VkDeviceContext::ShareGPUContext()
+{
+  // The command queue is shared too, so that work of ITK's GPU filters and of the Vk
+  // filters on the same buffers runs in submission order
+  GPUContextManager * const manager{ GPUContextManager::GetInstance() };
+  for (unsigned int i{ 0 }; i < manager->GetNumberOfCommandQueues(); ++i)
+  {
+    if (manager->GetDeviceId(i) != m_VkGPU.device)
+    {
+      continue;
+    }
+    cl_context       context{ manager->GetCurrentContext() };
+    cl_command_queue commandQueue{ manager->GetCommandQueue(i) };
+    if (clRetainContext(context) != CL_SUCCESS)
+    {
+      return false;
+    }
+    if (clRetainCommandQueue(commandQueue) != CL_SUCCESS)
+    {
+      clReleaseContext(context);
+      return false;
+    }
+    m_VkGPU.context = context;
+    m_VkGPU.commandQueue = commandQueue;
+    m_SharingGPUContext = true;
+    return true;
+  }
+  return false;
+}
+#endif
+
+VkFFTResult
+VkDeviceContext::MakeCurrent()
+{
+#if (VKFFT_BACKEND == CUDA)
+  // The context must be current on the calling thread
+  const CUresult res{ cuCtxSetCurrent(m_VkGPU.context) };
+  if (res != CUDA_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): cuCtxSetCurrent returned " << res << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SET_DEVICE_ID };
+  }
+#endif
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+VkFFTResult
+VkDeviceContext::CopyHostToDevice(DeviceMemoryType buffer, const void * hostBuffer, uint64_t bytes)
+{
+#if (VKFFT_BACKEND == CUDA)
+  const cudaError resCu{ cudaMemcpy(buffer, hostBuffer, bytes, cudaMemcpyHostToDevice) };
+  if (resCu != cudaSuccess)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): cudaMemcpy returned " << resCu << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+  }
+#elif (VKFFT_BACKEND == OPENCL)
+  const cl_int resCL{ clEnqueueWriteBuffer(
+    m_VkGPU.commandQueue, buffer, CL_TRUE, 0, bytes, hostBuffer, 0, nullptr, nullptr) };
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clEnqueueWriteBuffer returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+  }
+#endif
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+VkFFTResult
+VkDeviceContext::CopyDeviceToHost(void * hostBuffer, DeviceMemoryType buffer, uint64_t bytes)
+{
+#if (VKFFT_BACKEND == CUDA)
+  const cudaError resCu{ cudaMemcpy(hostBuffer, buffer, bytes, cudaMemcpyDeviceToHost) };
+  if (resCu != cudaSuccess)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): cudaMemcpy returned " << resCu << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+  }
+#elif (VKFFT_BACKEND == OPENCL)
+  const cl_int resCL{ clEnqueueReadBuffer(
+    m_VkGPU.commandQueue, buffer, CL_TRUE, 0, bytes, hostBuffer, 0, nullptr, nullptr) };
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clEnqueueReadBuffer returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+  }
+#endif
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+VkFFTResult
+VkDeviceContext::CopyDeviceToDevice(DeviceMemoryType destination, DeviceMemoryType source, uint64_t bytes)
+{
+#if (VKFFT_BACKEND == CUDA)
+  const cudaError resCu{ cudaMemcpy(destination, source, bytes, cudaMemcpyDeviceToDevice) };
+  if (resCu != cudaSuccess)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): cudaMemcpy returned " << resCu << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+  }
+#elif (VKFFT_BACKEND == OPENCL)
+  const cl_int resCL{ clEnqueueCopyBuffer(
+    m_VkGPU.commandQueue, source, destination, 0, 0, bytes, 0, nullptr, nullptr) };
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clEnqueueCopyBuffer returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COPY };
+  }
+#endif
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+VkFFTResult
+VkDeviceContext::Synchronize()
+{
+#if (VKFFT_BACKEND == CUDA)
+  const cudaError resCu{ cudaDeviceSynchronize() };
+  if (resCu != cudaSuccess)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): cudaDeviceSynchronize returned " << resCu << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SYNCHRONIZE };
+  }
+#elif (VKFFT_BACKEND == OPENCL)
+  const cl_int resCL{ clFinish(m_VkGPU.commandQueue) };
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clFinish returned " << resCL << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SYNCHRONIZE };
+  }
+#endif
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+VkFFTResult
+VkDeviceContext::LaunchKernel(PrecisionEnum                       precision,
+                              const char *                        kernelName,
+                              uint64_t                            globalSize,
+                              const std::vector<KernelArgument> & arguments)
+{
+  if (globalSize == 0)
+  {
+    return VkFFTResult{ VKFFT_SUCCESS };
+  }
+
+  // Kernel objects carry their arguments, so launches are serialized
+  const std::lock_guard<std::mutex> lock{ m_KernelMutex };
+  const size_t                      library{ precision == PrecisionEnum::DOUBLE ? 1UL : 0UL };
+
+#if (VKFFT_BACKEND == CUDA)
+  CUresult   res{ CUDA_SUCCESS };
+  CUmodule & module{ m_KernelModules[library] };
+  if (!module)
+  {
+    // Compile the kernel library for this device and precision
+    const std::string source{ MakeKernelSource(precision) };
+    nvrtcProgram      program;
+    nvrtcResult       resNVRTC{ nvrtcCreateProgram(&program, source.c_str(), "itkVkKernels.cu", 0, nullptr, nullptr) };
+    if (resNVRTC != NVRTC_SUCCESS)
+    {
+      std::cerr << __FILE__ "(" << __LINE__ << "): nvrtcCreateProgram returned " << resNVRTC << std::endl;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_PROGRAM };
+    }
+    int major{ 0 };
+    int minor{ 0 };
+    cuDeviceGetAttribute(&major, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR, m_VkGPU.device);
+    cuDeviceGetAttribute(&minor, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR, m_VkGPU.device);
+    const std::string architecture{ "--gpu-architecture=compute_" + std::to_string(10 * major + minor) };
+    const char *      options[]{ architecture.c_str() };
+    resNVRTC = nvrtcCompileProgram(program, 1, options);
+    if (resNVRTC != NVRTC_SUCCESS)
+    {
+      size_t logSize{ 0 };
+      nvrtcGetProgramLogSize(program, &logSize);
+      std::string log(logSize, '\0');
+      nvrtcGetProgramLog(program, &log[0]);
+      std::cerr << __FILE__ "(" << __LINE__ << "): nvrtcCompileProgram returned " << resNVRTC << std::endl
+                << log << std::endl;
+      nvrtcDestroyProgram(&program);
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COMPILE_PROGRAM };
+    }
+    size_t ptxSize{ 0 };
+    nvrtcGetPTXSize(program, &ptxSize);
+    std::string ptx(ptxSize, '\0');
+    nvrtcGetPTX(program, &ptx[0]);
+    nvrtcDestroyProgram(&program);
+    res = cuModuleLoadDataEx(&module, ptx.c_str(), 0, nullptr, nullptr);
+    if (res != CUDA_SUCCESS)
+    {
+      std::cerr << __FILE__ "(" << __LINE__ << "): cuModuleLoadDataEx returned " << res << std::endl;
+      module = nullptr;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_LOAD_MODULE };
+    }
+  }
+
+  CUfunction & kernel{ m_Kernels[{ precision, kernelName }] };
+  if (!kernel)
+  {
+    res = cuModuleGetFunction(&kernel, module, kernelName);
+    if (res != CUDA_SUCCESS)
+    {
+      std::cerr << __FILE__ "(" << __LINE__ << "): cuModuleGetFunction returned " << res << " for " << kernelName
+                << std::endl;
+      kernel = nullptr;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_GET_FUNCTION };
+    }
+  }
+
+  std::vector<void *> values;
+  for (const auto & argument : arguments)
+  {
+    values.push_back(const_cast<void *>(argument.value));
+  }
+  constexpr uint64_t blockSize{ 256 };
+  const uint64_t     gridSize{ (globalSize + blockSize - 1) / blockSize };
+  res = cuLaunchKernel(kernel,
+                       static_cast<unsigned int>(gridSize),
+                       1,
+                       1,
+                       static_cast<unsigned int>(blockSize),
+                       1,
+                       1,
+                       0,
+                       nullptr,
+                       values.data(),
+                       nullptr);
+  if (res != CUDA_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): cuLaunchKernel returned " << res << " for " << kernelName
+              << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_LAUNCH_KERNEL };
+  }
+#elif (VKFFT_BACKEND == OPENCL)
+  cl_int       resCL{ CL_SUCCESS };
+  cl_program & program{ m_KernelPrograms[library] };
+  if (!program)
+  {
+    // Compile the kernel library for this device and precision
+    const std::string source{ MakeKernelSource(precision) };
+    const char *      sourceText{ source.c_str() };
+    const size_t      sourceLength{ source.size() };
+    program = clCreateProgramWithSource(m_VkGPU.context, 1, &sourceText, &sourceLength, &resCL);
+    if (resCL != CL_SUCCESS)
+    {
+      std::cerr << __FILE__ "(" << __LINE__ << "): clCreateProgramWithSource returned " << resCL << std::endl;
+      program = nullptr;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_CREATE_PROGRAM };
+    }
+    resCL = clBuildProgram(program, 1, &m_VkGPU.device, nullptr, nullptr, nullptr);
+    if (resCL != CL_SUCCESS)
+    {
+      size_t logSize{ 0 };
+      clGetProgramBuildInfo(program, m_VkGPU.device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &logSize);
+      std::string log(logSize, '\0');
+      clGetProgramBuildInfo(program, m_VkGPU.device, CL_PROGRAM_BUILD_LOG, logSize, &log[0], nullptr);
+      std::cerr << __FILE__ "(" << __LINE__ << "): clBuildProgram returned " << resCL << std::endl
+                << log << std::endl;
+      clReleaseProgram(program);
+      program = nullptr;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_COMPILE_PROGRAM };
+    }
+  }
+
+  cl_kernel & kernel{ m_Kernels[{ precision, kernelName }] };
+  if (!kernel)
+  {
+    kernel = clCreateKernel(program, kernelName, &resCL);
+    if (resCL != CL_SUCCESS)
+    {
+      std::cerr << __FILE__ "(" << __LINE__ << "): clCreateKernel returned " << resCL << " for " << kernelName
+                << std::endl;
+      kernel = nullptr;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_GET_FUNCTION };
+    }
+  }
+
+  for (cl_uint i{ 0 }; i < arguments.size(); ++i)
+  {
+    resCL = clSetKernelArg(kernel, i, arguments[i].size, arguments[i].value);
+    if (resCL != CL_SUCCESS)
+    {
+      std::cerr << __FILE__ "(" << __LINE__ << "): clSetKernelArg returned " << resCL << " for argument " << i
+                << " of " << kernelName << std::endl;
+      return VkFFTResult{ VKFFT_ERROR_FAILED_TO_SET_KERNEL_ARG };
+    }
+  }
+  const size_t globalWorkSize{ static_cast<size_t>(globalSize) };
+  resCL = clEnqueueNDRangeKernel(
+    m_VkGPU.commandQueue, kernel, 1, nullptr, &globalWorkSize, nullptr, 0, nullptr, nullptr);
+  if (resCL != CL_SUCCESS)
+  {
+    std::cerr << __FILE__ "(" << __LINE__ << "): clEnqueueNDRangeKernel returned " << resCL << " for " << kernelName
+              << std::endl;
+    return VkFFTResult{ VKFFT_ERROR_FAILED_TO_LAUNCH_KERNEL };
+  }
+#endif
+
+  return VkFFTResult{ VKFFT_SUCCESS };
+}
+
+VkDeviceBuffer::Pointer
+VkDeviceContext::FindResident(const ResidencyKey & key)
+{
+  const std::lock_guard<std::mutex> lock{ m_ResidentMutex };
+  for (auto & entry : m_Resident)
+  {
+    if (entry.key.dataObject == key.dataObject && entry.key.timeStamp == key.timeStamp &&
+        entry.key.hostBuffer == key.hostBuffer && entry.key.bytes == key.bytes)
+    {
+      entry.lastUse = ++m_ResidentUses;
+      return entry.buffer;
+    }
+  }
+  return nullptr;
+}
+
+void
+VkDeviceContext::MakeResident(const ResidencyKey & key, const VkDeviceBuffer::Pointer & buffer, uint64_t budget)
+{
+  const std::lock_guard<std::mutex> lock{ m_ResidentMutex };
+
+  // Copies of an older state of the same data object can never be used again
+  const auto isStale = [&key](const ResidentEntry & entry) { return entry.key.dataObject == key.dataObject; };
+  m_Resident.erase(std::remove_if(m_Resident.begin(), m_Resident.end(), isStale), m_Resident.end());
+  if (!buffer || buffer->GetBytes() > budget)
+  {
+    return;
+  }
+
+  EvictLeastRecentlyUsed(m_Resident, buffer->GetBytes(), budget);
+  m_Resident.push_back(ResidentEntry{ key, buffer, ++m_ResidentUses });
+}
+
+void
+VkDeviceContext::ClearResident()
+{
+  const std::lock_guard<std::mutex> lock{ m_ResidentMutex };
+  m_Resident.clear();
+}
+
+uint64_t
+VkDeviceContext::GetResidentBytes() const
+{
+  const std::lock_guard<std::mutex> lock{ m_ResidentMutex };
+  uint64_t                          residentBytes{ 0 };
+  for (const auto & entry : m_Resident)
+  {
+    residentBytes += entry.buffer->GetBytes();
+  }
+  return residentBytes;
+}
+
+VkDeviceBuffer::Pointer
+VkDeviceContext::FindKernelSpectrum(const KernelSpectrumKey & key)
+{
+  const std::lock_guard<std::mutex> lock{ m_KernelSpectrumMutex };
+  for (auto & entry : m_KernelSpectra)
+  {
+    if (entry.key.dataObject == key.dataObject && entry.key.timeStamp == key.timeStamp &&
+        entry.key.precision == key.precision && std::equal(key.size, key.size + 3, entry.key.size) &&
+        std::equal(key.center, key.center + 3, entry.key.center) && entry.key.scale == key.scale &&
+        entry.key.numberKernels == key.numberKernels && entry.key.correlation == key.correlation)
+    {
+      entry.lastUse = ++m_KernelSpectrumUses;
+      ++m_KernelSpectrumStatistics.hits;
+      return entry.buffer;
+    }
+  }
+  ++m_KernelSpectrumStatistics.misses;
+  return nullptr;
+}
+
+void
+VkDeviceContext::KeepKernelSpectrum(const KernelSpectrumKey &       key,
+                                    const VkDeviceBuffer::Pointer & buffer,
+                                    uint64_t                        budget)
+{
+  const std::lock_guard<std::mutex> lock{ m_KernelSpectrumMutex };
+
+  // Spectra of an older state of the same kernel can never be used again, while spectra of
+  // its current state for other domains can
+  const auto     isStale = [&key](const KernelSpectrumEntry & entry) {
+    return entry.key.dataObject == key.dataObject && entry.key.timeStamp != key.timeStamp;
+  };
+  const uint64_t entries{ m_KernelSpectra.size() };
+  m_KernelSpectra.erase(std::remove_if(m_KernelSpectra.begin(), m_KernelSpectra.end(), isStale),
+                        m_KernelSpectra.end());
+  m_KernelSpectrumStatistics.evictions += entries - m_KernelSpectra.size();
+  if (!buffer || buffer->GetBytes() > budget)
+  {
+    return;
+  }
+
+  m_KernelSpectrumStatistics.evictions += EvictLeastRecentlyUsed(m_KernelSpectra, buffer->GetBytes(), budget);
+  m_KernelSpectra.push_back(KernelSpectrumEntry{ key, buffer, ++m_KernelSpectrumUses });
+}
+
+void
+VkDeviceContext::ClearKernelSpectra()
+{
+  const std::lock_guard<std::mutex> lock{ m_KernelSpectrumMutex };
+  m_KernelSpectrumStatistics.evictions += m_KernelSpectra.size();
+  m_KernelSpectra.clear();
+}
+
+auto
+VkDeviceContext::GetKernelSpectrumStatistics() const -> KernelSpectrumStatistics
+{
+  const std::lock_guard<std::mutex> lock{ m_KernelSpectrumMutex };
+  KernelSpectrumStatistics          statistics{ m_KernelSpectrumStatistics };
+  statistics.entries = m_KernelSpectra.size();
+  statistics.bytes = 0;
+  for (const auto & entry : m_KernelSpectra)
+  {
+    statistics.bytes += entry.buffer->GetBytes();
+  }
+  return statistics;
+}
+
+void
+VkDeviceContext::ResetKernelSpectrumStatistics()
+{
+  const std::lock_guard<std::mutex> lock{ m_KernelSpectrumMutex };
+  m_KernelSpectrumStatistics = KernelSpectrumStatistics{};
+}
+
+} // namespace itk
@@ -20,6 +20,10 @@
 #include "itkVkComplexToComplex1DFFTImageFilter.h"
 #include "itkVkComplexToComplexFFTImageFilter.h"
 #include "itkFFTImageFilterFactory.h"
+#include "itkVkDeconvolutionImageFilterFactory.h"
+#include "itkVkFFTConvolutionImageFilterFactory.h"
+#include "itkVkFFTDiscreteGaussianImageFilterFactory.h"
+#include "itkVkFFTNormalizedCorrelationImageFilterFactory.h"
 #include "itkVkForward1DFFTImageFilter.h"
 #include "itkVkForwardFFTImageFilter.h"
 #include "itkVkHalfHermitianToRealInverseFFTImageFilter.h"
@@ -55,6 +59,14 @@ VkFFTImageFilterInitFactory::RegisterFactories()
                                           itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
   itk::ObjectFactoryBase::RegisterFactory(FFTImageFilterFactory<VkRealToHalfHermitianForwardFFTImageFilter>::New(),
                                           itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
+  itk::ObjectFactoryBase::RegisterFactory(VkFFTConvolutionImageFilterFactory::New(),
+                                          itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
+  itk::ObjectFactoryBase::RegisterFactory(VkFFTNormalizedCorrelationImageFilterFactory::New(),
+                                          itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
+  itk::ObjectFactoryBase::RegisterFactory(VkDeconvolutionImageFilterFactory::New(),
+                                          itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
+  itk::ObjectFactoryBase::RegisterFactory(VkFFTDiscreteGaussianImageFilterFactory::New(),
+                                          itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
 }
 
 // Undocumented API used to register during static initialization.
@@ -17,6 +17,7 @@
  *=========================================================================*/
 #include "itkVkGlobalConfiguration.h"
 
+#include <fstream>
 #include <mutex>
 #include "itkSingleton.h"
 
@@ -74,4 +75,193 @@ VkGlobalConfiguration::GetDeviceID()
   return uint64_t{ GetInstance()->m_DeviceID };
 }
 
+void
+VkGlobalConfiguration::SetDeviceResidencyBudget(const uint64_t bytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  GetInstance()->m_DeviceResidencyBudget = bytes;
+}
+
+uint64_t
+VkGlobalConfiguration::GetDeviceResidencyBudget()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return uint64_t{ GetInstance()->m_DeviceResidencyBudget };
+}
+
+void
+VkGlobalConfiguration::SetKernelSpectrumCacheBudget(const uint64_t bytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  GetInstance()->m_KernelSpectrumCacheBudget = bytes;
+}
+
+uint64_t
+VkGlobalConfiguration::GetKernelSpectrumCacheBudget()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return uint64_t{ GetInstance()->m_KernelSpectrumCacheBudget };
+}
+
+void
+VkGlobalConfiguration::SetDefaultFFTDeviceMinimumSamples(const uint64_t samples)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  GetInstance()->m_DefaultFFTDeviceMinimumSamples = samples;
+}
+
+uint64_t
+VkGlobalConfiguration::GetDefaultFFTDeviceMinimumSamples()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return uint64_t{ GetInstance()->m_DefaultFFTDeviceMinimumSamples };
+}
+
+void
+VkGlobalConfiguration::SetFFTDeviceMinimumSamples(const uint64_t      deviceID,
+                                                  const std::string & filterName,
+                                                  const unsigned int  precisionBytes,
+                                                  const uint64_t      samples)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_FFTDeviceMinimumSamplesLock);
+  instance->m_FFTDeviceMinimumSamples[std::make_tuple(deviceID, filterName, precisionBytes)] = samples;
+}
+
+uint64_t
+VkGlobalConfiguration::GetFFTDeviceMinimumSamples(const uint64_t      deviceID,
+                                                  const std::string & filterName,
+                                                  const unsigned int  precisionBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_FFTDeviceMinimumSamplesLock);
+  const auto it{ instance->m_FFTDeviceMinimumSamples.find(std::make_tuple(deviceID, filterName, precisionBytes)) };
+  if (it == instance->m_FFTDeviceMinimumSamples.end())
+  {
+    return instance->m_DefaultFFTDeviceMinimumSamples;
+  }
+  return it->second;
+}
+
+void
+VkGlobalConfiguration::RemoveFFTDeviceMinimumSamples()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_FFTDeviceMinimumSamplesLock);
+  instance->m_FFTDeviceMinimumSamples.clear();
+}
+
+void
+VkGlobalConfiguration::SetSmoothingCostModel(const uint64_t deviceID, const SmoothingCostModel & model)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_SmoothingCostModelLock);
+  instance->m_SmoothingCostModels[deviceID] = model;
+}
+
+bool
+VkGlobalConfiguration::GetSmoothingCostModel(const uint64_t deviceID, SmoothingCostModel & model)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_SmoothingCostModelLock);
+  const auto                        it{ instance->m_SmoothingCostModels.find(deviceID) };
+  if (it == instance->m_SmoothingCostModels.end())
+  {
+    return false;
+  }
+  model = it->second;
+  return true;
+}
+
+void
+VkGlobalConfiguration::RemoveSmoothingCostModels()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_SmoothingCostModelLock);
+  instance->m_SmoothingCostModels.clear();
+}
+
+void
+VkGlobalConfiguration::WriteSmoothingCostModels(const std::string & fileName)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot write smoothing cost models to " << fileName);
+  }
+
+  // One line per device: its ID, the number of work units, and the spatial and FFT coefficients
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_SmoothingCostModelLock);
+  file.precision(17);
+  for (const auto & deviceModel : instance->m_SmoothingCostModels)
+  {
+    const SmoothingCostModel & model{ deviceModel.second };
+    file << deviceModel.first << ' ' << model.numberOfWorkUnits;
+    for (const double coefficient : model.spatialCoefficients)
+    {
+      file << ' ' << coefficient;
+    }
+    for (const double coefficient : model.fftCoefficients)
+    {
+      file << ' ' << coefficient;
+    }
+    file << '\n';
+  }
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot write smoothing cost models to " << fileName);
+  }
+}
+
+void
+VkGlobalConfiguration::ReadSmoothingCostModels(const std::string & fileName)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::ifstream file(fileName);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot read smoothing cost models from " << fileName);
+  }
+
+  std::map<uint64_t, SmoothingCostModel> models;
+  uint64_t                               deviceID{ 0 };
+  while (file >> deviceID)
+  {
+    SmoothingCostModel model;
+    file >> model.numberOfWorkUnits;
+    for (double & coefficient : model.spatialCoefficients)
+    {
+      file >> coefficient;
+    }
+    for (double & coefficient : model.fftCoefficients)
+    {
+      file >> coefficient;
+    }
+    if (!file)
+    {
+      itkGenericExceptionMacro("Invalid smoothing cost model in " << fileName);
+    }
+    models[deviceID] = model;
+  }
+  if (!file.eof())
+  {
+    itkGenericExceptionMacro("Invalid smoothing cost model in " << fileName);
+  }
+
+  const Pointer                     instance{ GetInstance() };
+  const std::lock_guard<std::mutex> lock(instance->m_SmoothingCostModelLock);
+  for (const auto & deviceModel : models)
+  {
+    instance->m_SmoothingCostModels[deviceModel.first] = deviceModel.second;
+  }
+}
+
 } // namespace itk
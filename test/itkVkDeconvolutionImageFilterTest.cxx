@@ -0,0 +1,345 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCommand.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkVkDeconvolutionImageFilterFactory.h"
+#include "itkVkInverseDeconvolutionImageFilter.h"
+#include "itkVkLandweberDeconvolutionImageFilter.h"
+#include "itkVkRichardsonLucyDeconvolutionImageFilter.h"
+#include "itkVkTikhonovDeconvolutionImageFilter.h"
+#include "itkVkWienerDeconvolutionImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+
+// Verify that VkRichardsonLucyDeconvolutionImageFilter and VkLandweberDeconvolutionImageFilter
+// compute the same iterations as their ITK counterparts for the boundary conditions that they pad
+// on the device, that observers of IterationEvent see the iteration, the current estimate at the
+// requested interval and can stop the iterations, that VkInverseDeconvolutionImageFilter,
+// VkTikhonovDeconvolutionImageFilter and VkWienerDeconvolutionImageFilter compute the same
+// divisions as their ITK counterparts, and that the filters override their ITK counterparts
+// through their factory.
+
+namespace
+{
+template <typename TReferenceFilter, typename TVkFilter, typename TImage>
+int
+CompareIterations(const TImage * image, const TImage * kernel, const std::string & name)
+{
+  using OutputRegionModeEnum = itk::ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion;
+  using BoundaryConditionEnum = typename TVkFilter::BoundaryConditionEnum;
+
+  itk::PeriodicBoundaryCondition<TImage> periodicCondition;
+  itk::ConstantBoundaryCondition<TImage> zeroCondition;
+  const std::vector<std::pair<itk::ImageBoundaryCondition<TImage> *, BoundaryConditionEnum>> boundaryConditions{
+    { nullptr, BoundaryConditionEnum::ZERO_FLUX_NEUMANN },
+    { &periodicCondition, BoundaryConditionEnum::PERIODIC },
+    { &zeroCondition, BoundaryConditionEnum::ZERO }
+  };
+
+  int result{ EXIT_SUCCESS };
+  for (const auto & boundaryCondition : boundaryConditions)
+  {
+    for (const auto outputRegionMode : { OutputRegionModeEnum::SAME, OutputRegionModeEnum::VALID })
+    {
+      auto referenceFilter = TReferenceFilter::New();
+      auto vkFilter = TVkFilter::New();
+      for (TReferenceFilter * filter :
+           { referenceFilter.GetPointer(), static_cast<TReferenceFilter *>(vkFilter.GetPointer()) })
+      {
+        filter->SetInput(image);
+        filter->SetKernelImage(kernel);
+        filter->SetOutputRegionMode(outputRegionMode);
+        filter->SetNormalize(true);
+        filter->SetNumberOfIterations(5);
+        if (boundaryCondition.first)
+        {
+          filter->SetBoundaryCondition(boundaryCondition.first);
+        }
+      }
+      ITK_TEST_EXPECT_EQUAL(vkFilter->GetVkBoundaryCondition(), boundaryCondition.second);
+      ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+      ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+      ITK_TEST_EXPECT_EQUAL(vkFilter->GetIteration(), 5u);
+
+      std::ostringstream description;
+      description << name << ", " << boundaryCondition.second << ", " << outputRegionMode;
+      if (itk::VkTesting::CompareImages(
+            vkFilter->GetOutput(), referenceFilter->GetOutput(), description.str(), 1e-3, 1e-3) != EXIT_SUCCESS)
+      {
+        result = EXIT_FAILURE;
+      }
+    }
+  }
+  return result;
+}
+
+template <typename TReferenceFilter, typename TVkFilter, typename TImage, typename TConfigure>
+int
+CompareDivisions(const TImage * image, const TImage * kernel, const std::string & name, TConfigure configure)
+{
+  using OutputRegionModeEnum = itk::ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion;
+  using BoundaryConditionEnum = typename TVkFilter::BoundaryConditionEnum;
+
+  itk::PeriodicBoundaryCondition<TImage> periodicCondition;
+  itk::ConstantBoundaryCondition<TImage> zeroCondition;
+  const std::vector<std::pair<itk::ImageBoundaryCondition<TImage> *, BoundaryConditionEnum>> boundaryConditions{
+    { nullptr, BoundaryConditionEnum::ZERO_FLUX_NEUMANN },
+    { &periodicCondition, BoundaryConditionEnum::PERIODIC },
+    { &zeroCondition, BoundaryConditionEnum::ZERO }
+  };
+
+  int result{ EXIT_SUCCESS };
+  for (const auto & boundaryCondition : boundaryConditions)
+  {
+    for (const auto outputRegionMode : { OutputRegionModeEnum::SAME, OutputRegionModeEnum::VALID })
+    {
+      auto referenceFilter = TReferenceFilter::New();
+      auto vkFilter = TVkFilter::New();
+      for (TReferenceFilter * filter :
+           { referenceFilter.GetPointer(), static_cast<TReferenceFilter *>(vkFilter.GetPointer()) })
+      {
+        filter->SetInput(image);
+        filter->SetKernelImage(kernel);
+        filter->SetOutputRegionMode(outputRegionMode);
+        filter->SetNormalize(true);
+        if (boundaryCondition.first)
+        {
+          filter->SetBoundaryCondition(boundaryCondition.first);
+        }
+        configure(filter);
+      }
+      ITK_TEST_EXPECT_EQUAL(vkFilter->GetVkBoundaryCondition(), boundaryCondition.second);
+      ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+      ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+
+      std::ostringstream description;
+      description << name << ", " << boundaryCondition.second << ", " << outputRegionMode;
+      if (itk::VkTesting::CompareImages(
+            vkFilter->GetOutput(), referenceFilter->GetOutput(), description.str(), 1e-3, 1e-3) != EXIT_SUCCESS)
+      {
+        result = EXIT_FAILURE;
+      }
+    }
+  }
+  return result;
+}
+
+// Record the iterations that a deconvolution filter reports and whether its current estimate
+// is available, and stop it after `StopIteration` iterations
+template <typename TFilter>
+class IterationObserver : public itk::Command
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IterationObserver);
+
+  using Self = IterationObserver;
+  using Superclass = itk::Command;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  void
+  Execute(itk::Object * caller, const itk::EventObject & event) override
+  {
+    auto * const filter = dynamic_cast<TFilter *>(caller);
+    if (!filter || !itk::IterationEvent().CheckEvent(&event))
+    {
+      return;
+    }
+    Iterations.push_back(filter->GetIteration());
+    const auto * const estimate = filter->GetCurrentEstimate();
+    Estimates.push_back(estimate != nullptr &&
+                        estimate->GetBufferedRegion().IsInside(filter->GetInput()->GetLargestPossibleRegion()));
+    if (filter->GetIteration() == StopIteration)
+    {
+      filter->SetStopIteration(true);
+    }
+  }
+
+  void
+  Execute(const itk::Object *, const itk::EventObject &) override
+  {}
+
+  std::vector<unsigned int> Iterations{};
+  std::vector<bool>         Estimates{};
+  unsigned int              StopIteration{ 0 };
+
+protected:
+  IterationObserver() = default;
+};
+} // namespace
+
+int
+itkVkDeconvolutionImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ReferenceRichardsonLucyFilterType = itk::RichardsonLucyDeconvolutionImageFilter<ImageType>;
+  using VkRichardsonLucyFilterType = itk::VkRichardsonLucyDeconvolutionImageFilter<ImageType>;
+  using ReferenceLandweberFilterType = itk::LandweberDeconvolutionImageFilter<ImageType>;
+  using VkLandweberFilterType = itk::VkLandweberDeconvolutionImageFilter<ImageType>;
+  using ReferenceInverseFilterType = itk::InverseDeconvolutionImageFilter<ImageType>;
+  using VkInverseFilterType = itk::VkInverseDeconvolutionImageFilter<ImageType>;
+  using ReferenceTikhonovFilterType = itk::TikhonovDeconvolutionImageFilter<ImageType>;
+  using VkTikhonovFilterType = itk::VkTikhonovDeconvolutionImageFilter<ImageType>;
+  using ReferenceWienerFilterType = itk::WienerDeconvolutionImageFilter<ImageType>;
+  using VkWienerFilterType = itk::VkWienerDeconvolutionImageFilter<ImageType>;
+
+  // A positive image, as Richardson-Lucy expects, and a smooth kernel
+  typename ImageType::SizeType  size{ { 23, 17 } };
+  typename ImageType::IndexType index{ { 3, -2 } };
+  auto                          image = ImageType::New();
+  image->SetRegions(typename ImageType::RegionType{ index, size });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set(static_cast<PixelType>((5 * pixelIndex[0] + 3 * pixelIndex[1] + 26) % 13) + 1.0f);
+  }
+
+  typename ImageType::SizeType kernelSize{ { 5, 4 } };
+  auto                         kernel = ImageType::New();
+  kernel->SetRegions(kernelSize);
+  kernel->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(kernel, kernel->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set(static_cast<PixelType>(1 + (pixelIndex[0] + 2 * pixelIndex[1]) % 3));
+  }
+
+  auto richardsonLucyFilter = VkRichardsonLucyFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    richardsonLucyFilter, VkRichardsonLucyDeconvolutionImageFilter, RichardsonLucyDeconvolutionImageFilter);
+  ITK_TEST_EXPECT_EQUAL(richardsonLucyFilter->GetCurrentEstimateInterval(), 0u);
+  auto landweberFilter = VkLandweberFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    landweberFilter, VkLandweberDeconvolutionImageFilter, LandweberDeconvolutionImageFilter);
+  auto inverseFilter = VkInverseFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(inverseFilter, VkInverseDeconvolutionImageFilter, InverseDeconvolutionImageFilter);
+  auto tikhonovFilter = VkTikhonovFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    tikhonovFilter, VkTikhonovDeconvolutionImageFilter, TikhonovDeconvolutionImageFilter);
+  auto wienerFilter = VkWienerFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(wienerFilter, VkWienerDeconvolutionImageFilter, WienerDeconvolutionImageFilter);
+
+  int result{ EXIT_SUCCESS };
+  if (CompareIterations<ReferenceRichardsonLucyFilterType, VkRichardsonLucyFilterType>(
+        image.GetPointer(), kernel.GetPointer(), "Richardson-Lucy") != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+  if (CompareIterations<ReferenceLandweberFilterType, VkLandweberFilterType>(
+        image.GetPointer(), kernel.GetPointer(), "Landweber") != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // The direct deconvolutions with their default and with adjusted settings
+  for (const double threshold : { 1.0e-4, 0.05 })
+  {
+    if (CompareDivisions<ReferenceInverseFilterType, VkInverseFilterType>(
+          image.GetPointer(), kernel.GetPointer(), "Inverse", [threshold](ReferenceInverseFilterType * filter) {
+            filter->SetKernelZeroMagnitudeThreshold(threshold);
+          }) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  for (const double regularizationConstant : { 0.0, 0.1 })
+  {
+    if (CompareDivisions<ReferenceTikhonovFilterType, VkTikhonovFilterType>(
+          image.GetPointer(),
+          kernel.GetPointer(),
+          "Tikhonov",
+          [regularizationConstant](ReferenceTikhonovFilterType * filter) {
+            filter->SetRegularizationConstant(regularizationConstant);
+          }) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  for (const double noiseVariance : { 0.0, 0.5 })
+  {
+    if (CompareDivisions<ReferenceWienerFilterType, VkWienerFilterType>(
+          image.GetPointer(), kernel.GetPointer(), "Wiener", [noiseVariance](ReferenceWienerFilterType * filter) {
+            filter->SetNoiseVariance(noiseVariance);
+          }) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // Observers see the iteration and the current estimate at the requested interval, and can stop
+  // the iterations early
+  richardsonLucyFilter->SetInput(image);
+  richardsonLucyFilter->SetKernelImage(kernel);
+  richardsonLucyFilter->SetNormalize(true);
+  richardsonLucyFilter->SetNumberOfIterations(10);
+  richardsonLucyFilter->SetCurrentEstimateInterval(2);
+  auto observer = IterationObserver<VkRichardsonLucyFilterType>::New();
+  observer->StopIteration = 6;
+  richardsonLucyFilter->AddObserver(itk::IterationEvent(), observer);
+  ITK_TRY_EXPECT_NO_EXCEPTION(richardsonLucyFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(observer->Iterations.size(), size_t{ 7 });
+  for (unsigned int iteration{ 0 }; iteration < observer->Iterations.size(); ++iteration)
+  {
+    ITK_TEST_EXPECT_EQUAL(observer->Iterations[iteration], iteration);
+    ITK_TEST_EXPECT_TRUE(observer->Estimates[iteration]);
+  }
+  ITK_TEST_EXPECT_EQUAL(richardsonLucyFilter->GetIteration(), 6u);
+
+  // Verify default is non-accelerated implementation, then register factory and verify override
+  auto referenceRichardsonLucyFilter = ReferenceRichardsonLucyFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkRichardsonLucyFilterType *>(referenceRichardsonLucyFilter.GetPointer()) ==
+                       nullptr);
+  auto referenceLandweberFilter = ReferenceLandweberFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkLandweberFilterType *>(referenceLandweberFilter.GetPointer()) == nullptr);
+  itk::VkDeconvolutionImageFilterFactory::RegisterOneFactory();
+  referenceRichardsonLucyFilter = ReferenceRichardsonLucyFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkRichardsonLucyFilterType *>(referenceRichardsonLucyFilter.GetPointer()) !=
+                       nullptr);
+  referenceLandweberFilter = ReferenceLandweberFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkLandweberFilterType *>(referenceLandweberFilter.GetPointer()) != nullptr);
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkInverseFilterType *>(ReferenceInverseFilterType::New().GetPointer()) != nullptr);
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkTikhonovFilterType *>(ReferenceTikhonovFilterType::New().GetPointer()) !=
+                       nullptr);
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkWienerFilterType *>(ReferenceWienerFilterType::New().GetPointer()) != nullptr);
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkComplexToComplexFFTImageFilter.h"
+#include "itkVkDeviceContext.h"
+#include "itkVkForward1DFFTImageFilter.h"
+#include "itkVkForwardFFTImageFilter.h"
+#include "itkVkGlobalConfiguration.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Verify that transforms reusing an input that is resident on the device
+// compute the same values as transforms that upload it, that a modified
+// input is uploaded again, and that released device contexts are recreated.
+
+int
+itkVkDeviceResidencyTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using RealType = float;
+  using RealImageType = itk::Image<RealType, Dimension>;
+  using ComplexImageType = itk::Image<std::complex<RealType>, Dimension>;
+  using ForwardFilterType = itk::VkForwardFFTImageFilter<RealImageType, ComplexImageType>;
+  using Forward1DFilterType = itk::VkForward1DFFTImageFilter<RealImageType, ComplexImageType>;
+  using ComplexFilterType = itk::VkComplexToComplexFFTImageFilter<ComplexImageType>;
+
+  constexpr float valueTolerance{ 1e-3f };
+
+  bool       testPassed{ true };
+  const auto compareImages = [&testPassed](const char * name, ComplexImageType * image, ComplexImageType * expected) {
+    for (itk::ImageRegionConstIteratorWithIndex<ComplexImageType> it(image, image->GetLargestPossibleRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      if (std::abs(it.Get() - expected->GetPixel(it.GetIndex())) > valueTolerance)
+      {
+        std::cout << name << " mismatch at " << it.GetIndex() << ": " << it.Get()
+                  << " != " << expected->GetPixel(it.GetIndex()) << std::endl;
+        testPassed = false;
+      }
+    }
+  };
+
+  typename RealImageType::SizeType size{ { 16, 12 } };
+  auto                             realImage = RealImageType::New();
+  realImage->SetRegions(size);
+  realImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<RealImageType> it(realImage, realImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<RealType>((5 * index[0] + 3 * index[1]) % 13) - 6.0f);
+  }
+
+  auto complexImage = ComplexImageType::New();
+  complexImage->SetRegions(size);
+  complexImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ComplexImageType> it(complexImage, complexImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(std::complex<RealType>(static_cast<RealType>((index[0] + 2 * index[1]) % 7),
+                                  static_cast<RealType>((3 * index[0] + index[1]) % 5)));
+  }
+
+  // Reference results, uploading every input
+  itk::VkGlobalConfiguration::SetDeviceResidencyBudget(0);
+
+  auto referenceForwardFilter = ForwardFilterType::New();
+  referenceForwardFilter->SetInput(realImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceForwardFilter->Update());
+
+  auto referenceForward1DFilter = Forward1DFilterType::New();
+  referenceForward1DFilter->SetInput(realImage);
+  referenceForward1DFilter->SetDirection(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceForward1DFilter->Update());
+
+  auto referenceComplexFilter = ComplexFilterType::New();
+  referenceComplexFilter->SetInput(complexImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceComplexFilter->Update());
+
+  // Keep inputs resident on the device
+  itk::VkGlobalConfiguration::SetDeviceResidencyBudget(1 << 20);
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetDeviceResidencyBudget(), 1 << 20);
+
+  itk::VkDeviceContext::Pointer context;
+  if (itk::VkDeviceContext::GetInstance(itk::VkGlobalConfiguration::GetDeviceID(), context) != VKFFT_SUCCESS)
+  {
+    std::cout << "Test failed: no device context." << std::endl;
+    return EXIT_FAILURE;
+  }
+  context->ClearResident();
+  ITK_TEST_EXPECT_EQUAL(context->GetResidentBytes(), 0);
+
+  // The first transform uploads the input and keeps it resident ...
+  const uint64_t realBytes{ size[0] * size[1] * sizeof(RealType) };
+  auto           forwardFilter = ForwardFilterType::New();
+  forwardFilter->SetInput(realImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(context->GetResidentBytes(), realBytes);
+  compareImages("Forward", forwardFilter->GetOutput(), referenceForwardFilter->GetOutput());
+
+  // ... and a transform of another filter along one direction reuses it
+  auto forward1DFilter = Forward1DFilterType::New();
+  forward1DFilter->SetInput(realImage);
+  forward1DFilter->SetDirection(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(forward1DFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(context->GetResidentBytes(), realBytes);
+  compareImages("Forward1D", forward1DFilter->GetOutput(), referenceForward1DFilter->GetOutput());
+
+  // A complex input that is resident is not overwritten by the in-place transform
+  const uint64_t complexBytes{ size[0] * size[1] * sizeof(std::complex<RealType>) };
+  for (unsigned int run{ 0 }; run < 2; ++run)
+  {
+    auto complexFilter = ComplexFilterType::New();
+    complexFilter->SetInput(complexImage);
+    ITK_TRY_EXPECT_NO_EXCEPTION(complexFilter->Update());
+    ITK_TEST_EXPECT_EQUAL(context->GetResidentBytes(), realBytes + complexBytes);
+    compareImages("ComplexToComplex", complexFilter->GetOutput(), referenceComplexFilter->GetOutput());
+  }
+
+  // A modified input replaces its stale resident copy
+  typename RealImageType::IndexType index{ { 3, 4 } };
+  realImage->SetPixel(index, realImage->GetPixel(index) + 10.0f);
+  realImage->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(context->GetResidentBytes(), realBytes + complexBytes);
+
+  itk::VkGlobalConfiguration::SetDeviceResidencyBudget(0);
+  referenceForwardFilter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceForwardFilter->Update());
+  compareImages("Modified forward", forwardFilter->GetOutput(), referenceForwardFilter->GetOutput());
+
+  context->ClearResident();
+  ITK_TEST_EXPECT_EQUAL(context->GetResidentBytes(), 0);
+
+  // Released contexts are created anew on next use
+  itk::VkDeviceContext::ReleaseInstances();
+  itk::VkDeviceContext::Pointer newContext;
+  ITK_TEST_EXPECT_EQUAL(itk::VkDeviceContext::GetInstance(itk::VkGlobalConfiguration::GetDeviceID(), newContext),
+                        VKFFT_SUCCESS);
+  ITK_TEST_EXPECT_TRUE(newContext != context);
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkVkDiscreteGaussianImageFilter.h"
+#include "itkVkDiscreteGaussianImageFilterFactory.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+
+// Verify that VkDiscreteGaussianImageFilter chooses separable smoothing for
+// small kernels and images and FFT smoothing for large ones, that it smooths
+// as DiscreteGaussianImageFilter does either way, that boundary conditions
+// whose padding the device does not generate are smoothed spatially, and that
+// it overrides DiscreteGaussianImageFilter through its factory.
+
+int
+itkVkDiscreteGaussianImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<ImageType>;
+  using VkFilterType = itk::VkDiscreteGaussianImageFilter<ImageType>;
+  using SmoothingEnum = typename VkFilterType::SmoothingEnum;
+
+  auto vkFilter = VkFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(vkFilter, VkDiscreteGaussianImageFilter, DiscreteGaussianImageFilter);
+  ITK_TEST_SET_GET_VALUE(SmoothingEnum::AUTOMATIC, vkFilter->GetSmoothing());
+  ITK_TEST_SET_GET_VALUE(8.0f, vkFilter->GetMetricThreshold());
+  ITK_TEST_SET_GET_BOOLEAN(vkFilter, UseSmoothingCostModel, true);
+
+  // A small image with a small kernel, and a large image with a large kernel, on either side
+  // of the metric threshold
+  constexpr float metricThreshold{ 5.0f };
+  const std::vector<std::pair<itk::SizeValueType, double>> cases{ { 16, 1.0 }, { 64, 9.0 } };
+
+  int result{ EXIT_SUCCESS };
+  for (const auto & smoothingCase : cases)
+  {
+    typename ImageType::SizeType size;
+    size.Fill(smoothingCase.first);
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      const auto & pixelIndex = it.GetIndex();
+      it.Set(static_cast<PixelType>((5 * pixelIndex[0] + 3 * pixelIndex[1]) % 13) - 6.0f);
+    }
+
+    auto referenceFilter = ReferenceFilterType::New();
+    referenceFilter->SetInput(image);
+    referenceFilter->SetVariance(smoothingCase.second);
+    referenceFilter->SetMaximumError(1e-5);
+    referenceFilter->SetMaximumKernelWidth(64);
+    ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+    const bool expectFFT{ smoothingCase.second > 1.0 };
+    for (const SmoothingEnum smoothing : { SmoothingEnum::AUTOMATIC, SmoothingEnum::SPATIAL, SmoothingEnum::FFT })
+    {
+      vkFilter = VkFilterType::New();
+      vkFilter->SetInput(image);
+      vkFilter->SetVariance(smoothingCase.second);
+      vkFilter->SetMaximumError(1e-5);
+      vkFilter->SetMaximumKernelWidth(64);
+      vkFilter->SetMetricThreshold(metricThreshold);
+      vkFilter->UseSmoothingCostModelOff();
+      vkFilter->SetSmoothing(smoothing);
+      ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+      ITK_TEST_EXPECT_EQUAL(vkFilter->GetUseFFT(),
+                            smoothing == SmoothingEnum::FFT || (smoothing == SmoothingEnum::AUTOMATIC && expectFFT));
+
+      std::ostringstream description;
+      description << "Size " << smoothingCase.first << ", variance " << smoothingCase.second << ", smoothing "
+                  << static_cast<int>(smoothing);
+      if (itk::VkTesting::CompareImages(
+            vkFilter->GetOutput(), referenceFilter->GetOutput(), description.str(), 1e-3, 1e-3) != EXIT_SUCCESS)
+      {
+        result = EXIT_FAILURE;
+      }
+    }
+
+    // The device does not generate the padding of a nonzero constant
+    itk::ConstantBoundaryCondition<ImageType> constantCondition;
+    constantCondition.SetConstant(1.0f);
+    vkFilter->SetSmoothing(SmoothingEnum::AUTOMATIC);
+    vkFilter->SetInputBoundaryCondition(&constantCondition);
+    ITK_TEST_EXPECT_TRUE(!vkFilter->GetUseFFT());
+  }
+
+  // Verify default is non-accelerated implementation, then register factory and verify override
+  auto filter = ReferenceFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(filter.GetPointer()) == nullptr);
+  itk::VkDiscreteGaussianImageFilterFactory::RegisterOneFactory();
+  filter = ReferenceFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(filter.GetPointer()) != nullptr);
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkVkFFTConvolutionImageFilter.h"
+#include "itkVkFFTConvolutionImageFilterFactory.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+
+// Verify that VkFFTConvolutionImageFilter computes the same convolution as
+// FFTConvolutionImageFilter for the boundary conditions that it pads on the
+// device, for both output region modes and with and without normalization,
+// and that it overrides FFTConvolutionImageFilter through its factory.
+
+int
+itkVkFFTConvolutionImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ReferenceFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+  using VkFilterType = itk::VkFFTConvolutionImageFilter<ImageType>;
+  using OutputRegionModeEnum = itk::ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion;
+  using BoundaryConditionEnum = VkFilterType::BoundaryConditionEnum;
+
+  typename ImageType::SizeType  size{ { 23, 17 } };
+  typename ImageType::IndexType index{ { 3, -2 } };
+  auto                          image = ImageType::New();
+  image->SetRegions(typename ImageType::RegionType{ index, size });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set(static_cast<PixelType>((5 * pixelIndex[0] + 3 * pixelIndex[1] + 26) % 13) - 6.0f);
+  }
+
+  // An even kernel size exercises the placement of the kernel center
+  typename ImageType::SizeType kernelSize{ { 5, 4 } };
+  auto                         kernel = ImageType::New();
+  kernel->SetRegions(kernelSize);
+  kernel->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(kernel, kernel->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set(static_cast<PixelType>(1 + (pixelIndex[0] + 2 * pixelIndex[1]) % 3));
+  }
+
+  auto vkFilter = VkFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(vkFilter, VkFFTConvolutionImageFilter, FFTConvolutionImageFilter);
+  ITK_TEST_EXPECT_EQUAL(vkFilter->GetVkBoundaryCondition(), BoundaryConditionEnum::ZERO_FLUX_NEUMANN);
+
+  itk::PeriodicBoundaryCondition<ImageType> periodicCondition;
+  itk::ConstantBoundaryCondition<ImageType> zeroCondition;
+  const std::vector<std::pair<itk::ImageBoundaryCondition<ImageType> *, BoundaryConditionEnum>> boundaryConditions{
+    { nullptr, BoundaryConditionEnum::ZERO_FLUX_NEUMANN },
+    { &periodicCondition, BoundaryConditionEnum::PERIODIC },
+    { &zeroCondition, BoundaryConditionEnum::ZERO }
+  };
+
+  int result{ EXIT_SUCCESS };
+  for (const auto & boundaryCondition : boundaryConditions)
+  {
+    for (const auto outputRegionMode : { OutputRegionModeEnum::SAME, OutputRegionModeEnum::VALID })
+    {
+      for (const bool normalize : { true, false })
+      {
+        auto referenceFilter = ReferenceFilterType::New();
+        vkFilter = VkFilterType::New();
+        for (ReferenceFilterType * filter :
+             { referenceFilter.GetPointer(), static_cast<ReferenceFilterType *>(vkFilter.GetPointer()) })
+        {
+          filter->SetInput(image);
+          filter->SetKernelImage(kernel);
+          filter->SetOutputRegionMode(outputRegionMode);
+          filter->SetNormalize(normalize);
+          if (boundaryCondition.first)
+          {
+            filter->SetBoundaryCondition(boundaryCondition.first);
+          }
+        }
+        ITK_TEST_EXPECT_EQUAL(vkFilter->GetVkBoundaryCondition(), boundaryCondition.second);
+        ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+
+        std::ostringstream description;
+        description << boundaryCondition.second << ", " << outputRegionMode << ", normalize " << normalize;
+        if (itk::VkTesting::CompareImages(
+              vkFilter->GetOutput(), referenceFilter->GetOutput(), description.str(), 1e-4, 1e-4) != EXIT_SUCCESS)
+        {
+          result = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // A requested region within the output is cropped out of the padded domain
+  auto referenceFilter = ReferenceFilterType::New();
+  referenceFilter->SetInput(image);
+  referenceFilter->SetKernelImage(kernel);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+  vkFilter = VkFilterType::New();
+  vkFilter->SetInput(image);
+  vkFilter->SetKernelImage(kernel);
+  typename ImageType::RegionType requestedRegion{ { { 7, 1 } }, { { 9, 6 } } };
+  vkFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(vkFilter->GetOutput()->GetBufferedRegion(), requestedRegion);
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(vkFilter->GetOutput(), requestedRegion); !it.IsAtEnd();
+       ++it)
+  {
+    const PixelType expected{ referenceFilter->GetOutput()->GetPixel(it.GetIndex()) };
+    if (std::abs(it.Get() - expected) > 1e-4f * (1.0f + std::abs(expected)))
+    {
+      std::cout << "Requested region mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected
+                << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // Verify default is non-accelerated implementation, then register factory and verify override
+  referenceFilter = ReferenceFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(referenceFilter.GetPointer()) == nullptr);
+  itk::VkFFTConvolutionImageFilterFactory::RegisterOneFactory();
+  referenceFilter = ReferenceFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(referenceFilter.GetPointer()) != nullptr);
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
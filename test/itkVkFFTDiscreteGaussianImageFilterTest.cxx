@@ -0,0 +1,281 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkShrinkImageFilter.h"
+#include "itkVkFFTDiscreteGaussianImageFilter.h"
+#include "itkVkFFTDiscreteGaussianImageFilterFactory.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+
+// Verify that VkFFTDiscreteGaussianImageFilter smooths as the separable
+// DiscreteGaussianImageFilter does, for anisotropic variances with and without
+// the image spacing, for the boundary conditions that it pads on the device, for
+// a requested region within the output, from a shared input spectrum and with
+// shrink factors, that it converts integer input pixels on the device, and that
+// it overrides FFTDiscreteGaussianImageFilter through its factory.
+
+int
+itkVkFFTDiscreteGaussianImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ReferenceFilterType = itk::DiscreteGaussianImageFilter<ImageType>;
+  using FFTFilterType = itk::FFTDiscreteGaussianImageFilter<ImageType>;
+  using VkFilterType = itk::VkFFTDiscreteGaussianImageFilter<ImageType>;
+  using BoundaryConditionEnum = VkFilterType::BoundaryConditionEnum;
+
+  typename ImageType::SizeType  size{ { 37, 29 } };
+  typename ImageType::IndexType index{ { 3, -2 } };
+  auto                          image = ImageType::New();
+  image->SetRegions(typename ImageType::RegionType{ index, size });
+  typename ImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = 0.5;
+  image->SetSpacing(spacing);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set(static_cast<PixelType>((5 * pixelIndex[0] + 3 * pixelIndex[1] + 26) % 13) - 6.0f);
+  }
+
+  auto vkFilter = VkFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(vkFilter, VkFFTDiscreteGaussianImageFilter, FFTDiscreteGaussianImageFilter);
+  ITK_TEST_EXPECT_EQUAL(vkFilter->GetVkBoundaryCondition(), BoundaryConditionEnum::ZERO_FLUX_NEUMANN);
+
+  itk::PeriodicBoundaryCondition<ImageType> periodicCondition;
+  itk::ConstantBoundaryCondition<ImageType> zeroCondition;
+  const std::vector<std::pair<itk::ImageBoundaryCondition<ImageType> *, BoundaryConditionEnum>> boundaryConditions{
+    { nullptr, BoundaryConditionEnum::ZERO_FLUX_NEUMANN },
+    { &periodicCondition, BoundaryConditionEnum::PERIODIC },
+    { &zeroCondition, BoundaryConditionEnum::ZERO }
+  };
+  typename ReferenceFilterType::ArrayType variance;
+  variance[0] = 4.0;
+  variance[1] = 1.5;
+
+  int result{ EXIT_SUCCESS };
+  for (const auto & boundaryCondition : boundaryConditions)
+  {
+    for (const bool useImageSpacing : { false, true })
+    {
+      for (const unsigned int filterDimensionality : { 2u, 1u })
+      {
+        auto referenceFilter = ReferenceFilterType::New();
+        vkFilter = VkFilterType::New();
+        for (ReferenceFilterType * filter :
+             { referenceFilter.GetPointer(), static_cast<ReferenceFilterType *>(vkFilter.GetPointer()) })
+        {
+          filter->SetInput(image);
+          filter->SetVariance(variance);
+          filter->SetUseImageSpacing(useImageSpacing);
+          filter->SetFilterDimensionality(filterDimensionality);
+          filter->SetMaximumError(1e-5);
+          filter->SetMaximumKernelWidth(64);
+          if (boundaryCondition.first)
+          {
+            filter->SetInputBoundaryCondition(boundaryCondition.first);
+          }
+        }
+        ITK_TEST_EXPECT_EQUAL(vkFilter->GetVkBoundaryCondition(), boundaryCondition.second);
+        ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+        ITK_TEST_EXPECT_EQUAL(vkFilter->GetOutput()->GetBufferedRegion(), image->GetLargestPossibleRegion());
+
+        std::ostringstream description;
+        description << boundaryCondition.second << ", spacing " << useImageSpacing << ", dimensionality "
+                    << filterDimensionality;
+        if (itk::VkTesting::CompareImages(vkFilter->GetOutput(),
+                                          referenceFilter->GetOutput(),
+                                          image->GetLargestPossibleRegion(),
+                                          description.str(),
+                                          1e-3,
+                                          1e-3) != EXIT_SUCCESS)
+        {
+          result = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // A requested region within the output is cropped out of the padded domain
+  auto referenceFilter = ReferenceFilterType::New();
+  referenceFilter->SetInput(image);
+  referenceFilter->SetVariance(variance);
+  referenceFilter->SetMaximumError(1e-5);
+  referenceFilter->SetMaximumKernelWidth(64);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+  vkFilter = VkFilterType::New();
+  vkFilter->SetInput(image);
+  vkFilter->SetVariance(variance);
+  vkFilter->SetMaximumError(1e-5);
+  vkFilter->SetMaximumKernelWidth(64);
+  typename ImageType::RegionType requestedRegion{ { { 7, 1 } }, { { 9, 6 } } };
+  vkFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(vkFilter->GetOutput()->GetBufferedRegion(), requestedRegion);
+  if (itk::VkTesting::CompareImages(vkFilter->GetOutput(),
+                                    referenceFilter->GetOutput(),
+                                    requestedRegion,
+                                    "Requested region",
+                                    1e-3,
+                                    1e-3) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // Smoothings with other variances reuse the spectrum of the input padded into a shared domain
+  vkFilter = VkFilterType::New();
+  vkFilter->SetInput(image);
+  vkFilter->SetMaximumError(1e-5);
+  vkFilter->SetMaximumKernelWidth(64);
+  typename ImageType::SizeType minimumPadRadius{ { 24, 24 } };
+  vkFilter->SetMinimumPadRadius(minimumPadRadius);
+  vkFilter->ShareInputSpectrumOn();
+  ITK_TEST_EXPECT_TRUE(vkFilter->GetShareInputSpectrum());
+  for (const double scale : { 1.0, 2.5, 0.5 })
+  {
+    typename ReferenceFilterType::ArrayType sharedVariance;
+    sharedVariance[0] = scale * variance[0];
+    sharedVariance[1] = variance[1] / scale;
+    referenceFilter = ReferenceFilterType::New();
+    referenceFilter->SetInput(image);
+    referenceFilter->SetVariance(sharedVariance);
+    referenceFilter->SetMaximumError(1e-5);
+    referenceFilter->SetMaximumKernelWidth(64);
+    ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+    vkFilter->SetVariance(sharedVariance);
+    vkFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+    ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+
+    std::ostringstream description;
+    description << "Shared spectrum, scale " << scale;
+    if (itk::VkTesting::CompareImages(vkFilter->GetOutput(),
+                                      referenceFilter->GetOutput(),
+                                      requestedRegion,
+                                      description.str(),
+                                      1e-3,
+                                      1e-3) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  vkFilter->ReleaseInputSpectrum();
+
+  // A shrunk output matches the shrunk smoothing at full resolution
+  using ShrinkerType = itk::ShrinkImageFilter<ImageType, ImageType>;
+  typename VkFilterType::ShrinkFactorsType shrinkFactors;
+  shrinkFactors[0] = 2;
+  shrinkFactors[1] = 3;
+  referenceFilter = ReferenceFilterType::New();
+  referenceFilter->SetInput(image);
+  referenceFilter->SetVariance(variance);
+  referenceFilter->SetMaximumError(1e-5);
+  referenceFilter->SetMaximumKernelWidth(64);
+  auto shrinker = ShrinkerType::New();
+  shrinker->SetInput(referenceFilter->GetOutput());
+  shrinker->SetShrinkFactors(shrinkFactors);
+  ITK_TRY_EXPECT_NO_EXCEPTION(shrinker->Update());
+  vkFilter = VkFilterType::New();
+  vkFilter->SetInput(image);
+  vkFilter->SetVariance(variance);
+  vkFilter->SetMaximumError(1e-5);
+  vkFilter->SetMaximumKernelWidth(64);
+  vkFilter->SetShrinkFactors(shrinkFactors);
+  ITK_TEST_SET_GET_VALUE(vkFilter->GetShrinkFactors(), shrinkFactors);
+  ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(vkFilter->GetOutput()->GetLargestPossibleRegion(),
+                        shrinker->GetOutput()->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(vkFilter->GetOutput()->GetOrigin(), shrinker->GetOutput()->GetOrigin());
+  if (itk::VkTesting::CompareImages(vkFilter->GetOutput(),
+                                    shrinker->GetOutput(),
+                                    shrinker->GetOutput()->GetLargestPossibleRegion(),
+                                    "Shrunk",
+                                    1e-3,
+                                    1e-3) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // Integer pixels converted on the device smooth as the same pixels cast on the host
+  using ShortImageType = itk::Image<short, Dimension>;
+  using ShortVkFilterType = itk::VkFFTDiscreteGaussianImageFilter<ShortImageType, ImageType>;
+  auto shortImage = ShortImageType::New();
+  shortImage->CopyInformation(image);
+  shortImage->SetRegions(image->GetLargestPossibleRegion());
+  shortImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ShortImageType> it(shortImage, shortImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    it.Set(static_cast<short>(1000.0f * image->GetPixel(it.GetIndex())));
+    image->SetPixel(it.GetIndex(), static_cast<PixelType>(it.Get()));
+  }
+  image->Modified();
+  auto shortVkFilter = ShortVkFilterType::New();
+  shortVkFilter->SetInput(shortImage);
+  shortVkFilter->SetVariance(variance);
+  shortVkFilter->SetMaximumError(1e-5);
+  shortVkFilter->SetMaximumKernelWidth(64);
+  ITK_TRY_EXPECT_NO_EXCEPTION(shortVkFilter->Update());
+  vkFilter = VkFilterType::New();
+  vkFilter->SetInput(image);
+  vkFilter->SetVariance(variance);
+  vkFilter->SetMaximumError(1e-5);
+  vkFilter->SetMaximumKernelWidth(64);
+  ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+  if (itk::VkTesting::CompareImages(shortVkFilter->GetOutput(),
+                                    vkFilter->GetOutput(),
+                                    image->GetLargestPossibleRegion(),
+                                    "Short input",
+                                    1e-3,
+                                    1e-3) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // Verify default is non-accelerated implementation, then register factory and verify override
+  auto fftFilter = FFTFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(fftFilter.GetPointer()) == nullptr);
+  itk::VkFFTDiscreteGaussianImageFilterFactory::RegisterOneFactory();
+  fftFilter = FFTFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(fftFilter.GetPointer()) != nullptr);
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,198 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTNormalizedCorrelationImageFilter.h"
+#include "itkMaskedFFTNormalizedCorrelationImageFilter.h"
+#include "itkVkFFTNormalizedCorrelationImageFilter.h"
+#include "itkVkFFTNormalizedCorrelationImageFilterFactory.h"
+#include "itkVkMaskedFFTNormalizedCorrelationImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+
+// Verify that VkMaskedFFTNormalizedCorrelationImageFilter and
+// VkFFTNormalizedCorrelationImageFilter compute the same correlation as
+// MaskedFFTNormalizedCorrelationImageFilter and FFTNormalizedCorrelationImageFilter,
+// with and without masks and overlap requirements, and that they override them
+// through their factory.
+
+int
+itkVkFFTNormalizedCorrelationImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using MaskImageType = itk::Image<unsigned char, Dimension>;
+  using ReferenceFilterType = itk::FFTNormalizedCorrelationImageFilter<ImageType, ImageType>;
+  using VkFilterType = itk::VkFFTNormalizedCorrelationImageFilter<ImageType, ImageType>;
+  using ReferenceMaskedFilterType = itk::MaskedFFTNormalizedCorrelationImageFilter<ImageType, ImageType>;
+  using VkMaskedFilterType = itk::VkMaskedFFTNormalizedCorrelationImageFilter<ImageType, ImageType>;
+
+  // The moving image is a shifted, scaled and offset part of the fixed image, so that the
+  // correlation peaks at one
+  typename ImageType::SizeType fixedSize{ { 29, 21 } };
+  auto                         fixedImage = ImageType::New();
+  fixedImage->SetRegions(fixedSize);
+  fixedImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(fixedImage, fixedImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set(static_cast<PixelType>((7 * pixelIndex[0] + 3 * pixelIndex[1] * pixelIndex[1] + 5) % 17));
+  }
+
+  typename ImageType::SizeType movingSize{ { 9, 8 } };
+  auto                         movingImage = ImageType::New();
+  movingImage->SetRegions(movingSize);
+  movingImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(movingImage, movingImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    typename ImageType::IndexType fixedIndex{ it.GetIndex() };
+    fixedIndex[0] += 11;
+    fixedIndex[1] += 6;
+    it.Set(2.0f * fixedImage->GetPixel(fixedIndex) + 3.0f);
+  }
+
+  // Masks that leave out a block of the fixed image and a corner of the moving image
+  auto fixedMask = MaskImageType::New();
+  fixedMask->SetRegions(fixedSize);
+  fixedMask->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<MaskImageType> it(fixedMask, fixedMask->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set((pixelIndex[0] > 20 && pixelIndex[1] < 5) ? 0 : 255);
+  }
+  auto movingMask = MaskImageType::New();
+  movingMask->SetRegions(movingSize);
+  movingMask->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<MaskImageType> it(movingMask, movingMask->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set((pixelIndex[0] + pixelIndex[1] < 3) ? 0 : 1);
+  }
+
+  auto vkFilter = VkFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    vkFilter, VkFFTNormalizedCorrelationImageFilter, FFTNormalizedCorrelationImageFilter);
+  auto vkMaskedFilter = VkMaskedFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    vkMaskedFilter, VkMaskedFFTNormalizedCorrelationImageFilter, MaskedFFTNormalizedCorrelationImageFilter);
+
+  int result{ EXIT_SUCCESS };
+  for (const double requiredFraction : { 0.0, 0.5 })
+  {
+    // Without masks
+    auto referenceFilter = ReferenceFilterType::New();
+    vkFilter = VkFilterType::New();
+    for (ReferenceFilterType * filter :
+         { referenceFilter.GetPointer(), static_cast<ReferenceFilterType *>(vkFilter.GetPointer()) })
+    {
+      filter->SetFixedImage(fixedImage);
+      filter->SetMovingImage(movingImage);
+      filter->SetRequiredFractionOfOverlappingPixels(requiredFraction);
+    }
+    ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+    ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+    std::ostringstream description;
+    description << "unmasked, required fraction " << requiredFraction;
+    if (itk::VkTesting::CompareImages(
+          vkFilter->GetOutput(), referenceFilter->GetOutput(), description.str(), 1e-3) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+
+    // With either or both masks
+    for (const bool useFixedMask : { true, false })
+    {
+      for (const bool useMovingMask : { true, false })
+      {
+        auto referenceMaskedFilter = ReferenceMaskedFilterType::New();
+        vkMaskedFilter = VkMaskedFilterType::New();
+        for (ReferenceMaskedFilterType * filter :
+             { referenceMaskedFilter.GetPointer(),
+               static_cast<ReferenceMaskedFilterType *>(vkMaskedFilter.GetPointer()) })
+        {
+          filter->SetFixedImage(fixedImage);
+          filter->SetMovingImage(movingImage);
+          if (useFixedMask)
+          {
+            filter->SetFixedImageMask(fixedMask);
+          }
+          if (useMovingMask)
+          {
+            filter->SetMovingImageMask(movingMask);
+          }
+          filter->SetRequiredNumberOfOverlappingPixels(10);
+          filter->SetRequiredFractionOfOverlappingPixels(requiredFraction);
+        }
+        ITK_TRY_EXPECT_NO_EXCEPTION(referenceMaskedFilter->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(vkMaskedFilter->Update());
+        std::ostringstream maskedDescription;
+        maskedDescription << "fixed mask " << useFixedMask << ", moving mask " << useMovingMask
+                          << ", required fraction " << requiredFraction;
+        if (itk::VkTesting::CompareImages(vkMaskedFilter->GetOutput(),
+                                          referenceMaskedFilter->GetOutput(),
+                                          maskedDescription.str(),
+                                          1e-3) != EXIT_SUCCESS)
+        {
+          result = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // The moving image matches the fixed image where it was cut out
+  typename ImageType::IndexType peakIndex{ { 11 + 8, 6 + 7 } };
+  ITK_TEST_EXPECT_TRUE(std::abs(vkFilter->GetOutput()->GetPixel(peakIndex) - 1.0f) < 1e-3f);
+
+  // Verify default is non-accelerated implementation, then register factory and verify override
+  auto referenceFilter = ReferenceFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(referenceFilter.GetPointer()) == nullptr);
+  auto referenceMaskedFilter = ReferenceMaskedFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkMaskedFilterType *>(referenceMaskedFilter.GetPointer()) == nullptr);
+  itk::VkFFTNormalizedCorrelationImageFilterFactory::RegisterOneFactory();
+  referenceFilter = ReferenceFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkFilterType *>(referenceFilter.GetPointer()) != nullptr);
+  referenceMaskedFilter = ReferenceMaskedFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkMaskedFilterType *>(referenceMaskedFilter.GetPointer()) != nullptr);
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
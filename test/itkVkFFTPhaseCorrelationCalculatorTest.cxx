@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkFFTPhaseCorrelationCalculator.h"
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Verify that VkFFTPhaseCorrelationCalculator recovers integer shifts of an image,
+// circular and with content leaving the image, and a subpixel shift of a smooth
+// image, with either sign and with images that are padded to a size that VkFFT
+// transforms.
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeBlobImage(const typename TImage::SizeType & size, const itk::Vector<double, TImage::ImageDimension> & shift)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    // Two Gaussian blobs of different widths
+    double first{ 0.0 };
+    double second{ 0.0 };
+    for (unsigned int dim{ 0 }; dim < TImage::ImageDimension; ++dim)
+    {
+      const double x{ it.GetIndex()[dim] - shift[dim] };
+      first += (x - 0.4 * size[dim]) * (x - 0.4 * size[dim]) / 8.0;
+      second += (x - 0.6 * size[dim] - 2.0) * (x - 0.6 * size[dim] - 2.0) / 18.0;
+    }
+    it.Set(static_cast<typename TImage::PixelType>(std::exp(-first) + 0.5 * std::exp(-second)));
+  }
+  return image;
+}
+
+template <typename TCalculator>
+int
+CheckShift(TCalculator * calculator, const typename TCalculator::ShiftType & expected, double tolerance)
+{
+  ITK_TRY_EXPECT_NO_EXCEPTION(calculator->Compute());
+  const auto & shift = calculator->GetShift();
+  for (unsigned int dim{ 0 }; dim < TCalculator::ImageDimension; ++dim)
+  {
+    if (std::abs(shift[dim] - expected[dim]) > tolerance)
+    {
+      std::cout << "Shift " << shift << " != " << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!(calculator->GetPeakValue() > 0.0 && calculator->GetPeakValue() <= 1.0 + 1e-6))
+  {
+    std::cout << "Peak value " << calculator->GetPeakValue() << " out of range" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkVkFFTPhaseCorrelationCalculatorTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using CalculatorType = itk::VkFFTPhaseCorrelationCalculator<ImageType>;
+  using ShiftType = CalculatorType::ShiftType;
+
+  auto calculator = CalculatorType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(calculator, VkFFTPhaseCorrelationCalculator, Object);
+  ITK_TEST_EXPECT_EQUAL(calculator->GetBoundaryCondition(), CalculatorType::BoundaryConditionEnum::ZERO);
+
+  int result{ EXIT_SUCCESS };
+
+  // A circular shift of an image of a size that VkFFT transforms yields an exact peak
+  typename ImageType::SizeType size{ { 48, 40 } };
+  auto                         fixedImage = MakeBlobImage<ImageType>(size, ShiftType{});
+  auto                         movingImage = ImageType::New();
+  movingImage->SetRegions(size);
+  movingImage->Allocate();
+  const ShiftType circularShift{ { 7.0, -5.0 } };
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(movingImage, movingImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    typename ImageType::IndexType fixedIndex;
+    for (unsigned int dim{ 0 }; dim < Dimension; ++dim)
+    {
+      const auto extent = static_cast<itk::IndexValueType>(size[dim]);
+      fixedIndex[dim] = (it.GetIndex()[dim] - static_cast<itk::IndexValueType>(circularShift[dim]) + extent) % extent;
+    }
+    it.Set(fixedImage->GetPixel(fixedIndex));
+  }
+  calculator->SetFixedImage(fixedImage);
+  calculator->SetMovingImage(movingImage);
+  if (CheckShift(calculator.GetPointer(), circularShift, 1e-3) != EXIT_SUCCESS ||
+      std::abs(calculator->GetPeakValue() - 1.0) > 1e-3)
+  {
+    std::cout << "Circular shift failed" << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  // Swapping the images reverses the shift
+  calculator->SetFixedImage(movingImage);
+  calculator->SetMovingImage(fixedImage);
+  if (CheckShift(calculator.GetPointer(), -circularShift, 1e-3) != EXIT_SUCCESS)
+  {
+    std::cout << "Reversed circular shift failed" << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  // Blobs moved within an image that is padded with zeros, by whole and fractional pixels
+  typename ImageType::SizeType paddedSize{ { 53, 37 } };
+  for (const ShiftType & blobShift : { ShiftType{ { 4.0, 3.0 } }, ShiftType{ { -2.3, 1.6 } } })
+  {
+    calculator->SetFixedImage(MakeBlobImage<ImageType>(paddedSize, ShiftType{}));
+    calculator->SetMovingImage(MakeBlobImage<ImageType>(paddedSize, blobShift));
+    if (CheckShift(calculator.GetPointer(), blobShift, 0.35) != EXIT_SUCCESS)
+    {
+      std::cout << "Shift of blobs " << blobShift << " failed" << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkFFTTemplateMatchingImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <numeric>
+
+// Verify that VkFFTTemplateMatchingImageFilter computes the normalized
+// cross-correlation maps of an image with a batch of templates, and their
+// peaks, as a direct computation in the spatial domain does, with and without
+// downloading the maps. Each template is planted in the image, where its map
+// must peak at one.
+
+int
+itkVkFFTTemplateMatchingImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using FilterType = itk::VkFFTTemplateMatchingImageFilter<ImageType>;
+
+  constexpr double valueTolerance{ 1e-3 };
+
+  // Pseudo-random samples, so that the peaks are unique
+  uint32_t   state{ 12345 };
+  const auto makeImage = [&state](typename ImageType::SizeType size) {
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      state = state * 1664525u + 1013904223u;
+      it.Set(static_cast<PixelType>(state >> 8) / static_cast<PixelType>(1 << 24) - 0.5f);
+    }
+    return image;
+  };
+
+  auto                                  image = makeImage({ { 40, 30 } });
+  const std::vector<ImageType::Pointer> templates{ makeImage({ { 7, 5 } }),
+                                                   makeImage({ { 7, 5 } }),
+                                                   makeImage({ { 7, 5 } }) };
+
+  // Plant each template centered at its own location
+  const typename ImageType::RegionType &  region{ image->GetLargestPossibleRegion() };
+  const std::vector<ImageType::IndexType> locations{ { { 8, 6 } }, { { 20, 15 } }, { { 31, 22 } } };
+  for (unsigned int i{ 0 }; i < templates.size(); ++i)
+  {
+    const typename ImageType::SizeType & templateSize{ templates[i]->GetLargestPossibleRegion().GetSize() };
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> tt(templates[i], templates[i]->GetLargestPossibleRegion());
+         !tt.IsAtEnd();
+         ++tt)
+    {
+      typename ImageType::IndexType index{ locations[i] };
+      for (unsigned int dim{ 0 }; dim < Dimension; ++dim)
+      {
+        index[dim] += tt.GetIndex()[dim] - static_cast<itk::IndexValueType>(templateSize[dim] / 2);
+      }
+      image->SetPixel(index, tt.Get());
+    }
+  }
+
+  // Normalized correlation maps computed in the spatial domain, with the image zero outside
+  std::vector<ImageType::Pointer> references;
+  for (const auto & templateImage : templates)
+  {
+    const typename ImageType::SizeType & templateSize{ templateImage->GetLargestPossibleRegion().GetSize() };
+    auto                                 reference = ImageType::New();
+    reference->SetRegions(region);
+    reference->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(reference, region); !it.IsAtEnd(); ++it)
+    {
+      std::vector<double> window;
+      std::vector<double> values;
+      for (itk::ImageRegionConstIteratorWithIndex<ImageType> tt(templateImage,
+                                                                templateImage->GetLargestPossibleRegion());
+           !tt.IsAtEnd();
+           ++tt)
+      {
+        typename ImageType::IndexType index{ it.GetIndex() };
+        for (unsigned int dim{ 0 }; dim < Dimension; ++dim)
+        {
+          index[dim] += tt.GetIndex()[dim] - static_cast<itk::IndexValueType>(templateSize[dim] / 2);
+        }
+        window.push_back(region.IsInside(index) ? static_cast<double>(image->GetPixel(index)) : 0.0);
+        values.push_back(static_cast<double>(tt.Get()));
+      }
+      const double windowMean{ std::accumulate(window.begin(), window.end(), 0.0) / window.size() };
+      const double valueMean{ std::accumulate(values.begin(), values.end(), 0.0) / values.size() };
+      double       product{ 0.0 };
+      double       windowSquares{ 0.0 };
+      double       valueSquares{ 0.0 };
+      for (size_t u{ 0 }; u < window.size(); ++u)
+      {
+        product += (window[u] - windowMean) * (values[u] - valueMean);
+        windowSquares += (window[u] - windowMean) * (window[u] - windowMean);
+        valueSquares += (values[u] - valueMean) * (values[u] - valueMean);
+      }
+      const double norms{ std::sqrt(windowSquares * valueSquares) };
+      it.Set(static_cast<PixelType>(norms > 0.0 ? product / norms : 0.0));
+    }
+    references.push_back(reference);
+  }
+
+  auto filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, VkFFTTemplateMatchingImageFilter, ImageToImageFilter);
+  ITK_TEST_SET_GET_BOOLEAN(filter, ComputeCorrelationMaps, true);
+  filter->SetInput(image);
+  for (unsigned int i{ 0 }; i < templates.size(); ++i)
+  {
+    filter->SetTemplateImage(i, templates[i]);
+  }
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfTemplateImages(), templates.size());
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfIndexedOutputs(), templates.size());
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  bool testPassed{ true };
+  for (unsigned int i{ 0 }; i < templates.size(); ++i)
+  {
+    typename ImageType::IndexType peakIndex{ region.GetIndex() };
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(references[i], region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() > references[i]->GetPixel(peakIndex))
+      {
+        peakIndex = it.GetIndex();
+      }
+      const double value{ filter->GetOutput(i)->GetPixel(it.GetIndex()) };
+      if (std::abs(value - it.Get()) > valueTolerance)
+      {
+        std::cout << "Template " << i << " mismatch at " << it.GetIndex() << ": " << value << " != " << it.Get()
+                  << std::endl;
+        testPassed = false;
+      }
+    }
+    ITK_TEST_EXPECT_EQUAL(peakIndex, locations[i]);
+    ITK_TEST_EXPECT_EQUAL(filter->GetPeakIndex(i), peakIndex);
+    ITK_TEST_EXPECT_TRUE(std::abs(filter->GetPeakValue(i) - references[i]->GetPixel(peakIndex)) < valueTolerance);
+    ITK_TEST_EXPECT_TRUE(std::abs(filter->GetPeakValue(i) - 1.0) < valueTolerance);
+  }
+
+  // Only the peaks are computed without the maps
+  auto peakFilter = FilterType::New();
+  peakFilter->SetInput(image);
+  for (unsigned int i{ 0 }; i < templates.size(); ++i)
+  {
+    peakFilter->SetTemplateImage(i, templates[i]);
+  }
+  peakFilter->ComputeCorrelationMapsOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(peakFilter->Update());
+  for (unsigned int i{ 0 }; i < templates.size(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(peakFilter->GetPeakIndex(i), filter->GetPeakIndex(i));
+    ITK_TEST_EXPECT_TRUE(std::abs(peakFilter->GetPeakValue(i) - filter->GetPeakValue(i)) < valueTolerance);
+  }
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
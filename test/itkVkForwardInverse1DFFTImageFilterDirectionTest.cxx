@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkForward1DFFTImageFilter.h"
+#include "itkVkInverse1DFFTImageFilter.h"
+#include "itkVnlForward1DFFTImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Verify 1D transforms along each direction of a volume, including the
+// directions that are computed as batches of real-to-complex lines, with and
+// without splitting the lines between the device and the host backend.
+
+int
+itkVkForwardInverse1DFFTImageFilterDirectionTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 3 };
+  using RealType = float;
+  using RealImageType = itk::Image<RealType, Dimension>;
+  using ComplexImageType = itk::Image<std::complex<RealType>, Dimension>;
+  using ForwardFilterType = itk::VkForward1DFFTImageFilter<RealImageType, ComplexImageType>;
+  using InverseFilterType = itk::VkInverse1DFFTImageFilter<ComplexImageType, RealImageType>;
+  using ReferenceFilterType = itk::VnlForward1DFFTImageFilter<RealImageType, ComplexImageType>;
+
+  constexpr float valueTolerance{ 1e-3f };
+
+  // Odd and even extents so that both parities of the half spectrum are covered
+  const typename RealImageType::SizeType size{ { 6, 5, 8 } };
+
+  auto realImage = RealImageType::New();
+  realImage->SetRegions(size);
+  realImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<RealImageType> it(realImage, realImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<RealType>((3 * index[0] + 7 * index[1] + 5 * index[2]) % 11) - 5.0f);
+  }
+
+  bool testPassed{ true };
+  for (unsigned int direction{ 0 }; direction < Dimension; ++direction)
+  {
+    for (const bool split : { false, true })
+    {
+      auto referenceFilter = ReferenceFilterType::New();
+      referenceFilter->SetInput(realImage);
+      referenceFilter->SetDirection(direction);
+      ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+      auto forwardFilter = ForwardFilterType::New();
+      ITK_TEST_EXPECT_TRUE(!forwardFilter->GetUseHostBatchSplit());
+      forwardFilter->SetInput(realImage);
+      forwardFilter->SetDirection(direction);
+      forwardFilter->SetUseHostBatchSplit(split);
+      ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+      // A second update splits the lines by the measured throughputs
+      forwardFilter->Modified();
+      ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+      ITK_TEST_EXPECT_EQUAL(forwardFilter->GetBatchThroughput().host > 0.0, split);
+      ITK_TEST_EXPECT_EQUAL(forwardFilter->GetBatchThroughput().device > 0.0, split);
+
+      for (itk::ImageRegionConstIteratorWithIndex<ComplexImageType> it(
+             forwardFilter->GetOutput(), forwardFilter->GetOutput()->GetLargestPossibleRegion());
+           !it.IsAtEnd();
+           ++it)
+      {
+        const auto expected = referenceFilter->GetOutput()->GetPixel(it.GetIndex());
+        if (std::abs(it.Get() - expected) > valueTolerance)
+        {
+          std::cout << "Forward mismatch along " << direction << (split ? " split" : "") << " at " << it.GetIndex()
+                    << ": " << it.Get() << " != " << expected << std::endl;
+          testPassed = false;
+        }
+      }
+
+      auto inverseFilter = InverseFilterType::New();
+      inverseFilter->SetInput(forwardFilter->GetOutput());
+      inverseFilter->SetDirection(direction);
+      inverseFilter->SetUseHostBatchSplit(split);
+      ITK_TRY_EXPECT_NO_EXCEPTION(inverseFilter->Update());
+      ITK_TEST_EXPECT_EQUAL(inverseFilter->GetBatchThroughput().host > 0.0, split);
+
+      for (itk::ImageRegionConstIteratorWithIndex<RealImageType> it(
+             inverseFilter->GetOutput(), inverseFilter->GetOutput()->GetLargestPossibleRegion());
+           !it.IsAtEnd();
+           ++it)
+      {
+        const RealType expected{ realImage->GetPixel(it.GetIndex()) };
+        if (std::abs(it.Get() - expected) > valueTolerance)
+        {
+          std::cout << "Inverse mismatch along " << direction << (split ? " split" : "") << " at " << it.GetIndex()
+                    << ": " << it.Get() << " != " << expected << std::endl;
+          testPassed = false;
+        }
+      }
+    }
+  }
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGPUImage.h"
+#include "itkVkDeviceContext.h"
+#include "itkVkForwardFFTImageFilter.h"
+#include "itkVkGlobalConfiguration.h"
+#include "itkVkInverseFFTImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Verify that a forward and an inverse transform of GPUImages compute the
+// original image, and that they leave their results in the OpenCL buffers
+// when the Vk filters share the context of ITK's GPU module.
+
+int
+itkVkGPUImageTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using RealType = float;
+  using RealImageType = itk::GPUImage<RealType, Dimension>;
+  using ComplexImageType = itk::GPUImage<std::complex<RealType>, Dimension>;
+
+  constexpr float valueTolerance{ 1e-3f };
+
+  typename RealImageType::SizeType size{ { 16, 12 } };
+  auto                             realImage = RealImageType::New();
+  realImage->SetRegions(size);
+  realImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<RealImageType> it(realImage, realImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<RealType>((5 * index[0] + 3 * index[1]) % 13) - 6.0f);
+  }
+
+  itk::VkDeviceContext::Pointer context;
+  if (itk::VkDeviceContext::GetInstance(itk::VkGlobalConfiguration::GetDeviceID(), context) != VKFFT_SUCCESS)
+  {
+    std::cout << "Test failed: no device context." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const bool sharingGPUContext{ context->IsSharingGPUContext() };
+  std::cout << "Sharing the context of ITK's GPU module: " << sharingGPUContext << std::endl;
+
+  auto forwardFilter = itk::VkForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  forwardFilter->SetInput(realImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(forwardFilter->GetOutput()->GetGPUDataManager()->IsCPUBufferDirty(), sharingGPUContext);
+
+  auto inverseFilter = itk::VkInverseFFTImageFilter<ComplexImageType, RealImageType>::New();
+  inverseFilter->SetInput(forwardFilter->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(inverseFilter->Update());
+  RealImageType * const roundTrip{ inverseFilter->GetOutput() };
+  ITK_TEST_EXPECT_EQUAL(roundTrip->GetGPUDataManager()->IsCPUBufferDirty(), sharingGPUContext);
+
+  // Iterating over the result brings its host buffer up to date
+  bool testPassed{ true };
+  for (itk::ImageRegionConstIteratorWithIndex<RealImageType> it(roundTrip, roundTrip->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const RealType expected{ realImage->GetPixel(it.GetIndex()) };
+    if (std::abs(it.Get() - expected) > valueTolerance)
+    {
+      std::cout << "Round trip mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected << std::endl;
+      testPassed = false;
+    }
+  }
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -16,6 +16,7 @@
  *
  *=========================================================================*/
 
+#include <cmath>
 #include <complex>
 
 #include "itkVkComplexToComplex1DFFTImageFilter.h"
@@ -27,8 +28,12 @@
 #include "itkVkInverseFFTImageFilter.h"
 #include "itkVkRealToHalfHermitianForwardFFTImageFilter.h"
 
+#include "itkVkFFTBackendDispatch.h"
 #include "itkVkGlobalConfiguration.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
 #include "itkTestingMacros.h"
+#include "itkVnlForwardFFTImageFilter.h"
 
 // Verify FFT interface classes can be instantiated with
 // VkFFT backends through ITK object factory override methods
@@ -69,6 +74,74 @@ itkVkGlobalConfigurationTest(int, char *[])
   using RealImageType = itk::Image<float, 2>;
   using ComplexImageType = itk::Image<std::complex<float>, 2>;
 
+  itk::VkGlobalConfiguration::SetDeviceResidencyBudget(1 << 20);
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetDeviceResidencyBudget(), 1 << 20);
+  itk::VkGlobalConfiguration::SetDeviceResidencyBudget(0);
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetDeviceResidencyBudget(), 0);
+  itk::VkGlobalConfiguration::SetKernelSpectrumCacheBudget(1 << 20);
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetKernelSpectrumCacheBudget(), 1 << 20);
+  itk::VkGlobalConfiguration::SetKernelSpectrumCacheBudget(0);
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetKernelSpectrumCacheBudget(), 0);
+
+  // Verify the crossover below which small transforms leave the device
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetDefaultFFTDeviceMinimumSamples(), 0);
+  itk::VkGlobalConfiguration::SetDefaultFFTDeviceMinimumSamples(1 << 10);
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetDefaultFFTDeviceMinimumSamples(), 1 << 10);
+  ITK_TEST_SET_GET_VALUE(
+    itk::VkGlobalConfiguration::GetFFTDeviceMinimumSamples(0, "VkForwardFFTImageFilter", sizeof(float)), 1 << 10);
+  itk::VkGlobalConfiguration::SetFFTDeviceMinimumSamples(0, "VkForwardFFTImageFilter", sizeof(float), 1 << 12);
+  ITK_TEST_SET_GET_VALUE(
+    itk::VkGlobalConfiguration::GetFFTDeviceMinimumSamples(0, "VkForwardFFTImageFilter", sizeof(float)), 1 << 12);
+  ITK_TEST_SET_GET_VALUE(
+    itk::VkGlobalConfiguration::GetFFTDeviceMinimumSamples(0, "VkForwardFFTImageFilter", sizeof(double)), 1 << 10);
+  ITK_TEST_SET_GET_VALUE(
+    itk::VkGlobalConfiguration::GetFFTDeviceMinimumSamples(1, "VkForwardFFTImageFilter", sizeof(float)), 1 << 10);
+
+  // A transform below the crossover is computed by the next registered backend
+  {
+    auto image = RealImageType::New();
+    image->SetRegions(RealImageType::SizeType{ { 8, 8 } });
+    image->Allocate();
+    float value{ 0.0f };
+    for (itk::ImageRegionIterator<RealImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(value);
+      value = std::fmod(value + 3.5f, 11.0f);
+    }
+
+    using VkForwardFilterType = itk::VkForwardFFTImageFilter<RealImageType, ComplexImageType>;
+    auto hostBackend = itk::VkFFTBackendDispatch<VkForwardFilterType>::CreateHostBackend();
+    ITK_TEST_EXPECT_TRUE(hostBackend.IsNotNull());
+    ITK_TEST_EXPECT_TRUE(dynamic_cast<VkForwardFilterType *>(hostBackend.GetPointer()) == nullptr);
+
+    auto vkFilter = VkForwardFilterType::New();
+    vkFilter->SetInput(image);
+    ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+    ITK_TEST_EXPECT_TRUE(vkFilter->GetGeneratedDataOnHost());
+    auto vnlFilter = itk::VnlForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+    vnlFilter->SetInput(image);
+    ITK_TRY_EXPECT_NO_EXCEPTION(vnlFilter->Update());
+
+    itk::ImageRegionConstIterator<ComplexImageType> vnlIt(vnlFilter->GetOutput(),
+                                                          vnlFilter->GetOutput()->GetLargestPossibleRegion());
+    for (itk::ImageRegionConstIterator<ComplexImageType> vkIt(vkFilter->GetOutput(),
+                                                              vkFilter->GetOutput()->GetLargestPossibleRegion());
+         !vkIt.IsAtEnd();
+         ++vkIt, ++vnlIt)
+    {
+      ITK_TEST_EXPECT_TRUE(std::abs(vkIt.Get() - vnlIt.Get()) < 1e-4f * (1.0f + std::abs(vnlIt.Get())));
+    }
+
+    // Without a crossover the same transform runs on the device
+    itk::VkGlobalConfiguration::RemoveFFTDeviceMinimumSamples();
+    itk::VkGlobalConfiguration::SetDefaultFFTDeviceMinimumSamples(0);
+    ITK_TEST_SET_GET_VALUE(
+      itk::VkGlobalConfiguration::GetFFTDeviceMinimumSamples(0, "VkForwardFFTImageFilter", sizeof(float)), 0);
+    vkFilter->Modified();
+    ITK_TRY_EXPECT_NO_EXCEPTION(vkFilter->Update());
+    ITK_TEST_EXPECT_TRUE(!vkFilter->GetGeneratedDataOnHost());
+  }
+
   itkVkGlobalConfigurationTestProcedure<itk::VkComplexToComplex1DFFTImageFilter<ComplexImageType, ComplexImageType>>();
   itkVkGlobalConfigurationTestProcedure<itk::VkComplexToComplexFFTImageFilter<ComplexImageType, ComplexImageType>>();
   itkVkGlobalConfigurationTestProcedure<itk::VkForward1DFFTImageFilter<RealImageType, ComplexImageType>>();
@@ -0,0 +1,200 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMultiplyImageFilter.h"
+#include "itkVkForwardFFTImageFilter.h"
+#include "itkVkImage.h"
+#include "itkVkInverseFFTImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Verify that a forward and an inverse transform chained through VkImages hand
+// the spectrum over in device memory, and compute the same values as a chain
+// through images in host memory, also with an in-place filter in host memory
+// or writes through an iterator between them.
+
+int
+itkVkImageTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using RealType = float;
+  using ComplexType = std::complex<RealType>;
+  using RealImageType = itk::Image<RealType, Dimension>;
+  using ComplexImageType = itk::Image<ComplexType, Dimension>;
+  using VkRealImageType = itk::VkImage<RealType, Dimension>;
+  using VkComplexImageType = itk::VkImage<ComplexType, Dimension>;
+
+  constexpr float valueTolerance{ 1e-3f };
+
+  typename RealImageType::SizeType size{ { 16, 12 } };
+  auto                             realImage = VkRealImageType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(realImage, VkImage, Image);
+  realImage->SetRegions(size);
+  realImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<VkRealImageType> it(realImage, realImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<RealType>((5 * index[0] + 3 * index[1]) % 13) - 6.0f);
+  }
+  ITK_TEST_EXPECT_TRUE(realImage->IsHostBufferCurrent());
+  ITK_TEST_EXPECT_TRUE(realImage->GetDeviceBuffer() == nullptr);
+
+  // Reference spectrum, computed in host memory
+  auto hostImage = RealImageType::New();
+  hostImage->Graft(realImage);
+  auto hostForwardFilter = itk::VkForwardFFTImageFilter<RealImageType, ComplexImageType>::New();
+  hostForwardFilter->SetInput(hostImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(hostForwardFilter->Update());
+
+  // The spectrum stays in device memory ...
+  auto forwardFilter = itk::VkForwardFFTImageFilter<VkRealImageType, VkComplexImageType>::New();
+  forwardFilter->SetInput(realImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+  VkComplexImageType * const spectrum{ forwardFilter->GetOutput() };
+  ITK_TEST_EXPECT_TRUE(!spectrum->IsHostBufferCurrent());
+  ITK_TEST_EXPECT_TRUE(spectrum->GetDeviceBuffer(forwardFilter->GetDeviceID()) != nullptr);
+
+  // ... and is read from there by the inverse transform
+  auto inverseFilter = itk::VkInverseFFTImageFilter<VkComplexImageType, VkRealImageType>::New();
+  inverseFilter->SetInput(spectrum);
+  ITK_TRY_EXPECT_NO_EXCEPTION(inverseFilter->Update());
+  ITK_TEST_EXPECT_TRUE(!spectrum->IsHostBufferCurrent());
+  VkRealImageType * const roundTrip{ inverseFilter->GetOutput() };
+  ITK_TEST_EXPECT_TRUE(!roundTrip->IsHostBufferCurrent());
+
+  // Iterating over the images brings their host buffers up to date
+  bool testPassed{ true };
+  for (itk::ImageRegionConstIteratorWithIndex<VkComplexImageType> it(spectrum, spectrum->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const ComplexType expected{ hostForwardFilter->GetOutput()->GetPixel(it.GetIndex()) };
+    if (std::abs(it.Get() - expected) > valueTolerance)
+    {
+      std::cout << "Spectrum mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected << std::endl;
+      testPassed = false;
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(spectrum->IsHostBufferCurrent());
+  ITK_TEST_EXPECT_TRUE(spectrum->GetDeviceBuffer() != nullptr);
+
+  for (itk::ImageRegionConstIteratorWithIndex<VkRealImageType> it(roundTrip, roundTrip->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const RealType expected{ realImage->GetPixel(it.GetIndex()) };
+    if (std::abs(it.Get() - expected) > valueTolerance)
+    {
+      std::cout << "Round trip mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected << std::endl;
+      testPassed = false;
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(roundTrip->IsHostBufferCurrent());
+
+  // Writing to the host buffer releases the device copy
+  roundTrip->FillBuffer(0.0f);
+  ITK_TEST_EXPECT_TRUE(roundTrip->GetDeviceBuffer() == nullptr);
+
+  // An in-place filter that grafts the spectrum and writes it in host memory releases the
+  // device copy, so that the inverse transform reads the scaled spectrum
+  forwardFilter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+  ITK_TEST_EXPECT_TRUE(spectrum->GetDeviceBuffer() != nullptr);
+  auto multiplyFilter = itk::MultiplyImageFilter<VkComplexImageType>::New();
+  multiplyFilter->SetInput(spectrum);
+  multiplyFilter->SetConstant(ComplexType(2.0f));
+  multiplyFilter->InPlaceOn();
+  auto scaledInverseFilter = itk::VkInverseFFTImageFilter<VkComplexImageType, VkRealImageType>::New();
+  scaledInverseFilter->SetInput(multiplyFilter->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(scaledInverseFilter->Update());
+  ITK_TEST_EXPECT_TRUE(multiplyFilter->GetOutput()->GetDeviceBuffer() == nullptr);
+
+  VkRealImageType * const scaledRoundTrip{ scaledInverseFilter->GetOutput() };
+  for (itk::ImageRegionConstIteratorWithIndex<VkRealImageType> it(scaledRoundTrip,
+                                                                  scaledRoundTrip->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const RealType expected{ 2.0f * realImage->GetPixel(it.GetIndex()) };
+    if (std::abs(it.Get() - expected) > valueTolerance)
+    {
+      std::cout << "Scaled round trip mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected
+                << std::endl;
+      testPassed = false;
+    }
+  }
+
+  // Writing through an iterator of the superclass outside a pipeline, which bypasses the
+  // host accessors of the VkImage, and then marking the image modified leaves the device
+  // copy stale, so that the inverse transform reads the scaled spectrum
+  auto writtenForwardFilter = itk::VkForwardFFTImageFilter<VkRealImageType, VkComplexImageType>::New();
+  writtenForwardFilter->SetInput(realImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writtenForwardFilter->Update());
+  VkComplexImageType::Pointer writtenSpectrum{ writtenForwardFilter->GetOutput() };
+  writtenSpectrum->DisconnectPipeline();
+  ITK_TEST_EXPECT_TRUE(writtenSpectrum->GetDeviceBuffer() != nullptr);
+  writtenSpectrum->UpdateHostBuffer();
+  ComplexImageType * const hostSpectrum{ writtenSpectrum.GetPointer() };
+  for (itk::ImageRegionIterator<ComplexImageType> it(hostSpectrum, hostSpectrum->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    it.Set(3.0f * it.Get());
+  }
+  writtenSpectrum->Modified();
+  ITK_TEST_EXPECT_TRUE(writtenSpectrum->GetDeviceBuffer() == nullptr);
+
+  auto writtenInverseFilter = itk::VkInverseFFTImageFilter<VkComplexImageType, VkRealImageType>::New();
+  writtenInverseFilter->SetInput(writtenSpectrum);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writtenInverseFilter->Update());
+
+  VkRealImageType * const writtenRoundTrip{ writtenInverseFilter->GetOutput() };
+  for (itk::ImageRegionConstIteratorWithIndex<VkRealImageType> it(writtenRoundTrip,
+                                                                  writtenRoundTrip->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const RealType expected{ 3.0f * realImage->GetPixel(it.GetIndex()) };
+    if (std::abs(it.Get() - expected) > valueTolerance)
+    {
+      std::cout << "Written round trip mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected
+                << std::endl;
+      testPassed = false;
+    }
+  }
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkDeviceContext.h"
+#include "itkVkFFTConvolutionImageFilter.h"
+#include "itkVkGlobalConfiguration.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Verify that convolutions reusing a cached kernel spectrum compute the same
+// values as convolutions that transform the kernel, that the cache tells
+// apart padded sizes, and that a modified kernel is transformed again.
+
+int
+itkVkKernelSpectrumCacheTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using FilterType = itk::VkFFTConvolutionImageFilter<ImageType>;
+
+  constexpr float valueTolerance{ 1e-4f };
+
+  bool       testPassed{ true };
+  const auto compareImages = [&testPassed](const char * name, ImageType * image, ImageType * expected) {
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      if (std::abs(it.Get() - expected->GetPixel(it.GetIndex())) > valueTolerance)
+      {
+        std::cout << name << " mismatch at " << it.GetIndex() << ": " << it.Get()
+                  << " != " << expected->GetPixel(it.GetIndex()) << std::endl;
+        testPassed = false;
+      }
+    }
+  };
+  const auto makeImage = [](typename ImageType::SizeType size, int seed) {
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      const auto & index = it.GetIndex();
+      it.Set(static_cast<PixelType>((5 * index[0] + 3 * index[1] + seed) % 13) - 6.0f);
+    }
+    return image;
+  };
+  const auto convolve = [](ImageType * image, ImageType * kernel) {
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetKernelImage(kernel);
+    filter->Update();
+    ImageType::Pointer output{ filter->GetOutput() };
+    output->DisconnectPipeline();
+    return output;
+  };
+
+  const std::vector<ImageType::Pointer> images{ makeImage({ { 20, 15 } }, 0),
+                                                makeImage({ { 20, 15 } }, 4),
+                                                makeImage({ { 31, 9 } }, 7) };
+  auto                                  kernel = makeImage({ { 5, 3 } }, 2);
+
+  // Reference results, transforming the kernel for every convolution
+  itk::VkGlobalConfiguration::SetKernelSpectrumCacheBudget(0);
+  std::vector<ImageType::Pointer> references;
+  for (const auto & image : images)
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(references.push_back(convolve(image, kernel)));
+  }
+
+  // Keep kernel spectra on the device
+  itk::VkGlobalConfiguration::SetKernelSpectrumCacheBudget(1 << 20);
+  ITK_TEST_SET_GET_VALUE(itk::VkGlobalConfiguration::GetKernelSpectrumCacheBudget(), 1 << 20);
+
+  itk::VkDeviceContext::Pointer context;
+  if (itk::VkDeviceContext::GetInstance(itk::VkGlobalConfiguration::GetDeviceID(), context) != VKFFT_SUCCESS)
+  {
+    std::cout << "Test failed: no device context." << std::endl;
+    return EXIT_FAILURE;
+  }
+  context->ClearKernelSpectra();
+  context->ResetKernelSpectrumStatistics();
+  ITK_TEST_EXPECT_EQUAL(context->GetKernelSpectrumStatistics().entries, 0);
+  ITK_TEST_EXPECT_EQUAL(context->GetKernelSpectrumStatistics().bytes, 0);
+
+  // The first convolution transforms the kernel and caches its spectrum ...
+  ImageType::Pointer output;
+  ITK_TRY_EXPECT_NO_EXCEPTION(output = convolve(images[0], kernel));
+  compareImages("First", output, references[0]);
+  auto statistics = context->GetKernelSpectrumStatistics();
+  ITK_TEST_EXPECT_EQUAL(statistics.hits, 0);
+  ITK_TEST_EXPECT_EQUAL(statistics.misses, 1);
+  ITK_TEST_EXPECT_EQUAL(statistics.entries, 1);
+  ITK_TEST_EXPECT_TRUE(statistics.bytes > 0);
+
+  // ... a convolution of another image of the same size reuses it ...
+  ITK_TRY_EXPECT_NO_EXCEPTION(output = convolve(images[1], kernel));
+  compareImages("Same size", output, references[1]);
+  statistics = context->GetKernelSpectrumStatistics();
+  ITK_TEST_EXPECT_EQUAL(statistics.hits, 1);
+  ITK_TEST_EXPECT_EQUAL(statistics.misses, 1);
+
+  // ... and one of another size needs a spectrum of its own
+  ITK_TRY_EXPECT_NO_EXCEPTION(output = convolve(images[2], kernel));
+  compareImages("Other size", output, references[2]);
+  statistics = context->GetKernelSpectrumStatistics();
+  ITK_TEST_EXPECT_EQUAL(statistics.hits, 1);
+  ITK_TEST_EXPECT_EQUAL(statistics.misses, 2);
+  ITK_TEST_EXPECT_EQUAL(statistics.entries, 2);
+  ITK_TEST_EXPECT_EQUAL(statistics.evictions, 0);
+
+  // A modified kernel replaces its stale spectra
+  typename ImageType::IndexType index{ { 1, 2 } };
+  kernel->SetPixel(index, kernel->GetPixel(index) + 3.0f);
+  kernel->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(output = convolve(images[0], kernel));
+  statistics = context->GetKernelSpectrumStatistics();
+  ITK_TEST_EXPECT_EQUAL(statistics.hits, 1);
+  ITK_TEST_EXPECT_EQUAL(statistics.misses, 3);
+  ITK_TEST_EXPECT_EQUAL(statistics.entries, 1);
+  ITK_TEST_EXPECT_EQUAL(statistics.evictions, 2);
+
+  itk::VkGlobalConfiguration::SetKernelSpectrumCacheBudget(0);
+  ImageType::Pointer reference;
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference = convolve(images[0], kernel));
+  compareImages("Modified kernel", output, reference);
+
+  context->ClearKernelSpectra();
+  ITK_TEST_EXPECT_EQUAL(context->GetKernelSpectrumStatistics().entries, 0);
+  ITK_TEST_EXPECT_EQUAL(context->GetKernelSpectrumStatistics().bytes, 0);
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
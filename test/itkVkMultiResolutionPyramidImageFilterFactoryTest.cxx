@@ -20,13 +20,17 @@
 #include <string>
 
 #include "itkMultiResolutionPyramidImageFilter.h"
+#include "itkRecursiveMultiResolutionPyramidImageFilter.h"
 #include "itkVkMultiResolutionPyramidImageFilter.h"
+#include "itkVkRecursiveMultiResolutionPyramidImageFilter.h"
 
 #include "itkVkMultiResolutionPyramidImageFilterFactory.h"
 #include "itkTestingMacros.h"
 
 // Verify MultiResolutionPyramidImageFilter can be overriden
-// with spatial+FFT implementation through object factory override
+// with spatial+FFT implementation through object factory override,
+// and RecursiveMultiResolutionPyramidImageFilter with its recursive counterpart,
+// also for integer input images
 
 int
 itkVkMultiResolutionPyramidImageFilterFactoryTest(int, char *[])
@@ -36,12 +40,16 @@ itkVkMultiResolutionPyramidImageFilterFactoryTest(int, char *[])
   using ImageType = itk::Image<PixelType, Dimension>;
   using BaseFilterType = itk::MultiResolutionPyramidImageFilter<ImageType, ImageType>;
   using VkSubclassType = itk::VkMultiResolutionPyramidImageFilter<ImageType, ImageType>;
+  using BaseRecursiveFilterType = itk::RecursiveMultiResolutionPyramidImageFilter<ImageType, ImageType>;
+  using VkRecursiveSubclassType = itk::VkRecursiveMultiResolutionPyramidImageFilter<ImageType, ImageType>;
 
   // Verify default is non-accelerated implementation
   typename BaseFilterType::Pointer baseFilter = BaseFilterType::New();
   VkSubclassType *                 derivedFilter = dynamic_cast<VkSubclassType *>(baseFilter.GetPointer());
   ITK_TEST_EXPECT_TRUE(derivedFilter == nullptr);
   ITK_EXERCISE_BASIC_OBJECT_METHODS(baseFilter, MultiResolutionPyramidImageFilter, ImageToImageFilter);
+  typename BaseRecursiveFilterType::Pointer baseRecursiveFilter = BaseRecursiveFilterType::New();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<VkRecursiveSubclassType *>(baseRecursiveFilter.GetPointer()) == nullptr);
 
   // Register factory and verify override
   itk::VkMultiResolutionPyramidImageFilterFactory::RegisterOneFactory();
@@ -52,5 +60,24 @@ itkVkMultiResolutionPyramidImageFilterFactoryTest(int, char *[])
   ITK_EXERCISE_BASIC_OBJECT_METHODS(
     derivedFilter, VkMultiResolutionPyramidImageFilter, MultiResolutionPyramidImageFilter);
 
+  baseRecursiveFilter = BaseRecursiveFilterType::New();
+  auto * derivedRecursiveFilter = dynamic_cast<VkRecursiveSubclassType *>(baseRecursiveFilter.GetPointer());
+  ITK_TEST_EXPECT_TRUE(derivedRecursiveFilter != nullptr);
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    derivedRecursiveFilter, VkRecursiveMultiResolutionPyramidImageFilter, RecursiveMultiResolutionPyramidImageFilter);
+
+  // Integer images into float pyramids are overridden as well
+  using IntegerImageType = itk::Image<unsigned short, Dimension>;
+  using FloatImageType = itk::Image<float, Dimension>;
+  auto integerFilter = itk::MultiResolutionPyramidImageFilter<IntegerImageType, FloatImageType>::New();
+  ITK_TEST_EXPECT_TRUE(
+    (dynamic_cast<itk::VkMultiResolutionPyramidImageFilter<IntegerImageType, FloatImageType> *>(
+       integerFilter.GetPointer()) != nullptr));
+  auto integerRecursiveFilter =
+    itk::RecursiveMultiResolutionPyramidImageFilter<IntegerImageType, FloatImageType>::New();
+  ITK_TEST_EXPECT_TRUE(
+    (dynamic_cast<itk::VkRecursiveMultiResolutionPyramidImageFilter<IntegerImageType, FloatImageType> *>(
+       integerRecursiveFilter.GetPointer()) != nullptr));
+
   return EXIT_SUCCESS;
 }
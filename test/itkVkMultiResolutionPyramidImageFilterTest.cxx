@@ -22,8 +22,11 @@
 #include "itkVkMultiResolutionPyramidImageFilter.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkMath.h"
+#include "itkMultiThreaderBase.h"
 #include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
 
 namespace
 {
@@ -40,6 +43,7 @@ public:
   }
   itk::ProcessObject::Pointer m_Process;
 };
+
 } // namespace
 
 int
@@ -169,5 +173,144 @@ itkVkMultiResolutionPyramidImageFilterTest(int argc, char * argv[])
     itk::WriteImage(pyramidFilter->GetOutput(ilevel), argv[2] + std::to_string(ilevel) + ".mha");
   }
 
-  return EXIT_SUCCESS;
+  // Levels smoothed from a shared spectrum of the input match the levels smoothed separately
+  auto sharedPyramidFilter = PyramidType::New();
+  sharedPyramidFilter->SetInput(inputImage);
+  sharedPyramidFilter->SetUseShrinkImageFilter(useShrinkFilter);
+  sharedPyramidFilter->SetMetricThreshold(pyramidFilter->GetMetricThreshold());
+  sharedPyramidFilter->SetNumberOfLevels(numLevels);
+  ITK_TEST_SET_GET_BOOLEAN(sharedPyramidFilter, ShareInputSpectrum, true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(sharedPyramidFilter->Update());
+
+  int result = EXIT_SUCCESS;
+  if (itk::VkTesting::CompareLevels(
+        sharedPyramidFilter.GetPointer(), pyramidFilter.GetPointer(), "Shared spectrum", 1e-3, 1e-3) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // Levels shrunk in the frequency domain match the levels shrunk by ShrinkImageFilter
+  auto shrinkPyramidFilter = PyramidType::New();
+  auto decimatedPyramidFilter = PyramidType::New();
+  for (PyramidType * filter : { shrinkPyramidFilter.GetPointer(), decimatedPyramidFilter.GetPointer() })
+  {
+    filter->SetInput(inputImage);
+    filter->SetUseShrinkImageFilter(true);
+    filter->SetMetricThreshold(pyramidFilter->GetMetricThreshold());
+    filter->SetNumberOfLevels(numLevels);
+  }
+  ITK_TEST_SET_GET_BOOLEAN(decimatedPyramidFilter, SpectralDecimation, true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(shrinkPyramidFilter->Update());
+  for (const bool shareInputSpectrum : { false, true })
+  {
+    decimatedPyramidFilter->SetShareInputSpectrum(shareInputSpectrum);
+    ITK_TRY_EXPECT_NO_EXCEPTION(decimatedPyramidFilter->Update());
+    if (itk::VkTesting::CompareLevels(decimatedPyramidFilter.GetPointer(),
+                                      shrinkPyramidFilter.GetPointer(),
+                                      shareInputSpectrum ? "Decimated shared spectrum" : "Decimated",
+                                      1e-3,
+                                      1e-3) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // Levels generated concurrently on the CPU and on the device match the levels generated in turn
+  auto concurrentPyramidFilter = PyramidType::New();
+  concurrentPyramidFilter->SetInput(inputImage);
+  concurrentPyramidFilter->SetUseShrinkImageFilter(useShrinkFilter);
+  concurrentPyramidFilter->SetMetricThreshold(pyramidFilter->GetMetricThreshold());
+  concurrentPyramidFilter->SetNumberOfLevels(numLevels);
+  ITK_TEST_SET_GET_BOOLEAN(concurrentPyramidFilter, ConcurrentLevels, true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(concurrentPyramidFilter->Update());
+  if (itk::VkTesting::CompareLevels(
+        concurrentPyramidFilter.GetPointer(), pyramidFilter.GetPointer(), "Concurrent", 1e-3, 1e-3) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // Levels generated on demand match the levels generated together, and the others hold no memory
+  auto onDemandPyramidFilter = PyramidType::New();
+  onDemandPyramidFilter->SetInput(inputImage);
+  onDemandPyramidFilter->SetUseShrinkImageFilter(useShrinkFilter);
+  onDemandPyramidFilter->SetMetricThreshold(pyramidFilter->GetMetricThreshold());
+  onDemandPyramidFilter->SetNumberOfLevels(numLevels);
+  ITK_TEST_SET_GET_BOOLEAN(onDemandPyramidFilter, GenerateLevelsOnDemand, true);
+  for (const unsigned int demandedLevel : { numLevels - 1, 0u })
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(onDemandPyramidFilter->GetOutput(demandedLevel)->Update());
+    for (unsigned int ilevel = 0; ilevel < numLevels; ++ilevel)
+    {
+      const ImageType * level = onDemandPyramidFilter->GetOutput(ilevel);
+      if (ilevel != demandedLevel)
+      {
+        ITK_TEST_EXPECT_EQUAL(level->GetBufferedRegion().GetNumberOfPixels(), 0);
+        continue;
+      }
+      const ImageType * expected = pyramidFilter->GetOutput(ilevel);
+      ITK_TEST_EXPECT_EQUAL(level->GetBufferedRegion(), expected->GetBufferedRegion());
+      for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(level, level->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+      {
+        if (std::abs(it.Get() - expected->GetPixel(it.GetIndex())) > 1e-3f * (1.0f + std::abs(it.Get())))
+        {
+          std::cout << "On demand level " << ilevel << " mismatch at " << it.GetIndex() << std::endl;
+          result = EXIT_FAILURE;
+          break;
+        }
+      }
+    }
+  }
+
+  // An update of the filter as a whole generates all levels, also after levels were generated on their own
+  ITK_TRY_EXPECT_NO_EXCEPTION(onDemandPyramidFilter->UpdateLargestPossibleRegion());
+  if (itk::VkTesting::CompareLevels(
+        onDemandPyramidFilter.GetPointer(), pyramidFilter.GetPointer(), "On demand", 1e-3, 1e-3) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+  onDemandPyramidFilter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(onDemandPyramidFilter->GetOutput(numLevels - 1)->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(onDemandPyramidFilter->Update());
+  if (itk::VkTesting::CompareLevels(
+        onDemandPyramidFilter.GetPointer(), pyramidFilter.GetPointer(), "On demand", 1e-3, 1e-3) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  // Calibrate the smoothing cost model of the device, which GetUseFFT then consults
+  // and which can be written and read back
+  ITK_TEST_SET_GET_BOOLEAN(pyramidFilter, UseSmoothingCostModel, true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(pyramidFilter->CalibrateSmoothing());
+  itk::VkGlobalConfiguration::SmoothingCostModel model;
+  ITK_TEST_EXPECT_TRUE(
+    itk::VkGlobalConfiguration::GetSmoothingCostModel(itk::VkGlobalConfiguration::GetDeviceID(), model));
+  ITK_TEST_EXPECT_EQUAL(model.numberOfWorkUnits, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  const std::string modelFileName = std::string(argv[2]) + "SmoothingCostModels.txt";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::VkGlobalConfiguration::WriteSmoothingCostModels(modelFileName));
+  itk::VkGlobalConfiguration::RemoveSmoothingCostModels();
+  itk::VkGlobalConfiguration::SmoothingCostModel readModel;
+  ITK_TEST_EXPECT_TRUE(
+    !itk::VkGlobalConfiguration::GetSmoothingCostModel(itk::VkGlobalConfiguration::GetDeviceID(), readModel));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::VkGlobalConfiguration::ReadSmoothingCostModels(modelFileName));
+  ITK_TEST_EXPECT_TRUE(
+    itk::VkGlobalConfiguration::GetSmoothingCostModel(itk::VkGlobalConfiguration::GetDeviceID(), readModel));
+  for (unsigned int term = 0; term < 3; ++term)
+  {
+    ITK_TEST_EXPECT_EQUAL(readModel.spatialCoefficients[term], model.spatialCoefficients[term]);
+    ITK_TEST_EXPECT_EQUAL(readModel.fftCoefficients[term], model.fftCoefficients[term]);
+  }
+  for (unsigned int level = 0; level < numLevels; ++level)
+  {
+    radius = pyramidFilter->GetKernelRadius(level);
+    const bool useFFT = pyramidFilter->GetUseFFT(radius);
+    std::cout << "Calibrated FFT will " << (useFFT ? "" : "not ") << "be used for level " << level << std::endl;
+    pyramidFilter->UseSmoothingCostModelOff();
+    ITK_TEST_EXPECT_EQUAL(pyramidFilter->GetUseFFT(radius),
+                          pyramidFilter->ComputeMetricValue(inputImage->GetLargestPossibleRegion().GetSize(), radius) >
+                            pyramidFilter->GetMetricThreshold());
+    pyramidFilter->UseSmoothingCostModelOn();
+  }
+  itk::VkGlobalConfiguration::RemoveSmoothingCostModels();
+
+  return result;
 }
@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkRealToHalfHermitianForwardFFTImageFilter.h"
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
+
+// Verify that padding on the device matches transforming an image
+// that was padded on the CPU with the same boundary condition.
+
+namespace
+{
+template <typename TImage, typename TFilter>
+int
+ComparePadding(const TImage *                              image,
+               const typename TImage::SizeType &           lowerBound,
+               const typename TImage::SizeType &           upperBound,
+               typename TFilter::BoundaryConditionEnum     condition,
+               const itk::ImageBoundaryCondition<TImage> & cpuCondition)
+{
+  constexpr float valueTolerance{ 1e-2f };
+
+  // Pad on the CPU
+  typename TImage::RegionType paddedRegion{ image->GetLargestPossibleRegion() };
+  for (unsigned int dim{ 0 }; dim < TImage::ImageDimension; ++dim)
+  {
+    paddedRegion.SetIndex(dim, paddedRegion.GetIndex(dim) - static_cast<itk::IndexValueType>(lowerBound[dim]));
+    paddedRegion.SetSize(dim, paddedRegion.GetSize(dim) + lowerBound[dim] + upperBound[dim]);
+  }
+  auto paddedImage = TImage::New();
+  paddedImage->SetRegions(paddedRegion);
+  paddedImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(paddedImage, paddedRegion); !it.IsAtEnd(); ++it)
+  {
+    it.Set(cpuCondition.GetPixel(it.GetIndex(), image));
+  }
+
+  auto referenceFilter = TFilter::New();
+  referenceFilter->SetInput(paddedImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+  // Pad on the device
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetPadLowerBound(lowerBound);
+  ITK_TEST_SET_GET_VALUE(filter->GetPadLowerBound(), lowerBound);
+  filter->SetPadUpperBound(upperBound);
+  ITK_TEST_SET_GET_VALUE(filter->GetPadUpperBound(), upperBound);
+  filter->SetBoundaryCondition(condition);
+  ITK_TEST_SET_GET_VALUE(filter->GetBoundaryCondition(), condition);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  const auto * reference = referenceFilter->GetOutput();
+  const auto * output = filter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(output->GetLargestPossibleRegion(), reference->GetLargestPossibleRegion());
+
+  std::ostringstream description;
+  description << condition;
+  return itk::VkTesting::CompareImages(
+    output, reference, output->GetLargestPossibleRegion(), description.str(), valueTolerance);
+}
+} // namespace
+
+int
+itkVkPaddedForwardFFTImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using RealType = float;
+  using RealImageType = itk::Image<RealType, Dimension>;
+  using ComplexImageType = itk::Image<std::complex<RealType>, Dimension>;
+  using FilterType = itk::VkRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>;
+  using BoundaryConditionEnum = FilterType::BoundaryConditionEnum;
+
+  // Pad a 15x10 image with a non-zero origin index into a 22x13 transform
+  const typename RealImageType::IndexType  imageIndex{ { 2, -1 } };
+  const typename RealImageType::SizeType   imageSize{ { 15, 10 } };
+  const typename RealImageType::RegionType imageRegion{ imageIndex, imageSize };
+  const typename RealImageType::SizeType   lowerBound{ { 3, 2 } };
+  const typename RealImageType::SizeType   upperBound{ { 4, 1 } };
+
+  auto realImage = RealImageType::New();
+  realImage->SetRegions(imageRegion);
+  realImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<RealImageType> it(realImage, imageRegion); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<RealType>((3 * index[0] + 7 * index[1] + 20) % 11) - 5.0f);
+  }
+
+  auto filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    filter, VkRealToHalfHermitianForwardFFTImageFilter, RealToHalfHermitianForwardFFTImageFilter);
+  ITK_TEST_SET_GET_VALUE(filter->GetBoundaryCondition(), BoundaryConditionEnum::ZERO_FLUX_NEUMANN);
+
+  const auto padsAlike = [&](BoundaryConditionEnum condition, const itk::ImageBoundaryCondition<RealImageType> & cpu) {
+    return ComparePadding<RealImageType, FilterType>(realImage, lowerBound, upperBound, condition, cpu) == EXIT_SUCCESS;
+  };
+  const itk::ConstantBoundaryCondition<RealImageType>        zeroCondition;
+  const itk::PeriodicBoundaryCondition<RealImageType>        periodicCondition;
+  const itk::ZeroFluxNeumannBoundaryCondition<RealImageType> neumannCondition;
+
+  bool testPassed{ true };
+  testPassed &= padsAlike(BoundaryConditionEnum::ZERO, zeroCondition);
+  testPassed &= padsAlike(BoundaryConditionEnum::PERIODIC, periodicCondition);
+  testPassed &= padsAlike(BoundaryConditionEnum::ZERO_FLUX_NEUMANN, neumannCondition);
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
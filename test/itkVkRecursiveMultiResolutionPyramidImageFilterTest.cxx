@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRecursiveMultiResolutionPyramidImageFilter.h"
+#include "itkVkRecursiveMultiResolutionPyramidImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+
+// Verify that VkRecursiveMultiResolutionPyramidImageFilter generates the same
+// levels as RecursiveMultiResolutionPyramidImageFilter, with the levels shrunk
+// in the frequency domain and kept on the device, shrunk by ShrinkImageFilter
+// and resampled, and with a schedule whose factor repeats between levels.
+
+int
+itkVkRecursiveMultiResolutionPyramidImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ReferencePyramidType = itk::RecursiveMultiResolutionPyramidImageFilter<ImageType, ImageType>;
+  using PyramidType = itk::VkRecursiveMultiResolutionPyramidImageFilter<ImageType, ImageType>;
+  using ScheduleType = typename PyramidType::ScheduleType;
+
+  typename ImageType::SizeType size{ { 67, 45 } };
+  auto                         image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & pixelIndex = it.GetIndex();
+    it.Set(static_cast<PixelType>((7 * pixelIndex[0] + 3 * pixelIndex[1] * pixelIndex[1]) % 29) - 14.0f);
+  }
+
+  auto pyramid = PyramidType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    pyramid, VkRecursiveMultiResolutionPyramidImageFilter, RecursiveMultiResolutionPyramidImageFilter);
+  ITK_TEST_SET_GET_BOOLEAN(pyramid, SpectralDecimation, true);
+
+  // The default schedule, and one whose factors repeat or differ between dimensions
+  constexpr unsigned int repeatedLevels{ 5 };
+  const unsigned int     repeatedFactors[repeatedLevels][Dimension] = {
+    { 8, 4 }, { 4, 2 }, { 4, 2 }, { 2, 1 }, { 1, 1 }
+  };
+  ScheduleType repeatedSchedule(repeatedLevels, Dimension);
+  for (unsigned int ilevel = 0; ilevel < repeatedLevels; ++ilevel)
+  {
+    for (unsigned int dim = 0; dim < Dimension; ++dim)
+    {
+      repeatedSchedule[ilevel][dim] = repeatedFactors[ilevel][dim];
+    }
+  }
+
+  int result = EXIT_SUCCESS;
+  for (const bool useRepeatedSchedule : { false, true })
+  {
+    for (const bool useShrinkImageFilter : { true, false })
+    {
+      for (const bool spectralDecimation : { true, false })
+      {
+        if (!useShrinkImageFilter && !spectralDecimation)
+        {
+          continue;
+        }
+        auto referencePyramid = ReferencePyramidType::New();
+        pyramid = PyramidType::New();
+        for (ReferencePyramidType * filter :
+             { referencePyramid.GetPointer(), static_cast<ReferencePyramidType *>(pyramid.GetPointer()) })
+        {
+          filter->SetInput(image);
+          filter->SetUseShrinkImageFilter(useShrinkImageFilter);
+          filter->SetMaximumError(1e-5);
+          if (useRepeatedSchedule)
+          {
+            filter->SetNumberOfLevels(repeatedLevels);
+            filter->SetSchedule(repeatedSchedule);
+          }
+          else
+          {
+            filter->SetNumberOfLevels(3);
+          }
+        }
+        pyramid->SetSpectralDecimation(spectralDecimation);
+        ITK_TRY_EXPECT_NO_EXCEPTION(referencePyramid->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(pyramid->Update());
+
+        std::ostringstream description;
+        description << (useRepeatedSchedule ? "Repeated schedule" : "Default schedule") << ", "
+                    << (useShrinkImageFilter ? "shrink" : "resample") << ", spectral decimation "
+                    << spectralDecimation;
+        if (itk::VkTesting::CompareLevels(
+              pyramid.GetPointer(), referencePyramid.GetPointer(), description.str(), 1e-3, 1e-3) != EXIT_SUCCESS)
+        {
+          result = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  if (result != EXIT_SUCCESS)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
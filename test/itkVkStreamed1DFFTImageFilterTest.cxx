@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkComplexToComplex1DFFTImageFilter.h"
+#include "itkVkForward1DFFTImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVkTestingHelpers.h"
+
+// Verify that streaming slabs through the 1D filters matches
+// transforming the whole image at once.
+
+int
+itkVkStreamed1DFFTImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 3 };
+  using RealType = float;
+  using RealImageType = itk::Image<RealType, Dimension>;
+  using ComplexImageType = itk::Image<std::complex<RealType>, Dimension>;
+  using ForwardFilterType = itk::VkForward1DFFTImageFilter<RealImageType, ComplexImageType>;
+  using ComplexFilterType = itk::VkComplexToComplex1DFFTImageFilter<ComplexImageType, ComplexImageType>;
+  using StreamerType = itk::StreamingImageFilter<ComplexImageType, ComplexImageType>;
+
+  constexpr unsigned int numberOfStreamDivisions{ 4 };
+
+  // The streaming filter splits the slowest dimension, which is not transformed
+  const typename RealImageType::SizeType size{ { 10, 6, 8 } };
+
+  auto realImage = RealImageType::New();
+  realImage->SetRegions(size);
+  realImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<RealImageType> it(realImage, realImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<RealType>((3 * index[0] + 7 * index[1] + 5 * index[2]) % 11) - 5.0f);
+  }
+
+  // Real-to-complex transform along Y
+  auto referenceForwardFilter = ForwardFilterType::New();
+  referenceForwardFilter->SetInput(realImage);
+  referenceForwardFilter->SetDirection(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceForwardFilter->Update());
+
+  auto forwardFilter = ForwardFilterType::New();
+  forwardFilter->SetInput(realImage);
+  forwardFilter->SetDirection(1);
+  auto forwardStreamer = StreamerType::New();
+  forwardStreamer->SetInput(forwardFilter->GetOutput());
+  forwardStreamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  ITK_TRY_EXPECT_NO_EXCEPTION(forwardStreamer->Update());
+
+  bool testPassed{ true };
+  if (itk::VkTesting::CompareImages<ComplexImageType>(
+        forwardStreamer->GetOutput(), referenceForwardFilter->GetOutput(), "Forward", 1e-3) != EXIT_SUCCESS)
+  {
+    testPassed = false;
+  }
+
+  // Complex-to-complex transform along X, from a fully buffered input
+  auto referenceComplexFilter = ComplexFilterType::New();
+  referenceComplexFilter->SetInput(referenceForwardFilter->GetOutput());
+  referenceComplexFilter->SetDirection(0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceComplexFilter->Update());
+
+  auto complexFilter = ComplexFilterType::New();
+  complexFilter->SetInput(referenceForwardFilter->GetOutput());
+  complexFilter->SetDirection(0);
+  auto complexStreamer = StreamerType::New();
+  complexStreamer->SetInput(complexFilter->GetOutput());
+  complexStreamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  ITK_TRY_EXPECT_NO_EXCEPTION(complexStreamer->Update());
+
+  if (itk::VkTesting::CompareImages<ComplexImageType>(
+        complexStreamer->GetOutput(), referenceComplexFilter->GetOutput(), "ComplexToComplex", 1e-3) != EXIT_SUCCESS)
+  {
+    testPassed = false;
+  }
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
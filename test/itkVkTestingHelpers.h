@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVkTestingHelpers_h
+#define itkVkTestingHelpers_h
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace itk
+{
+namespace VkTesting
+{
+
+/** Compare the pixels of an image over a region with those of a reference image. A pixel
+ *  matches if it differs from the reference pixel by at most `tolerance` plus
+ *  `relativeTolerance` times the magnitude of the reference pixel. Returns EXIT_SUCCESS
+ *  if all pixels match, and otherwise prints the first mismatch and their number. */
+template <typename TImage>
+int
+CompareImages(const TImage *                      image,
+              const TImage *                      reference,
+              const typename TImage::RegionType & region,
+              const std::string &                 description,
+              double                              tolerance,
+              double                              relativeTolerance = 0.0)
+{
+  SizeValueType numberOfMismatches{ 0 };
+  for (ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const auto   expected = reference->GetPixel(it.GetIndex());
+    const double difference{ static_cast<double>(std::abs(it.Get() - expected)) };
+    if (difference > tolerance + relativeTolerance * static_cast<double>(std::abs(expected)))
+    {
+      if (numberOfMismatches == 0)
+      {
+        std::cout << description << ": mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected
+                  << std::endl;
+      }
+      ++numberOfMismatches;
+    }
+  }
+  if (numberOfMismatches > 0)
+  {
+    std::cout << description << ": " << numberOfMismatches << " mismatching pixels" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** Compare the geometry of an image with that of a reference image, and their pixels over
+ *  the largest possible region. */
+template <typename TImage>
+int
+CompareImages(const TImage *      image,
+              const TImage *      reference,
+              const std::string & description,
+              double              tolerance,
+              double              relativeTolerance = 0.0)
+{
+  if (image->GetLargestPossibleRegion() != reference->GetLargestPossibleRegion() ||
+      image->GetOrigin() != reference->GetOrigin() || image->GetSpacing() != reference->GetSpacing())
+  {
+    std::cout << description << ": geometry mismatch " << image->GetLargestPossibleRegion() << " != "
+              << reference->GetLargestPossibleRegion() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return CompareImages(
+    image, reference, image->GetLargestPossibleRegion(), description, tolerance, relativeTolerance);
+}
+
+/** Compare the levels of a multi-resolution pyramid with those of a reference pyramid. */
+template <typename TPyramid, typename TReferencePyramid>
+int
+CompareLevels(TPyramid *          pyramid,
+              TReferencePyramid * referencePyramid,
+              const std::string & description,
+              double              tolerance,
+              double              relativeTolerance = 0.0)
+{
+  int result{ EXIT_SUCCESS };
+  for (unsigned int level{ 0 }; level < pyramid->GetNumberOfLevels(); ++level)
+  {
+    std::ostringstream levelDescription;
+    levelDescription << description << " level " << level;
+    if (CompareImages(pyramid->GetOutput(level),
+                      referencePyramid->GetOutput(level),
+                      levelDescription.str(),
+                      tolerance,
+                      relativeTolerance) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  return result;
+}
+
+} // end namespace VkTesting
+} // end namespace itk
+
+#endif // itkVkTestingHelpers_h
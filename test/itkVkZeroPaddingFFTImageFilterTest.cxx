@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVkHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkVkRealToHalfHermitianForwardFFTImageFilter.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Verify that declaring zero input blocks and unneeded output blocks
+// does not change the values that VkFFT computes.
+
+int
+itkVkZeroPaddingFFTImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 1)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension{ 2 };
+  using RealType = float;
+  using RealImageType = itk::Image<RealType, Dimension>;
+  using ComplexImageType = itk::Image<std::complex<RealType>, Dimension>;
+  using ForwardFilterType = itk::VkRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>;
+  using InverseFilterType = itk::VkHalfHermitianToRealInverseFFTImageFilter<ComplexImageType, RealImageType>;
+
+  constexpr float valueTolerance{ 1e-3f };
+
+  // Zero pad a 20x12 pattern into a 40x24 image, as for a 2x padded convolution
+  typename RealImageType::SizeType paddedSize{ { 40, 24 } };
+  typename RealImageType::SizeType dataSize{ { 20, 12 } };
+  const typename RealImageType::RegionType dataRegion{ dataSize };
+
+  auto realImage = RealImageType::New();
+  realImage->SetRegions(paddedSize);
+  realImage->Allocate();
+  realImage->FillBuffer(0.0f);
+  for (itk::ImageRegionIteratorWithIndex<RealImageType> it(realImage, dataRegion); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<RealType>((3 * index[0] + 7 * index[1]) % 11) - 5.0f);
+  }
+
+  auto referenceForwardFilter = ForwardFilterType::New();
+  referenceForwardFilter->SetInput(realImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceForwardFilter->Update());
+
+  auto forwardFilter = ForwardFilterType::New();
+  forwardFilter->SetInput(realImage);
+  forwardFilter->SetNonZeroInputRegion(dataRegion);
+  ITK_TEST_SET_GET_VALUE(forwardFilter->GetNonZeroInputRegion(), dataRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(forwardFilter->Update());
+
+  bool testPassed{ true };
+  for (itk::ImageRegionConstIteratorWithIndex<ComplexImageType> it(
+         forwardFilter->GetOutput(), forwardFilter->GetOutput()->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto expected = referenceForwardFilter->GetOutput()->GetPixel(it.GetIndex());
+    if (std::abs(it.Get() - expected) > valueTolerance)
+    {
+      std::cout << "Forward mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected << std::endl;
+      testPassed = false;
+    }
+  }
+
+  // Inverse transform and only keep the original data block
+  auto inverseFilter = InverseFilterType::New();
+  inverseFilter->SetInput(forwardFilter->GetOutput());
+  inverseFilter->SetActualXDimensionIsOdd(paddedSize[0] % 2 == 1);
+  inverseFilter->SetKeptOutputRegion(dataRegion);
+  ITK_TEST_SET_GET_VALUE(inverseFilter->GetKeptOutputRegion(), dataRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(inverseFilter->Update());
+
+  for (itk::ImageRegionConstIteratorWithIndex<RealImageType> it(inverseFilter->GetOutput(), dataRegion); !it.IsAtEnd();
+       ++it)
+  {
+    const RealType expected{ realImage->GetPixel(it.GetIndex()) };
+    if (std::abs(it.Get() - expected) > valueTolerance)
+    {
+      std::cout << "Inverse mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << expected << std::endl;
+      testPassed = false;
+    }
+  }
+
+  if (!testPassed)
+  {
+    std::cout << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}